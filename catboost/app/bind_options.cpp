@@ -296,6 +296,12 @@ static void BindOutputParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             (*plainJsonPtr)["profile_log"] = name;
         });
 
+    parser.AddLongOption("chrome-trace-log", "file to write Chrome trace of training stages to (see chrome://tracing)")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["chrome_trace_log"] = name;
+        });
+
     parser.AddLongOption("trace-log", "path for trace log")
         .RequiredArgument("file")
         .Handler1T<TString>([](const TString& name) {
@@ -342,6 +348,18 @@ static void BindOutputParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
         (*plainJsonPtr)["metric_period"] = period;
     });
 
+    parser.AddLongOption("metric-sample-rate", "fraction of objects to calculate non-tracker metrics on between full metric evaluations")
+        .RequiredArgument("float")
+        .Handler1T<float>([plainJsonPtr](const auto rate) {
+        (*plainJsonPtr)["metric_sample_rate"] = rate;
+    });
+
+    parser.AddLongOption("full-metric-period", "period of calculating all metrics on the full datasets when metric-sample-rate < 1; last iteration only if 0")
+        .RequiredArgument("int")
+        .Handler1T<int>([plainJsonPtr](const auto period) {
+        (*plainJsonPtr)["full_metric_period"] = period;
+    });
+
     parser.AddLongOption("snapshot-file", "use progress file for restoring progress after crashes")
         .RequiredArgument("PATH")
         .Handler1T<TString>([plainJsonPtr](const TString& path) {
@@ -596,6 +614,28 @@ static void BindFeatureEvalParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonVal
         .Handler1T<ui32>([plainJsonPtr](const auto foldSize) {
             (*plainJsonPtr)["fold_size"] = foldSize;
         });
+    parser
+        .AddLongOption("sequential-testing")
+        .NoArgument()
+        .Help("Train baseline and tested folds in pairs and stop evaluating a feature set"
+            " once a sequential test on fold metrics decides whether it is better or worse")
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["sequential_testing"] = true;
+        });
+    parser
+        .AddLongOption("sequential-test-significance")
+        .RequiredArgument("FLOAT")
+        .Help("Probability of a wrong verdict of the sequential test, should be in (0, 0.5)")
+        .Handler1T<double>([plainJsonPtr](const auto significance) {
+            (*plainJsonPtr)["sequential_test_significance"] = significance;
+        });
+    parser
+        .AddLongOption("sequential-test-win-probability")
+        .RequiredArgument("FLOAT")
+        .Help("Probability of tested set to win a fold under the alternative the sequential test detects, should be in (0.5, 1)")
+        .Handler1T<double>([plainJsonPtr](const auto winProbability) {
+            (*plainJsonPtr)["sequential_test_win_probability"] = winProbability;
+        });
 }
 
 static void BindTreeParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* plainJsonPtr) {
@@ -0,0 +1,345 @@
+#include "modes.h"
+
+#include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/libs/model/model.h>
+
+#include <library/getopt/small/last_getopt.h>
+#include <library/neh/rpc.h>
+
+#include <util/datetime/base.h>
+#include <util/generic/bitops.h>
+#include <util/generic/deque.h>
+#include <util/generic/ptr.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/string/builder.h>
+#include <util/string/cast.h>
+#include <util/string/split.h>
+#include <util/system/condvar.h>
+#include <util/system/info.h>
+#include <util/system/mutex.h>
+#include <util/system/thread.h>
+
+#include <atomic>
+
+
+namespace {
+    struct TServeParams {
+        TVector<std::pair<TString, TString>> ModelNamesAndPaths;
+        ui16 Port = 8080;
+        ui32 ThreadCount = NSystemInfo::CachedNumberOfCpus();
+        ui32 CalcThreadCount = 1;
+        ui32 MaxBatchSize = 1024;
+        ui32 MaxBatchDelayUs = 1000;
+
+        void BindParserOpts(NLastGetopt::TOpts& parser) {
+            parser.AddLongOption('m', "model", "model to serve at /predict/NAME, may be repeated")
+                .RequiredArgument("NAME=PATH")
+                .KVHandler([this](TString name, TString path) {
+                    ModelNamesAndPaths.emplace_back(name, path);
+                });
+            parser.AddLongOption("port", "HTTP port (default: 8080)")
+                .StoreResult(&Port);
+            parser.AddLongOption('T', "thread-count", "request handling thread count (default: core count)")
+                .StoreResult(&ThreadCount);
+            parser.AddLongOption("calc-thread-count", "per model thread count for batch evaluation (default: 1)")
+                .StoreResult(&CalcThreadCount);
+            parser.AddLongOption("max-batch-size", "max number of objects evaluated in one batch (default: 1024)")
+                .StoreResult(&MaxBatchSize);
+            parser.AddLongOption(
+                "max-batch-delay-us",
+                "max time in microseconds a request waits for other requests to be batched with (default: 1000)")
+                .StoreResult(&MaxBatchDelayUs);
+        }
+    };
+
+    // counts durations in buckets [2^(i-1), 2^i) microseconds
+    class TLatencyHistogram {
+    public:
+        TLatencyHistogram() {
+            for (auto& count : Counts) {
+                count = 0;
+            }
+        }
+
+        void Add(TDuration duration) {
+            const ui64 microSeconds = duration.MicroSeconds();
+            const size_t bucketIdx = microSeconds ? Min<size_t>(GetValueBitCount(microSeconds), BucketCount - 1) : 0;
+            Counts[bucketIdx].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Print(TStringBuf name, IOutputStream* out) const {
+            *out << name;
+            for (auto bucketIdx : xrange(BucketCount)) {
+                const ui64 count = Counts[bucketIdx].load(std::memory_order_relaxed);
+                if (count) {
+                    *out << '\t' << "<" << (bucketIdx + 1 < BucketCount ? ToString(1ull << bucketIdx) : "inf") << "us:" << count;
+                }
+            }
+            *out << '\n';
+        }
+
+    private:
+        static constexpr size_t BucketCount = 28;
+        std::atomic<ui64> Counts[BucketCount];
+    };
+
+    struct TPendingRequest {
+        NNeh::IRequestRef Request;
+        TVector<float> Features; // flat features of all request objects, [objectIdx * flatFeatureCount + featureIdx]
+        size_t ObjectCount = 0;
+        TInstant ArrivalTime;
+    };
+
+    // Requests are parsed in handler threads and queued, calc threads take objects of several requests
+    // (up to MaxBatchSize) and evaluate them with a single CalcFlat call. A request waits for others
+    // no longer than MaxBatchDelay.
+    class TModelServer {
+    public:
+        TModelServer(const TString& name, TFullModel&& model, const TServeParams& params)
+            : Name(name)
+            , Model(std::move(model))
+            , MaxBatchSize(params.MaxBatchSize)
+            , MaxBatchDelay(TDuration::MicroSeconds(params.MaxBatchDelayUs))
+            , StartTime(TInstant::Now())
+        {
+            CB_ENSURE(MaxBatchSize > 0, "Max batch size should be positive");
+            CB_ENSURE(Model.ObliviousTrees->GetTextFeatures().empty(), "Model " << name << ": text features are not supported in serve mode");
+            for (const auto& floatFeature : Model.ObliviousTrees->GetFloatFeatures()) {
+                FlatFeatureCount = Max<size_t>(FlatFeatureCount, floatFeature.Position.FlatIndex + 1);
+            }
+            for (const auto& catFeature : Model.ObliviousTrees->GetCatFeatures()) {
+                FlatFeatureCount = Max<size_t>(FlatFeatureCount, catFeature.Position.FlatIndex + 1);
+            }
+            IsCatFeature.resize(FlatFeatureCount, false);
+            for (const auto& catFeature : Model.ObliviousTrees->GetCatFeatures()) {
+                IsCatFeature[catFeature.Position.FlatIndex] = true;
+            }
+            for (auto threadIdx : xrange(params.CalcThreadCount)) {
+                Y_UNUSED(threadIdx);
+                CalcThreads.push_back(MakeHolder<TThread>([this] () { CalcLoop(); }));
+                CalcThreads.back()->Start();
+            }
+        }
+
+        ~TModelServer() {
+            {
+                TGuard<TMutex> guard(Mutex);
+                Stopped = true;
+            }
+            CondVar.BroadCast();
+            for (auto& thread : CalcThreads) {
+                thread->Join();
+            }
+        }
+
+        // one object per line, tab-separated values of all model features in flat order
+        void ServeRequest(const NNeh::IRequestRef& request) {
+            TPendingRequest pendingRequest;
+            pendingRequest.ArrivalTime = request->ArrivalTime();
+            try {
+                ParseObjects(request->Data(), &pendingRequest);
+            } catch (...) {
+                ErrorCount.fetch_add(1, std::memory_order_relaxed);
+                request->SendError(NNeh::IRequest::BadRequest, CurrentExceptionMessage());
+                return;
+            }
+            pendingRequest.Request = request;
+            {
+                TGuard<TMutex> guard(Mutex);
+                QueuedObjectCount += pendingRequest.ObjectCount;
+                Queue.push_back(std::move(pendingRequest));
+            }
+            CondVar.Signal();
+        }
+
+        void PrintStats(IOutputStream* out) const {
+            const double seconds = Max((TInstant::Now() - StartTime).SecondsFloat(), 1e-6);
+            const ui64 objectCount = ObjectCount.load(std::memory_order_relaxed);
+            const ui64 batchCount = BatchCount.load(std::memory_order_relaxed);
+            *out << "model\t" << Name << '\n';
+            *out << "requests\t" << RequestCount.load(std::memory_order_relaxed) << '\n';
+            *out << "errors\t" << ErrorCount.load(std::memory_order_relaxed) << '\n';
+            *out << "objects\t" << objectCount << '\n';
+            *out << "batches\t" << batchCount << '\n';
+            *out << "mean_batch_size\t" << (batchCount ? double(objectCount) / batchCount : 0.0) << '\n';
+            *out << "objects_per_second\t" << objectCount / seconds << '\n';
+            RequestLatency.Print("request_latency", out);
+            BatchCalcTime.Print("batch_calc_time", out);
+        }
+
+    private:
+        void ParseObjects(TStringBuf data, TPendingRequest* request) const {
+            for (TStringBuf line : StringSplitter(data).Split('\n').SkipEmpty()) {
+                line.ChopSuffix("\r");
+                if (line.empty()) {
+                    continue;
+                }
+                size_t featureIdx = 0;
+                for (TStringBuf value : StringSplitter(line).Split('\t')) {
+                    CB_ENSURE(
+                        featureIdx < FlatFeatureCount,
+                        "Object " << request->ObjectCount << " has more than " << FlatFeatureCount << " features");
+                    if (IsCatFeature[featureIdx]) {
+                        request->Features.push_back(ConvertCatFeatureHashToFloat(CalcCatFeatureHash(value)));
+                    } else {
+                        float floatValue;
+                        CB_ENSURE(
+                            TryFromString<float>(value, floatValue),
+                            "Object " << request->ObjectCount << ": cannot parse float feature " << featureIdx
+                            << " value '" << value << "'");
+                        request->Features.push_back(floatValue);
+                    }
+                    ++featureIdx;
+                }
+                CB_ENSURE(
+                    featureIdx == FlatFeatureCount,
+                    "Object " << request->ObjectCount << " has " << featureIdx << " features, expected " << FlatFeatureCount);
+                ++request->ObjectCount;
+            }
+            CB_ENSURE(request->ObjectCount > 0, "Request has no objects");
+        }
+
+        void CalcLoop() {
+            while (true) {
+                TVector<TPendingRequest> batch;
+                {
+                    TGuard<TMutex> guard(Mutex);
+                    CondVar.WaitI(Mutex, [this] { return Stopped || !Queue.empty(); });
+                    if (Queue.empty()) {
+                        return; // stopped
+                    }
+                    const TInstant deadline = Queue.front().ArrivalTime + MaxBatchDelay;
+                    CondVar.WaitD(
+                        Mutex,
+                        deadline,
+                        [this] { return Stopped || Queue.empty() || QueuedObjectCount >= MaxBatchSize; });
+                    size_t batchObjectCount = 0;
+                    while (!Queue.empty()
+                        && (batch.empty() || batchObjectCount + Queue.front().ObjectCount <= MaxBatchSize))
+                    {
+                        batchObjectCount += Queue.front().ObjectCount;
+                        QueuedObjectCount -= Queue.front().ObjectCount;
+                        batch.push_back(std::move(Queue.front()));
+                        Queue.pop_front();
+                    }
+                }
+                if (!batch.empty()) {
+                    CalcBatch(&batch);
+                }
+            }
+        }
+
+        void CalcBatch(TVector<TPendingRequest>* batch) {
+            const size_t approxDimension = Model.GetDimensionsCount();
+            TVector<TConstArrayRef<float>> objects;
+            for (const auto& request : *batch) {
+                for (auto objectIdx : xrange(request.ObjectCount)) {
+                    objects.push_back(MakeArrayRef(request.Features.data() + objectIdx * FlatFeatureCount, FlatFeatureCount));
+                }
+            }
+            TVector<double> predictions;
+            predictions.yresize(objects.size() * approxDimension);
+            const TInstant calcStart = TInstant::Now();
+            try {
+                Model.CalcFlat(objects, predictions);
+            } catch (...) {
+                const TString message = CurrentExceptionMessage();
+                for (auto& request : *batch) {
+                    request.Request->SendError(NNeh::IRequest::InternalError, message);
+                }
+                ErrorCount.fetch_add(batch->size(), std::memory_order_relaxed);
+                return;
+            }
+            BatchCalcTime.Add(TInstant::Now() - calcStart);
+            BatchCount.fetch_add(1, std::memory_order_relaxed);
+            ObjectCount.fetch_add(objects.size(), std::memory_order_relaxed);
+
+            size_t predictionOffset = 0;
+            for (auto& request : *batch) {
+                NNeh::TDataSaver reply;
+                for (auto objectIdx : xrange(request.ObjectCount)) {
+                    Y_UNUSED(objectIdx);
+                    for (auto dim : xrange(approxDimension)) {
+                        if (dim) {
+                            reply << '\t';
+                        }
+                        reply << predictions[predictionOffset + dim];
+                    }
+                    reply << '\n';
+                    predictionOffset += approxDimension;
+                }
+                request.Request->SendReply(reply);
+                RequestLatency.Add(TInstant::Now() - request.ArrivalTime);
+            }
+            RequestCount.fetch_add(batch->size(), std::memory_order_relaxed);
+        }
+
+    private:
+        const TString Name;
+        const TFullModel Model;
+        const size_t MaxBatchSize;
+        const TDuration MaxBatchDelay;
+        const TInstant StartTime;
+        size_t FlatFeatureCount = 0;
+        TVector<bool> IsCatFeature; // [flatFeatureIdx]
+
+        TMutex Mutex;
+        TCondVar CondVar;
+        TDeque<TPendingRequest> Queue;
+        size_t QueuedObjectCount = 0;
+        bool Stopped = false;
+        TVector<THolder<TThread>> CalcThreads;
+
+        std::atomic<ui64> RequestCount{0};
+        std::atomic<ui64> ErrorCount{0};
+        std::atomic<ui64> ObjectCount{0};
+        std::atomic<ui64> BatchCount{0};
+        TLatencyHistogram RequestLatency;
+        TLatencyHistogram BatchCalcTime;
+    };
+} // anonymous namespace
+
+int mode_serve(int argc, const char* argv[]) {
+    TServeParams params;
+
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    params.BindParserOpts(parser);
+    parser.SetFreeArgsNum(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+
+    CB_ENSURE(!params.ModelNamesAndPaths.empty(), "At least one model should be specified");
+
+    const TString address = TStringBuilder() << "http://*:" << params.Port << "/";
+    auto services = NNeh::CreateLoop();
+    TVector<THolder<TModelServer>> modelServers;
+    for (const auto& [name, path] : params.ModelNamesAndPaths) {
+        modelServers.push_back(MakeHolder<TModelServer>(name, ReadModel(path), params));
+        services->Add(address + "predict/" + name, *modelServers.back());
+        CATBOOST_NOTICE_LOG << "Model " << path << " is served at /predict/" << name << Endl;
+    }
+    services->Add(
+        address + "stats",
+        [&modelServers] (const NNeh::IRequestRef& request) {
+            NNeh::TDataSaver reply;
+            for (const auto& modelServer : modelServers) {
+                modelServer->PrintStats(&reply);
+            }
+            request->SendReply(reply);
+        });
+    services->Add(
+        address + "ping",
+        [] (const NNeh::IRequestRef& request) {
+            NNeh::TDataSaver reply;
+            reply << "ok\n";
+            request->SendReply(reply);
+        });
+
+    CATBOOST_NOTICE_LOG << "Listening on port " << params.Port << Endl;
+    services->Loop(params.ThreadCount);
+    return 0;
+}
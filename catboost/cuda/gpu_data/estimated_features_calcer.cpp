@@ -10,8 +10,13 @@ namespace NCatboostCuda {
         ) {
 
         TGpuBordersBuilder bordersBuilder(FeaturesManager);
+
+        TVector<const NCB::IOnlineFeatureEstimator*> onlineEstimators;
+        TVector<NCB::TCalculatedFeatureVisitor> onlineLearnVisitors;
+        TVector<TVector<NCB::TCalculatedFeatureVisitor>> onlineTestVisitors;
+
         for (const auto& estimator : estimatorIds) {
-            auto featureVisitor = [&](TBinarizedFeatureVisitor visitor, ui32 featureId, TConstArrayRef<float> values) {
+            auto featureVisitor = [&bordersBuilder, estimator, this](TBinarizedFeatureVisitor visitor, ui32 featureId, TConstArrayRef<float> values) {
                 TEstimatedFeature feature{estimator, featureId};
                 auto id = FeaturesManager.GetId(feature);
                 auto borders = bordersBuilder.GetOrComputeBorders(id, FeaturesManager.GetBinarizationDescription(feature), values);
@@ -30,15 +35,23 @@ namespace NCatboostCuda {
             }
 
             if (estimator.IsOnline) {
-                Estimators.GetOnlineFeatureEstimator(estimator.Id)->ComputeOnlineFeatures(
-                    PermutationIndices,
-                    learnVisitor,
-                    testVisitors,
-                    LocalExecutor);
+                // online estimation is sequential in objects, so run online estimators concurrently below
+                onlineEstimators.push_back(Estimators.GetOnlineFeatureEstimator(estimator.Id).Get());
+                onlineLearnVisitors.push_back(std::move(learnVisitor));
+                onlineTestVisitors.push_back(std::move(testVisitors));
             } else {
                 Estimators.GetFeatureEstimator(estimator.Id)->ComputeFeatures(learnVisitor, testVisitors, LocalExecutor);
             }
         }
+
+        if (!onlineEstimators.empty()) {
+            NCB::ComputeOnlineFeaturesConcurrently(
+                onlineEstimators,
+                PermutationIndices,
+                onlineLearnVisitors,
+                onlineTestVisitors,
+                LocalExecutor);
+        }
     }
 
 }
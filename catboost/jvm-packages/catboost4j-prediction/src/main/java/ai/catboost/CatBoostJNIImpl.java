@@ -2,6 +2,9 @@ package ai.catboost;
 
 import javax.annotation.Nullable;
 import javax.validation.constraints.NotNull;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 
 class CatBoostJNIImpl {
     final static void checkCall(@Nullable String message) throws CatBoostError {
@@ -85,4 +88,14 @@ class CatBoostJNIImpl {
             @Nullable float[][] numericFeatures,
             @Nullable int[][] catFeatureHashes,
             @NotNull double[] predictions);
-}
\ No newline at end of file
+
+    @Nullable
+    final static native String catBoostModelPredictDirect(
+            long handle,
+            int documentCount,
+            @Nullable FloatBuffer numericFeatures,
+            int numericFeatureCount,
+            @Nullable IntBuffer catFeatureHashes,
+            int catFeatureCount,
+            @NotNull DoubleBuffer predictions);
+}
@@ -5,6 +5,11 @@ import javax.validation.constraints.NotNull;
 import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.Buffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 
 /**
  * CatBoost model, supports basic model application.
@@ -363,6 +368,77 @@ public class CatBoostModel implements AutoCloseable {
         return prediction;
     }
 
+    /**
+     * Apply model to a batch of objects stored in direct buffers. Buffers are passed to native library as is, without
+     * copying, so it is the cheapest way to apply model to a large number of objects.
+     *
+     * Features are stored row-major starting from the buffer position, i.e. numeric feature {@code j} of object
+     * {@code i} is {@code numericFeatures.get(numericFeatures.position() + i * numericFeatureCount + j)}. All buffers
+     * must be direct and use native byte order, e.g. created by
+     * {@code ByteBuffer.allocateDirect(size).order(ByteOrder.nativeOrder()).asFloatBuffer()}.
+     *
+     * Predictions are written row-major starting from {@code predictions.position()}. Positions of buffers are not
+     * changed, so the same buffers may be reused for consecutive batches.
+     *
+     * @param documentCount       Number of objects.
+     * @param numericFeatures     Numeric features, may be null if {@code numericFeatureCount} is zero.
+     * @param numericFeatureCount Number of numeric features of each object.
+     * @param catFeatureHashes    Categoric feature hashes computed by {@link #hashCategoricalFeature(String)}, may be
+     *                            null if {@code catFeatureCount} is zero.
+     * @param catFeatureCount     Number of categoric features of each object.
+     * @param predictions         Model predictions, must have at least {@code documentCount * getPredictionDimension()}
+     *                            elements remaining.
+     * @throws CatBoostError In case of error within native library or if buffers are not suitable.
+     */
+    public void predict(
+            final int documentCount,
+            final @Nullable FloatBuffer numericFeatures,
+            final int numericFeatureCount,
+            final @Nullable IntBuffer catFeatureHashes,
+            final int catFeatureCount,
+            final @NotNull DoubleBuffer predictions) throws CatBoostError {
+        if (documentCount < 0 || numericFeatureCount < 0 || catFeatureCount < 0) {
+            throw new CatBoostError("document and feature counts must be non-negative");
+        }
+        final long numericFeaturesSize = (long) documentCount * numericFeatureCount;
+        final long catFeaturesSize = (long) documentCount * catFeatureCount;
+        final long predictionsSize = (long) documentCount * getPredictionDimension();
+        if (numericFeatures != null) {
+            checkDirectBuffer(numericFeatures, numericFeatures.order(), numericFeaturesSize, "numericFeatures");
+        }
+        if (catFeatureHashes != null) {
+            checkDirectBuffer(catFeatureHashes, catFeatureHashes.order(), catFeaturesSize, "catFeatureHashes");
+        }
+        checkDirectBuffer(predictions, predictions.order(), predictionsSize, "predictions");
+
+        // slices start at buffer positions and leave positions of original buffers untouched
+        NativeLib.handle().catBoostModelPredictDirect(
+                handle,
+                documentCount,
+                numericFeatures == null ? null : numericFeatures.slice(),
+                numericFeatureCount,
+                catFeatureHashes == null ? null : catFeatureHashes.slice(),
+                catFeatureCount,
+                predictions.slice());
+    }
+
+    private static void checkDirectBuffer(
+            final @NotNull Buffer buffer,
+            final @NotNull ByteOrder order,
+            final long size,
+            final @NotNull String name) throws CatBoostError {
+        if (!buffer.isDirect()) {
+            throw new CatBoostError("`" + name + "` must be a direct buffer");
+        }
+        if (order != ByteOrder.nativeOrder()) {
+            throw new CatBoostError("`" + name + "` must use native byte order");
+        }
+        if (buffer.remaining() < size) {
+            throw new CatBoostError(
+                    "`" + name + "` is too small: " + String.valueOf(buffer.remaining()) + " < " + String.valueOf(size));
+        }
+    }
+
     @Override
     protected void finalize() throws Throwable {
         try {
@@ -635,5 +635,89 @@ JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict_
     Y_END_JNI_API_CALL();
 }
 
+// NOTE: capacity of a view buffer (e.g. `FloatBuffer` created by `ByteBuffer.asFloatBuffer`) is
+// reported in its elements, not in bytes.
+template <typename T>
+static TArrayRef<T> GetDirectBufferData(
+    JNIEnv* const jenv,
+    const jobject buffer,
+    const size_t size,
+    const TStringBuf bufferName) {
+
+    if (size == 0) {
+        return {};
+    }
+
+    CB_ENSURE(jenv->IsSameObject(buffer, NULL) == JNI_FALSE, "got null `" << bufferName << "` buffer");
+    auto* const data = static_cast<T*>(jenv->GetDirectBufferAddress(buffer));
+    CB_ENSURE(data, "`" << bufferName << "` must be a direct buffer");
+    const jlong capacity = jenv->GetDirectBufferCapacity(buffer);
+    CB_ENSURE(
+        capacity >= 0 && static_cast<size_t>(capacity) >= size,
+        "`" << bufferName << "` buffer is too small: " LabeledOutput(capacity, size));
+    return MakeArrayRef(data, size);
+}
+
+JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredictDirect
+  (JNIEnv* jenv, jclass, jlong jhandle, jint jdocumentCount, jobject jnumericFeatures, jint jnumericFeatureCount, jobject jcatFeatureHashes, jint jcatFeatureCount, jobject jpredictions) {
+    Y_BEGIN_JNI_API_CALL();
+
+    const auto* const model = ToConstFullModelPtr(jhandle);
+    CB_ENSURE(model, "got nullptr model pointer");
+    CB_ENSURE(
+        jdocumentCount >= 0 && jnumericFeatureCount >= 0 && jcatFeatureCount >= 0,
+        "negative size: " LabeledOutput(jdocumentCount, jnumericFeatureCount, jcatFeatureCount));
+
+    const size_t modelPredictionSize = model->GetDimensionsCount();
+    const size_t minNumericFeatureCount = model->GetNumFloatFeatures();
+    const size_t minCatFeatureCount = model->GetNumCatFeatures();
+    const size_t documentCount = jdocumentCount;
+    const size_t numericFeatureCount = jnumericFeatureCount;
+    const size_t catFeatureCount = jcatFeatureCount;
+
+    CB_ENSURE(
+        numericFeatureCount >= minNumericFeatureCount,
+        LabeledOutput(numericFeatureCount, minNumericFeatureCount));
+
+    CB_ENSURE(
+        catFeatureCount >= minCatFeatureCount,
+        LabeledOutput(catFeatureCount, minCatFeatureCount));
+
+    if (documentCount == 0) {
+        return nullptr;
+    }
+
+    // buffers are used in place: features are only viewed row by row and predictions are written
+    // directly to the (reusable) output buffer
+    const auto numericFeatures = GetDirectBufferData<const float>(
+        jenv, jnumericFeatures, documentCount * numericFeatureCount, "numericFeatures");
+    const auto catFeatureHashes = GetDirectBufferData<const int>(
+        jenv, jcatFeatureHashes, documentCount * catFeatureCount, "catFeatureHashes");
+    const auto predictions = GetDirectBufferData<double>(
+        jenv, jpredictions, documentCount * modelPredictionSize, "predictions");
+
+    TVector<TConstArrayRef<float>> numericFeatureMatrixRows;
+    if (numericFeatureCount) {
+        numericFeatureMatrixRows.reserve(documentCount);
+        for (size_t i = 0; i < documentCount; ++i) {
+            numericFeatureMatrixRows.push_back(
+                numericFeatures.Slice(i * numericFeatureCount, numericFeatureCount));
+        }
+    }
+
+    TVector<TConstArrayRef<int>> catFeatureMatrixRows;
+    if (catFeatureCount) {
+        catFeatureMatrixRows.reserve(documentCount);
+        for (size_t i = 0; i < documentCount; ++i) {
+            catFeatureMatrixRows.push_back(
+                catFeatureHashes.Slice(i * catFeatureCount, catFeatureCount));
+        }
+    }
+
+    model->Calc(numericFeatureMatrixRows, catFeatureMatrixRows, predictions);
+
+    Y_END_JNI_API_CALL();
+}
+
 #undef Y_BEGIN_JNI_API_CALL
 #undef Y_END_JNI_API_CALL
@@ -6,6 +6,11 @@ import org.junit.Test;
 
 import javax.validation.constraints.NotNull;
 import java.io.*;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 
 import static org.junit.Assert.fail;
 
@@ -464,6 +469,58 @@ public class CatBoostModelTest {
         }
     }
 
+    @Test
+    public void testSuccessfulPredictMultipleDirectBuffers() throws CatBoostError {
+        try(final CatBoostModel model = loadTestModel()) {
+            final float[] numericFeatures = new float[]{
+                0.5f, 1.5f,
+                0.7f, 6.4f,
+                -2.0f, -1.0f};
+            final String[] catFeatures = new String[]{
+                "a", "d", "g",
+                "b", "e", "h",
+                "c", "f", "k"};
+            final FloatBuffer numericFeaturesBuffer = ByteBuffer.allocateDirect(4 * numericFeatures.length)
+                .order(ByteOrder.nativeOrder())
+                .asFloatBuffer();
+            numericFeaturesBuffer.put(numericFeatures).rewind();
+            final IntBuffer catFeatureHashesBuffer = ByteBuffer.allocateDirect(4 * catFeatures.length)
+                .order(ByteOrder.nativeOrder())
+                .asIntBuffer();
+            catFeatureHashesBuffer.put(CatBoostModel.hashCategoricalFeatures(catFeatures)).rewind();
+            final DoubleBuffer predictionsBuffer = ByteBuffer.allocateDirect(8 * 3)
+                .order(ByteOrder.nativeOrder())
+                .asDoubleBuffer();
+
+            model.predict(3, numericFeaturesBuffer, 2, catFeatureHashesBuffer, 3, predictionsBuffer);
+            final double[] predictions = new double[3];
+            predictionsBuffer.get(predictions);
+            assertEqual(
+                new CatBoostPredictions(3, 1, new double[]{
+                    0.04666924366060905,
+                    0.026244613740247648,
+                    0.03094452158737013}),
+                new CatBoostPredictions(3, 1, predictions));
+        }
+    }
+
+    @Test
+    public void testFailPredictMultipleDirectBuffersHeapBuffer() throws CatBoostError {
+        try(final CatBoostModel model = loadTestModel()) {
+            try {
+                model.predict(
+                    1,
+                    FloatBuffer.allocate(2),
+                    2,
+                    IntBuffer.allocate(3),
+                    3,
+                    ByteBuffer.allocateDirect(8).order(ByteOrder.nativeOrder()).asDoubleBuffer());
+                fail();
+            } catch (CatBoostError e) {
+            }
+        }
+    }
+
     @Test
     public void testFailPredictMultipleNullInNumeric() throws CatBoostError {
         try(final CatBoostModel model = loadTestModel()) {
@@ -21,7 +21,11 @@ namespace NCB {
     TCBDsvDataLoader::TCBDsvDataLoader(TDatasetLoaderPullArgs&& args)
         : TCBDsvDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(
+                    args.PoolPath,
+                    args.CommonArgs.PoolFormat,
+                    args.CommonArgs.LocalExecutor->GetThreadCount() + 1
+                ),
                 std::move(args.CommonArgs)
             }
         )
@@ -249,6 +253,11 @@ namespace NCB {
     namespace {
         TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> DefDataLoaderReg("");
         TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvDataLoaderReg("dsv");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvMappedFileDataLoaderReg("mmap");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvGZipDataLoaderReg("gz");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvBlockCodecsDataLoaderReg("blockcodecs");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvZstdDataLoaderReg("zstd");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvLz4DataLoaderReg("lz4");
     }
 }
 
@@ -1282,7 +1282,7 @@ namespace NCB {
                 GetInternalFeatureIdx<EFeatureType::Float>(flatFeatureIdx),
                 objectOffset,
                 bitsPerDocumentFeature,
-                *featuresPart,
+                std::move(featuresPart),
                 LocalExecutor
             );
         }
@@ -1297,7 +1297,7 @@ namespace NCB {
                 GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx),
                 objectOffset,
                 bitsPerDocumentFeature,
-                *featuresPart,
+                std::move(featuresPart),
                 LocalExecutor
             );
         }
@@ -1576,6 +1576,11 @@ namespace NCB {
             // view into storage for faster access
             TVector<TArrayRef<ui64>> DenseDstView; // [perTypeFeatureIdx]
 
+            /* data passed by loader that is used as is without copying to DenseDataStorage
+             * (memory mapped quantized pool file for example)
+             */
+            TVector<TMaybe<TMaybeOwningArrayHolder<ui64>>> ReferencedDenseData; // [perTypeFeatureIdx]
+
             TVector<TIndexHelper<ui64>> IndexHelpers; // [perTypeFeatureIdx]
 
             /******************************************************************************************/
@@ -1593,6 +1598,8 @@ namespace NCB {
             // copy from Data.MetaInfo.FeaturesLayout for fast access
             TVector<bool> IsAvailable; // [perTypeFeatureIdx]
 
+            ui32 ObjectCount = 0;
+
         public:
             void PrepareForInitialization(
                 const TFeaturesLayout& featuresLayout,
@@ -1602,8 +1609,10 @@ namespace NCB {
                 TConstArrayRef<TMaybe<TPackedBinaryIndex>> flatFeatureIndexToPackedBinaryIndex
             ) {
                 const size_t perTypeFeatureCount = (size_t)featuresLayout.GetFeatureCount(FeatureType);
+                ObjectCount = objectCount;
                 DenseDataStorage.resize(perTypeFeatureCount);
                 DenseDstView.resize(perTypeFeatureCount);
+                ReferencedDenseData.assign(perTypeFeatureCount, Nothing());
                 IsAvailable.resize(perTypeFeatureCount, false); // filled from quantization Schema, then checked
                 IndexHelpers.resize(perTypeFeatureCount, TIndexHelper<ui64>(8));
                 FeatureIdxToPackedBinaryIndex.resize(perTypeFeatureCount);
@@ -1680,7 +1689,7 @@ namespace NCB {
                 TFeatureIdx<FeatureType> perTypeFeatureIdx,
                 ui32 objectOffset,
                 ui8 bitsPerDocumentFeature,
-                TConstArrayRef<ui8> featuresPart,
+                TMaybeOwningConstArrayHolder<ui8> featuresPart,
                 NPar::TLocalExecutor* localExecutor
             ) {
                 if (!IsAvailable[*perTypeFeatureIdx]) {
@@ -1691,10 +1700,10 @@ namespace NCB {
                     auto packedBinaryIndex = *FeatureIdxToPackedBinaryIndex[*perTypeFeatureIdx];
                     auto dstSlice = DstBinaryView[packedBinaryIndex.PackIdx].Slice(
                         objectOffset,
-                        featuresPart.size()
+                        featuresPart.GetSize()
                     );
                     ParallelSetBinaryFeatureInPackArray(
-                        featuresPart,
+                        *featuresPart,
                         packedBinaryIndex.BitIdx,
                         /*needToClearDstBits*/ false,
                         localExecutor,
@@ -1709,6 +1718,10 @@ namespace NCB {
 
                     const auto bytesPerDocument = bitsPerDocumentFeature / (sizeof(ui8) * CHAR_BIT);
 
+                    if (TryToReferenceDenseData(perTypeFeatureIdx, objectOffset, bytesPerDocument, featuresPart)) {
+                        return;
+                    }
+
                     const auto dstCapacityInBytes =
                         DenseDstView[*perTypeFeatureIdx].size() *
                         sizeof(decltype(*DenseDstView[*perTypeFeatureIdx].data()));
@@ -1716,19 +1729,52 @@ namespace NCB {
 
                     CB_ENSURE_INTERNAL(
                         objectOffsetInBytes < dstCapacityInBytes,
-                        LabeledOutput(perTypeFeatureIdx, objectOffset, objectOffsetInBytes, featuresPart.size(), dstCapacityInBytes));
+                        LabeledOutput(perTypeFeatureIdx, objectOffset, objectOffsetInBytes, featuresPart.GetSize(), dstCapacityInBytes));
                     CB_ENSURE_INTERNAL(
-                        objectOffsetInBytes + featuresPart.size() <= dstCapacityInBytes,
-                        LabeledOutput(perTypeFeatureIdx, objectOffset, objectOffsetInBytes, featuresPart.size(), dstCapacityInBytes));
+                        objectOffsetInBytes + featuresPart.GetSize() <= dstCapacityInBytes,
+                        LabeledOutput(perTypeFeatureIdx, objectOffset, objectOffsetInBytes, featuresPart.GetSize(), dstCapacityInBytes));
 
 
                     memcpy(
-                        ((ui8*)DenseDstView[*perTypeFeatureIdx].data()) + objectOffset,
+                        ((ui8*)DenseDstView[*perTypeFeatureIdx].data()) + objectOffsetInBytes,
                         featuresPart.data(),
-                        featuresPart.size());
+                        featuresPart.GetSize());
                 }
             }
 
+            /* use featuresPart as feature storage if it is owning and contains the whole aligned column,
+             * see contract in IQuantizedFeaturesDataVisitor::AddFloatFeaturePart
+             */
+            bool TryToReferenceDenseData(
+                TFeatureIdx<FeatureType> perTypeFeatureIdx,
+                ui32 objectOffset,
+                size_t bytesPerDocument,
+                const TMaybeOwningConstArrayHolder<ui8>& featuresPart
+            ) {
+                if (!featuresPart.GetResourceHolder() ||
+                    (objectOffset != 0) ||
+                    (featuresPart.GetSize() != size_t(ObjectCount) * bytesPerDocument) ||
+                    (reinterpret_cast<uintptr_t>(featuresPart.data()) % alignof(ui64) != 0))
+                {
+                    return false;
+                }
+
+                // feature data is never modified after loading so it is safe to share read-only memory
+                ReferencedDenseData[*perTypeFeatureIdx] = TMaybeOwningArrayHolder<ui64>::CreateOwning(
+                    TArrayRef<ui64>(
+                        const_cast<ui64*>(reinterpret_cast<const ui64*>(featuresPart.data())),
+                        IndexHelpers[*perTypeFeatureIdx].CompressedSize(ObjectCount)
+                    ),
+                    featuresPart.GetResourceHolder()
+                );
+
+                // release preallocated storage, it won't be used for this feature
+                DenseDataStorage[*perTypeFeatureIdx] = nullptr;
+                DenseDstView[*perTypeFeatureIdx] = TArrayRef<ui64>();
+
+                return true;
+            }
+
             template <class T, EFeatureValuesType FeatureValuesType>
             void GetResult(
                 ui32 objectCount,
@@ -1766,16 +1812,19 @@ namespace NCB {
                                 )
                             );
                         } else {
+                            const auto& referencedData = ReferencedDenseData[perTypeFeatureIdx];
                             result->push_back(
                                 MakeHolder<TCompressedValuesHolderImpl<T, FeatureValuesType>>(
                                     featureId,
                                     TCompressedArray(
                                         objectCount,
                                         IndexHelpers[perTypeFeatureIdx].GetBitsPerKey(),
-                                        TMaybeOwningArrayHolder<ui64>::CreateOwning(
-                                            DenseDstView[perTypeFeatureIdx],
-                                            DenseDataStorage[perTypeFeatureIdx]
-                                        )
+                                        referencedData ?
+                                            *referencedData
+                                            : TMaybeOwningArrayHolder<ui64>::CreateOwning(
+                                                DenseDstView[perTypeFeatureIdx],
+                                                DenseDataStorage[perTypeFeatureIdx]
+                                            )
                                     ),
                                     subsetIndexing
                                 )
@@ -25,7 +25,11 @@ namespace NCB {
     TLibSvmDataLoader::TLibSvmDataLoader(TDatasetLoaderPullArgs&& args)
         : TLibSvmDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(
+                    args.PoolPath,
+                    args.CommonArgs.PoolFormat,
+                    args.CommonArgs.LocalExecutor->GetThreadCount() + 1
+                ),
                 std::move(args.CommonArgs)
             }
         )
@@ -346,6 +350,16 @@ namespace NCB {
         TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmExistsCheckerReg("libsvm");
         TLineDataReaderFactory::TRegistrator<TFileLineDataReader> LibSvmLineDataReaderReg("libsvm");
         TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmDataLoaderReg("libsvm");
+
+        // compressed libsvm files, line readers are registered in data_util
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmGZipExistsCheckerReg("libsvm-gz");
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmBlockCodecsExistsCheckerReg("libsvm-blockcodecs");
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmZstdExistsCheckerReg("libsvm-zstd");
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> LibSvmLz4ExistsCheckerReg("libsvm-lz4");
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmGZipDataLoaderReg("libsvm-gz");
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmBlockCodecsDataLoaderReg("libsvm-blockcodecs");
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmZstdDataLoaderReg("libsvm-zstd");
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmLz4DataLoaderReg("libsvm-lz4");
     }
 }
 
@@ -7,6 +7,7 @@
 
 #include <util/charset/unidata.h>
 #include <util/generic/ptr.h>
+#include <util/string/ascii.h>
 #include <util/string/cast.h>
 #include <util/string/split.h>
 #include <util/system/types.h>
@@ -294,8 +295,93 @@ namespace NCB {
         }
     }
 
+    bool TryParseSimpleDecimal(TStringBuf stringValue, float* value) {
+        static constexpr double POWERS_OF_10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        constexpr int MAX_EXACT_POWER = 22;
+        constexpr int MAX_MANTISSA_DIGITS = 15;
+
+        const char* ptr = stringValue.begin();
+        const char* const end = stringValue.end();
+
+        bool negative = false;
+        if ((ptr != end) && ((*ptr == '-') || (*ptr == '+'))) {
+            negative = (*ptr == '-');
+            ++ptr;
+        }
+
+        ui64 mantissa = 0;
+        int mantissaDigits = 0;
+        int exponent = 0;
+
+        const char* intPartBegin = ptr;
+        for (; (ptr != end) && IsAsciiDigit(*ptr); ++ptr) {
+            if (mantissa || (*ptr != '0')) {
+                mantissa = mantissa * 10 + (*ptr - '0');
+                ++mantissaDigits;
+            }
+            if (mantissaDigits > MAX_MANTISSA_DIGITS) {
+                return false;
+            }
+        }
+        if (ptr == intPartBegin) {
+            return false;
+        }
+        if ((ptr != end) && (*ptr == '.')) {
+            ++ptr;
+            const char* fracPartBegin = ptr;
+            for (; (ptr != end) && IsAsciiDigit(*ptr); ++ptr) {
+                if (mantissa || (*ptr != '0')) {
+                    mantissa = mantissa * 10 + (*ptr - '0');
+                    ++mantissaDigits;
+                }
+                --exponent;
+                if (mantissaDigits > MAX_MANTISSA_DIGITS) {
+                    return false;
+                }
+            }
+            if (ptr == fracPartBegin) {
+                return false;
+            }
+        }
+        if ((ptr != end) && ((*ptr == 'e') || (*ptr == 'E'))) {
+            ++ptr;
+            bool negativeExponent = false;
+            if ((ptr != end) && ((*ptr == '-') || (*ptr == '+'))) {
+                negativeExponent = (*ptr == '-');
+                ++ptr;
+            }
+            const char* exponentBegin = ptr;
+            int explicitExponent = 0;
+            for (; (ptr != end) && IsAsciiDigit(*ptr); ++ptr) {
+                explicitExponent = explicitExponent * 10 + (*ptr - '0');
+                if (explicitExponent > 2 * MAX_EXACT_POWER) {
+                    return false;
+                }
+            }
+            if (ptr == exponentBegin) {
+                return false;
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
+        if ((ptr != end) || (exponent < -MAX_EXACT_POWER) || (exponent > MAX_EXACT_POWER)) {
+            return false;
+        }
+
+        double result = (double)mantissa;
+        if (exponent < 0) {
+            result /= POWERS_OF_10[-exponent];
+        } else {
+            result *= POWERS_OF_10[exponent];
+        }
+        *value = (float)(negative ? -result : result);
+        return true;
+    }
+
     bool TryParseFloatFeatureValue(TStringBuf stringValue, float* value) {
-        if (!TryFromString<float>(stringValue, *value)) {
+        if (!TryParseSimpleDecimal(stringValue, value) && !TryFromString<float>(stringValue, *value)) {
             if (IsMissingValue(stringValue)) {
                 *value = std::numeric_limits<float>::quiet_NaN();
             } else {
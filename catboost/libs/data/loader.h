@@ -260,5 +260,14 @@ namespace NCB {
      */
     bool IsMissingValue(const TStringBuf& s);
 
+    /* Fast path for plain decimal values like '-12.345' or '1.5e-3'.
+     * Only applied when the result is guaranteed to be the same as TryFromString<float>
+     * (that parses as double and casts to float): the mantissa has no more than 15
+     * significant digits and the decimal exponent is within [-22, 22],
+     * so a single double multiplication or division is exact-rounded.
+     * returns false if the value has to be parsed with the generic parser.
+     */
+    bool TryParseSimpleDecimal(TStringBuf stringValue, float* value);
+
     bool TryParseFloatFeatureValue(TStringBuf stringValue, float* value);
 }
@@ -0,0 +1,132 @@
+#include <catboost/libs/data/loader.h>
+
+#include <util/generic/strbuf.h>
+#include <util/generic/ymath.h>
+#include <util/string/cast.h>
+#include <util/system/types.h>
+
+#include <library/unittest/registar.h>
+
+#include <cstring>
+#include <initializer_list>
+
+
+using namespace NCB;
+
+
+static ui32 GetBits(float value) {
+    ui32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// fast path must either decline or produce exactly the same float as the generic parser
+static void CheckSameAsGenericParser(TStringBuf stringValue, bool expectFastPath) {
+    float fastValue = 0.0f;
+    const bool fastParsed = TryParseSimpleDecimal(stringValue, &fastValue);
+    UNIT_ASSERT_VALUES_EQUAL_C(fastParsed, expectFastPath, stringValue);
+    if (!fastParsed) {
+        return;
+    }
+    float genericValue = 0.0f;
+    UNIT_ASSERT_C(TryFromString<float>(stringValue, genericValue), stringValue);
+    UNIT_ASSERT_VALUES_EQUAL_C(GetBits(fastValue), GetBits(genericValue), stringValue);
+}
+
+
+Y_UNIT_TEST_SUITE(ParseFloatValue) {
+    Y_UNIT_TEST(SignsAndLeadingZeros) {
+        for (auto stringValue : {
+            "0", "-0", "+0", "00", "000.000", "-0.0",
+            "1", "+1", "-1", "007", "-007", "+0012.50", "-0012.50",
+            "0.000123", "-0.000123", "000000000000000000000000001"
+        }) {
+            CheckSameAsGenericParser(stringValue, /*expectFastPath*/ true);
+        }
+    }
+
+    Y_UNIT_TEST(DigitCountLimit) {
+        // up to 15 significant digits, leading zeros are not counted
+        for (auto stringValue : {
+            "123456789012345", "-123456789012345", "1.23456789012345", "0.00000123456789012345",
+            "000123456789012345", "99999999999999.9"
+        }) {
+            CheckSameAsGenericParser(stringValue, /*expectFastPath*/ true);
+        }
+        // more digits fall back to the generic parser, trailing zeros after a nonzero digit count too
+        for (auto stringValue : {
+            "1234567890123456", "-1234567890123456", "1.234567890123456", "0.1234567890123456",
+            "1.000000000000000", "12345678901234567890", "0.30000001192092896"
+        }) {
+            CheckSameAsGenericParser(stringValue, /*expectFastPath*/ false);
+
+            float value = 0.0f;
+            UNIT_ASSERT_C(TryParseFloatFeatureValue(stringValue, &value), stringValue);
+            float genericValue = 0.0f;
+            UNIT_ASSERT(TryFromString<float>(stringValue, genericValue));
+            UNIT_ASSERT_VALUES_EQUAL_C(GetBits(value), GetBits(genericValue), stringValue);
+        }
+    }
+
+    Y_UNIT_TEST(Exponents) {
+        for (auto stringValue : {
+            "1e0", "1E0", "1.5e-3", "-1.5E-3", "2.5e+10", "-2.5e+10", "1e22", "1e-22",
+            "123e-20", "0.001e25", "1e007", "0e22"
+        }) {
+            CheckSameAsGenericParser(stringValue, /*expectFastPath*/ true);
+        }
+        // decimal exponent out of [-22, 22] or too long, malformed exponents
+        for (auto stringValue : {
+            "1e23", "1e-23", "0e44", "123e-24", "1e45", "1e100", "3.4028235e38", "1.17549435e-38", "1e", "1e+", "1e-", "1ee1"
+        }) {
+            CheckSameAsGenericParser(stringValue, /*expectFastPath*/ false);
+        }
+        for (auto stringValue : {"1e23", "1e-23", "3.4028235e38", "1.17549435e-38"}) {
+            float value = 0.0f;
+            UNIT_ASSERT_C(TryParseFloatFeatureValue(stringValue, &value), stringValue);
+            float genericValue = 0.0f;
+            UNIT_ASSERT(TryFromString<float>(stringValue, genericValue));
+            UNIT_ASSERT_VALUES_EQUAL_C(GetBits(value), GetBits(genericValue), stringValue);
+        }
+    }
+
+    Y_UNIT_TEST(NonDecimalValues) {
+        for (auto stringValue : {
+            "", "-", "+", ".", ".5", "-.5", "5.", "inf", "-inf", "Inf", "nan", "NaN", "-nan",
+            "NA", "None", "abc", "1.2.3", " 1", "1 ", "0x10", "1,5"
+        }) {
+            CheckSameAsGenericParser(stringValue, /*expectFastPath*/ false);
+        }
+
+        float value = 0.0f;
+        UNIT_ASSERT(TryParseFloatFeatureValue("inf", &value));
+        UNIT_ASSERT(IsInf(value) && (value > 0.0f));
+        UNIT_ASSERT(TryParseFloatFeatureValue("-inf", &value));
+        UNIT_ASSERT(IsInf(value) && (value < 0.0f));
+        for (auto stringValue : {"", "-", "nan", "NaN", "-nan", "NA", "None"}) {
+            value = 0.0f;
+            UNIT_ASSERT_C(TryParseFloatFeatureValue(stringValue, &value), stringValue);
+            UNIT_ASSERT_C(IsNan(value), stringValue);
+        }
+        UNIT_ASSERT(!TryParseFloatFeatureValue("abc", &value));
+        UNIT_ASSERT(!TryParseFloatFeatureValue("1.2.3", &value));
+
+        // negative zeros are normalized by the feature value parser
+        UNIT_ASSERT(TryParseFloatFeatureValue("-0.0", &value));
+        UNIT_ASSERT_VALUES_EQUAL(GetBits(value), GetBits(0.0f));
+    }
+
+    Y_UNIT_TEST(RoundingAtFloatPrecision) {
+        for (auto stringValue : {
+            "0.1", "0.2", "0.3", "-0.7", "3.14159265358979", "2.71828182845904",
+            "16777216", "16777217", "16777218", "16777219", "16777217.5",
+            "1.00000005960464", "1.00000005960465", "0.333333333333333",
+            "34028234663852.9", "1.4e-21", "123456789012345e7", "9.99999999999999e22"
+        }) {
+            CheckSameAsGenericParser(stringValue, /*expectFastPath*/ true);
+        }
+        float value = 0.0f;
+        UNIT_ASSERT(TryParseSimpleDecimal("16777217", &value));
+        UNIT_ASSERT_VALUES_EQUAL(value, 16777216.0f);
+    }
+}
@@ -0,0 +1,267 @@
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/data/objects.h>
+#include <catboost/libs/helpers/resource_holder.h>
+#include <catboost/private/libs/quantization_schema/schema.h>
+
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
+#include <library/unittest/registar.h>
+
+#include <cstring>
+
+
+using namespace NCB;
+
+
+Y_UNIT_TEST_SUITE(TQuantizedFeaturesDataProviderBuilder) {
+
+    struct TSrcFeature {
+        bool IsCategorical;
+        ui8 BitsPerKey;
+        TVector<ui32> Values; // [objectIdx]
+    };
+
+    // object count is a multiple of 8 so storage of any bit width has no padding to compare
+    constexpr ui32 OBJECT_COUNT = 24;
+
+    static TVector<TSrcFeature> MakeSrcFeatures() {
+        TVector<TSrcFeature> features = {
+            TSrcFeature{false, 8, {}},
+            TSrcFeature{false, 16, {}},
+            TSrcFeature{true, 16, {}},
+            TSrcFeature{true, 32, {}}
+        };
+        for (auto objectIdx : xrange(OBJECT_COUNT)) {
+            features[0].Values.push_back(objectIdx % 4);
+            features[1].Values.push_back((objectIdx * 37) % 301);
+            features[2].Values.push_back((objectIdx * 13) % 300);
+            features[3].Values.push_back((objectIdx * 2731) % 65537);
+        }
+        return features;
+    }
+
+    static TPoolQuantizationSchema MakeQuantizationSchema() {
+        TPoolQuantizationSchema schema;
+
+        schema.FeatureIndices = {0, 1};
+        schema.Borders = {{0.1f, 0.2f, 0.3f}, {}};
+        for (auto i : xrange(300)) {
+            schema.Borders[1].push_back(float(i));
+        }
+        schema.NanModes = {ENanMode::Forbidden, ENanMode::Forbidden};
+
+        schema.CatFeatureIndices = {2, 3};
+        schema.FeaturesPerfectHash.resize(2);
+        for (auto bin : xrange<ui32>(300)) {
+            schema.FeaturesPerfectHash[0][bin * 7 + 1] = TValueWithCount{bin, 1};
+        }
+        for (auto bin : xrange<ui32>(65537)) {
+            schema.FeaturesPerfectHash[1][bin * 3 + 1] = TValueWithCount{bin, 1};
+        }
+        return schema;
+    }
+
+    static TVector<ui8> SerializeValues(const TSrcFeature& feature, ui32 objectOffset, ui32 objectCount) {
+        const size_t bytesPerKey = feature.BitsPerKey / CHAR_BIT;
+        TVector<ui8> result(objectCount * bytesPerKey);
+        for (auto i : xrange(objectCount)) {
+            const ui32 value = feature.Values[objectOffset + i];
+            switch (feature.BitsPerKey) {
+                case 8: {
+                    const ui8 dst = value;
+                    memcpy(result.data() + i * bytesPerKey, &dst, bytesPerKey);
+                    break;
+                }
+                case 16: {
+                    const ui16 dst = value;
+                    memcpy(result.data() + i * bytesPerKey, &dst, bytesPerKey);
+                    break;
+                }
+                default:
+                    memcpy(result.data() + i * bytesPerKey, &value, bytesPerKey);
+            }
+        }
+        return result;
+    }
+
+    /* if chunkSize == 0 pass each feature as a single owning aligned part (that can be referenced),
+     * otherwise pass non-owning parts of chunkSize objects (that have to be copied)
+     */
+    static TDataProviderPtr BuildDataProvider(
+        const TVector<TSrcFeature>& features,
+        ui32 chunkSize,
+        TVector<const ui8*>* ownedFeatureData // [featureIdx], filled only if chunkSize == 0
+    ) {
+        NPar::TLocalExecutor localExecutor;
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {
+            {EColumn::Num, "f0"},
+            {EColumn::Num, "f1"},
+            {EColumn::Categ, "c2"},
+            {EColumn::Categ, "c3"},
+            {EColumn::Label, ""}
+        };
+        TVector<TString> featureId = {"f0", "f1", "c2", "c3"};
+        const TDataMetaInfo metaInfo(
+            std::move(dataColumnsMetaInfo),
+            /*hasAdditionalGroupWeight*/ false,
+            /*hasPairs*/ false,
+            /*additionalBaselineCount*/ Nothing(),
+            &featureId
+        );
+
+        THolder<IDataProviderBuilder> dataProviderBuilder = CreateDataProviderBuilder(
+            EDatasetVisitorType::QuantizedFeatures,
+            TDataProviderBuilderOptions{},
+            TDatasetSubset::MakeColumns(),
+            &localExecutor
+        );
+        auto* visitor = dynamic_cast<IQuantizedFeaturesDataVisitor*>(dataProviderBuilder.Get());
+        UNIT_ASSERT(visitor);
+
+        visitor->Start(
+            metaInfo,
+            OBJECT_COUNT,
+            EObjectsOrder::Undefined,
+            /*resourceHolders*/ {},
+            MakeQuantizationSchema()
+        );
+
+        TVector<ui8> chunkData;
+        for (auto featureIdx : xrange<ui32>(features.size())) {
+            const auto& feature = features[featureIdx];
+            auto addPart = [&] (ui32 objectOffset, TMaybeOwningConstArrayHolder<ui8> part) {
+                if (feature.IsCategorical) {
+                    visitor->AddCatFeaturePart(featureIdx, objectOffset, feature.BitsPerKey, std::move(part));
+                } else {
+                    visitor->AddFloatFeaturePart(featureIdx, objectOffset, feature.BitsPerKey, std::move(part));
+                }
+            };
+
+            if (chunkSize == 0) {
+                const auto bytes = SerializeValues(feature, 0, OBJECT_COUNT);
+                auto holder = MakeIntrusive<TVectorHolder<ui64>>(
+                    TVector<ui64>(CeilDiv(bytes.size(), sizeof(ui64)), 0)
+                );
+                memcpy(holder->Data.data(), bytes.data(), bytes.size());
+                const auto* data = reinterpret_cast<const ui8*>(holder->Data.data());
+                ownedFeatureData->push_back(data);
+                addPart(
+                    0,
+                    TMaybeOwningConstArrayHolder<ui8>::CreateOwning(
+                        TConstArrayRef<ui8>(data, bytes.size()),
+                        std::move(holder)
+                    )
+                );
+            } else {
+                for (ui32 objectOffset = 0; objectOffset < OBJECT_COUNT; objectOffset += chunkSize) {
+                    chunkData = SerializeValues(
+                        feature,
+                        objectOffset,
+                        Min(chunkSize, OBJECT_COUNT - objectOffset)
+                    );
+                    addPart(
+                        objectOffset,
+                        TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(chunkData)
+                    );
+                }
+            }
+        }
+
+        TVector<float> target(OBJECT_COUNT, 0.0f);
+        visitor->AddTargetPart(0, TUnalignedArrayBuf<float>(target.data(), target.size() * sizeof(float)));
+
+        visitor->Finish();
+        return dataProviderBuilder->GetResult();
+    }
+
+    static const TCompressedArray& GetFeatureData(
+        const TQuantizedForCPUObjectsDataProvider& objectsData,
+        const TSrcFeature& feature,
+        ui32 perTypeFeatureIdx
+    ) {
+        if (feature.IsCategorical) {
+            const auto* holder = dynamic_cast<const TQuantizedCatValuesHolder*>(
+                *objectsData.GetNonPackedCatFeature(perTypeFeatureIdx)
+            );
+            UNIT_ASSERT(holder);
+            return *holder->GetCompressedData().GetSrc();
+        }
+        const auto* holder = dynamic_cast<const TQuantizedFloatValuesHolder*>(
+            *objectsData.GetNonPackedFloatFeature(perTypeFeatureIdx)
+        );
+        UNIT_ASSERT(holder);
+        return *holder->GetCompressedData().GetSrc();
+    }
+
+    static void CheckFeatures(
+        const TVector<TSrcFeature>& features,
+        const TDataProviderPtr& dataProvider,
+        TConstArrayRef<const ui8*> ownedFeatureData, // if not empty check that this data has been referenced
+        TVector<const TCompressedArray*>* featuresData
+    ) {
+        const auto* objectsData = dynamic_cast<const TQuantizedForCPUObjectsDataProvider*>(
+            dataProvider->ObjectsData.Get()
+        );
+        UNIT_ASSERT(objectsData);
+
+        ui32 floatFeatureIdx = 0;
+        ui32 catFeatureIdx = 0;
+        for (auto featureIdx : xrange(features.size())) {
+            const auto& feature = features[featureIdx];
+            const auto& featureData = GetFeatureData(
+                *objectsData,
+                feature,
+                feature.IsCategorical ? catFeatureIdx++ : floatFeatureIdx++
+            );
+            UNIT_ASSERT_VALUES_EQUAL(featureData.GetBitsPerKey(), feature.BitsPerKey);
+            UNIT_ASSERT(featureData == TConstArrayRef<ui32>(feature.Values));
+            if (!ownedFeatureData.empty()) {
+                UNIT_ASSERT_EQUAL(
+                    (const void*)featureData.GetRawPtr(),
+                    (const void*)ownedFeatureData[featureIdx]
+                );
+            }
+            featuresData->push_back(&featureData);
+        }
+    }
+
+    Y_UNIT_TEST(ReferencedColumnsAreEqualToCopied) {
+        const auto features = MakeSrcFeatures();
+
+        TVector<const ui8*> ownedFeatureData;
+        const auto referencedDataProvider = BuildDataProvider(features, /*chunkSize*/ 0, &ownedFeatureData);
+        const auto copiedDataProvider = BuildDataProvider(features, /*chunkSize*/ OBJECT_COUNT, nullptr);
+
+        TVector<const TCompressedArray*> referencedFeaturesData;
+        CheckFeatures(features, referencedDataProvider, ownedFeatureData, &referencedFeaturesData);
+
+        TVector<const TCompressedArray*> copiedFeaturesData;
+        CheckFeatures(features, copiedDataProvider, {}, &copiedFeaturesData);
+
+        for (auto featureIdx : xrange(features.size())) {
+            UNIT_ASSERT(referencedFeaturesData[featureIdx]->EqualTo(*copiedFeaturesData[featureIdx]));
+        }
+    }
+
+    Y_UNIT_TEST(WideFeaturesInSeveralChunks) {
+        const auto features = MakeSrcFeatures();
+
+        TVector<const TCompressedArray*> singleChunkFeaturesData;
+        const auto singleChunkDataProvider = BuildDataProvider(features, /*chunkSize*/ OBJECT_COUNT, nullptr);
+        CheckFeatures(features, singleChunkDataProvider, {}, &singleChunkFeaturesData);
+
+        // chunks of uneven size, the last one is incomplete
+        for (ui32 chunkSize : {1, 5, 8, 13}) {
+            TVector<const TCompressedArray*> featuresData;
+            const auto dataProvider = BuildDataProvider(features, chunkSize, nullptr);
+            CheckFeatures(features, dataProvider, {}, &featuresData);
+
+            for (auto featureIdx : xrange(features.size())) {
+                UNIT_ASSERT(featuresData[featureIdx]->EqualTo(*singleChunkFeaturesData[featureIdx]));
+            }
+        }
+    }
+}
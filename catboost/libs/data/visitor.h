@@ -230,6 +230,10 @@ namespace NCB {
 
         /* shared ownership is passed to Start in resourceHolders to avoid creating resource holder
          * for each such call
+         *
+         * If featuresPart is owning, contains data for all objects and is aligned for ui64 access
+         * the builder can use it as feature storage without copying. In that case data must be readable
+         * and zero-padded up to the next ui64 boundary after the end of featuresPart.
          */
         virtual void AddFloatFeaturePart(
             ui32 flatFeatureIdx,
@@ -23,6 +23,7 @@
 #include <util/generic/algorithm.h>
 #include <util/generic/hash.h>
 #include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/string/builder.h>
 #include <util/string/cast.h>
 #include <util/system/compiler.h>
@@ -250,9 +251,144 @@ static bool TryGetObjectiveMetric(const TFullModel& model, NCatboostOptions::TLo
     return TryGetLossDescription(model, lossDescription);
 }
 
+static constexpr ui32 MAX_LOSS_CHANGE_PART_DOCUMENT_COUNT = 200000;
+
+/* Adds metric stats on dataset to scores: scores[featureIdx] - with featureIdx contribution removed from approxes,
+ * scores.back() - for the original approxes.
+ * Blocks of objects are processed in parallel, a block in process holds only its own SHAP values and a copy
+ * of its approxes that is modified in place for one feature at a time.
+ */
+static void AddLossChangeScores(
+    const TFullModel& model,
+    const TDataProvider& dataset,
+    const TShapPreparedTrees& preparedTrees,
+    const NCatboostOptions::TLossDescription& metricDescription,
+    const NCatboostOptions::TLossDescription& lossDescription,
+    bool needYetiRankPairs,
+    const IMetric& metric,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TMetricHolder>* scores)
+{
+    const int featuresCount = scores->ysize() - 1;
+    const int approxDimension = model.ObliviousTrees->GetDimensionsCount();
+    const ui32 documentCount = dataset.ObjectsData->GetObjectCount();
+    const TObjectsDataProvider& objectsData = *dataset.ObjectsData;
+
+    TRestorableFastRng64 rand(0);
+    auto targetData = CreateModelCompatibleProcessedDataProvider(dataset, {metricDescription}, model, GetMonopolisticFreeCpuRam(), &rand, localExecutor).TargetData;
+
+    TConstArrayRef<TQueryInfo> targetQueriesInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
+    const TConstArrayRef<float> target = targetData->GetTarget().GetOrElse(TConstArrayRef<float>());
+    const TConstArrayRef<float> weights = GetWeights(*targetData);
+    const TVector<TVector<double>> approx = ApplyModelMulti(model, objectsData, EPredictionType::RawFormulaVal, 0, 0,
+                                                            localExecutor);
+    TVector<TQueryInfo> queriesInfo(targetQueriesInfo.begin(), targetQueriesInfo.end());
+
+    const ui32 unitCount = queriesInfo.empty() ? documentCount : queriesInfo.size();
+    ui32 blockSize = Min(ui32(10000), ui32(1e6) / (featuresCount * approxDimension)); // shapValues[blockSize][featuresCount][dim] double
+    if (needYetiRankPairs) {
+        ui32 maxQuerySize = 0;
+        for (const auto& query : queriesInfo) {
+            maxQuerySize = Max(maxQuerySize, query.GetSize());
+        }
+        blockSize = Min(blockSize, ui32(ceil(20000. / maxQuerySize)));
+    }
+    blockSize = Max(blockSize, ui32(1));
+    const ui32 blockCount = CeilDiv(unitCount, blockSize);
+
+    TVector<TVector<TMetricHolder>> blockScores(blockCount); // [blockIdx][featureIdx], original approxes are the last
+    localExecutor->ExecRangeWithThrow(
+        [&](int blockIdx) {
+            const ui32 queryBegin = blockIdx * blockSize;
+            const ui32 queryEnd = Min(unitCount, queryBegin + blockSize);
+            ui32 begin, end;
+            if (queriesInfo.empty()) {
+                begin = queryBegin;
+                end = queryEnd;
+            } else {
+                begin = queriesInfo[queryBegin].Begin;
+                end = queriesInfo[queryEnd - 1].End;
+            }
+            if (needYetiRankPairs) {
+                UpdatePairsForYetiRank(
+                    approx[0],
+                    target,
+                    lossDescription,
+                    /*randomSeed*/ 0,
+                    queryBegin,
+                    queryEnd,
+                    &queriesInfo,
+                    localExecutor
+                );
+            }
+            TVector<TVector<TVector<double>>> shapValues;
+            CalcShapValuesInternalForFeature(
+                preparedTrees,
+                model,
+                0,
+                begin,
+                end,
+                featuresCount,
+                objectsData,
+                &shapValues,
+                localExecutor);
+
+            // block data is rebased to start from 0
+            const TConstArrayRef<float> blockTarget = target.empty() ? target : target.Slice(begin, end - begin);
+            const TConstArrayRef<float> blockWeights = weights.empty() ? weights : weights.Slice(begin, end - begin);
+            TVector<TQueryInfo> blockQueriesInfo;
+            if (!queriesInfo.empty()) {
+                blockQueriesInfo.assign(queriesInfo.begin() + queryBegin, queriesInfo.begin() + queryEnd);
+                for (auto& queryInfo : blockQueriesInfo) {
+                    queryInfo.Begin -= begin;
+                    queryInfo.End -= begin;
+                }
+            }
+            const int blockMetricEnd = queriesInfo.empty() ? (end - begin) : (queryEnd - queryBegin);
+            TVector<TVector<double>> blockApprox(approxDimension);
+            for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
+                blockApprox[dimensionIdx].assign(approx[dimensionIdx].begin() + begin, approx[dimensionIdx].begin() + end);
+            }
+
+            auto& featureScores = blockScores[blockIdx];
+            featureScores.resize(featuresCount + 1);
+            featureScores.back() = metric.Eval(blockApprox, blockTarget, blockWeights, blockQueriesInfo, 0, blockMetricEnd, *localExecutor);
+            for (int featureIdx = 0; featureIdx < featuresCount; ++featureIdx) {
+                for (ui32 docIdx = 0; docIdx < end - begin; ++docIdx) {
+                    for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
+                        blockApprox[dimensionIdx][docIdx] -= shapValues[docIdx][featureIdx][dimensionIdx];
+                    }
+                }
+                featureScores[featureIdx] = metric.Eval(blockApprox, blockTarget, blockWeights, blockQueriesInfo, 0, blockMetricEnd, *localExecutor);
+                for (ui32 docIdx = 0; docIdx < end - begin; ++docIdx) {
+                    for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
+                        blockApprox[dimensionIdx][docIdx] += shapValues[docIdx][featureIdx][dimensionIdx];
+                    }
+                }
+            }
+            if (needYetiRankPairs) {
+                for (ui32 queryIndex = queryBegin; queryIndex < queryEnd; ++queryIndex) {
+                    queriesInfo[queryIndex].Competitors.clear();
+                    queriesInfo[queryIndex].Competitors.shrink_to_fit();
+                }
+            }
+        },
+        0,
+        blockCount,
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+    // merged in the block order for the result not to depend on the thread scheduling
+    for (const auto& featureScores : blockScores) {
+        for (int featureIdx = 0; featureIdx <= featuresCount; ++featureIdx) {
+            (*scores)[featureIdx].Add(featureScores[featureIdx]);
+        }
+    }
+}
+
 static TVector<std::pair<double, TFeature>> CalcFeatureEffectLossChange(
         const TFullModel& model,
         const TDataProvider& dataProvider,
+        bool useFullDataset,
         NPar::TLocalExecutor* localExecutor)
 {
     NCatboostOptions::TLossDescription metricDescription;
@@ -267,114 +403,80 @@ static TVector<std::pair<double, TFeature>> CalcFeatureEffectLossChange(
         return result;
     }
 
-    ui32 totalDocumentCount = dataProvider.ObjectsData->GetObjectCount();
-    ui32 maxDocuments = Min(totalDocumentCount, Max(ui32(2e5), ui32(2e9 / dataProvider.ObjectsData->GetFeaturesLayout()->GetExternalFeatureCount())));
-
-    const auto dataset = GetSubset(dataProvider, maxDocuments, localExecutor);
-
-    ui32 documentCount = dataset.ObjectsData->GetObjectCount();
-    const TObjectsDataProvider& objectsData = *dataset.ObjectsData;
-
-    CATBOOST_INFO_LOG << "Selected " << documentCount << " documents from " << totalDocumentCount << " for LossFunctionChange calculation." << Endl;
-
-    TRestorableFastRng64 rand(0);
-    auto targetData = CreateModelCompatibleProcessedDataProvider(dataset, {metricDescription}, model, GetMonopolisticFreeCpuRam(), &rand, localExecutor).TargetData;
-    TShapPreparedTrees preparedTrees = PrepareTrees(model, &dataset, 0, EPreCalcShapValues::Auto, localExecutor, true);
-
-    TVector<TMetricHolder> scores(featuresCount + 1);
-
-    TConstArrayRef<TQueryInfo> targetQueriesInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
-    TVector<TVector<double>> approx = ApplyModelMulti(model, objectsData, EPredictionType::RawFormulaVal, 0, 0,
-                                                      localExecutor);
-    TVector<TQueryInfo> queriesInfo(targetQueriesInfo.begin(), targetQueriesInfo.end());
-
-    ui32 blockCount = queriesInfo.empty() ? documentCount : queriesInfo.size();
-    ui32 blockSize = Min(ui32(10000), ui32(1e6) / (featuresCount * approx.ysize())); // shapValues[blockSize][featuresCount][dim] double
-
     NCatboostOptions::TLossDescription lossDescription;
     CB_ENSURE(TryGetLossDescription(model, lossDescription), "No loss_function in model params");
 
     // NDCG and PFound metrics are possible for YetiRank
     // PFound replace with PairLogit (with YetiRank generated pairs) due to quality
     // NDCG used for labels not in [0., 1.] and don't use YetiRank pairs
-    bool needYetiRankPairs = IsYetiRankLossFunction(lossDescription.GetLossFunction())
-                             && metricDescription.LossFunction != ELossFunction::NDCG;
-    if (needYetiRankPairs) {
-        metricDescription = NCatboostOptions::ParseLossDescription("PairLogit");
-        ui32 maxQuerySize = 0;
-        for (const auto& query : queriesInfo) {
-            maxQuerySize = Max(maxQuerySize, query.GetSize());
-        }
-        blockSize = Min(blockSize, ui32(ceil(20000. / maxQuerySize)));
-    }
-    THolder<IMetric> metric = std::move(CreateMetricFromDescription(metricDescription, approxDimension)[0]);
+    const bool needYetiRankPairs = IsYetiRankLossFunction(lossDescription.GetLossFunction())
+                                   && metricDescription.LossFunction != ELossFunction::NDCG;
+    const auto evalMetricDescription = needYetiRankPairs ?
+        NCatboostOptions::ParseLossDescription("PairLogit") :
+        metricDescription;
+    THolder<IMetric> metric = std::move(CreateMetricFromDescription(evalMetricDescription, approxDimension)[0]);
     CB_ENSURE(metric->IsAdditiveMetric(), "LossFunctionChange support only additive metric");
 
-    TProfileInfo profile(documentCount);
-    TImportanceLogger importanceLogger(documentCount, "Process documents", "Started LossFunctionChange calculation", 1);
-    for (ui32 queryBegin = 0; queryBegin < blockCount; queryBegin += blockSize) {
-        profile.StartIterationBlock();
-        ui32 queryEnd = Min(blockCount, queryBegin + blockSize);
-        ui32 begin, end;
-        if (queriesInfo.empty()) {
-            begin = queryBegin;
-            end = queryEnd;
-        } else {
-            begin = queriesInfo[queryBegin].Begin;
-            end = queriesInfo[queryEnd - 1].End;
-        }
-        if (needYetiRankPairs) {
-            UpdatePairsForYetiRank(
-                approx[0],
-                *targetData->GetTarget(),
+    const ui32 totalDocumentCount = dataProvider.ObjectsData->GetObjectCount();
+    CB_ENSURE(totalDocumentCount > 0, "no docs in pool");
+
+    TVector<TMetricHolder> scores(featuresCount + 1);
+    if (useFullDataset) {
+        // the whole dataset is streamed in parts, only one part has its target data and approxes in memory
+        TShapPreparedTrees preparedTrees = PrepareTrees(model, &dataProvider, 0, EPreCalcShapValues::Auto, localExecutor, true);
+        const ui32 partCount = CeilDiv(totalDocumentCount, MAX_LOSS_CHANGE_PART_DOCUMENT_COUNT);
+        CATBOOST_INFO_LOG << "Selected all " << totalDocumentCount << " documents in " << partCount
+            << " parts for LossFunctionChange calculation." << Endl;
+
+        TProfileInfo profile(totalDocumentCount);
+        TImportanceLogger importanceLogger(totalDocumentCount, "Process documents", "Started LossFunctionChange calculation", 1);
+        TVector<TArraySubsetIndexing<ui32>> parts = NCB::Split(*dataProvider.ObjectsGrouping, partCount);
+        for (auto& part : parts) {
+            profile.StartIterationBlock();
+            TDataProviderPtr partDataset;
+            if (partCount > 1) {
+                partDataset = dataProvider.GetSubset(
+                    GetSubset(dataProvider.ObjectsGrouping, std::move(part), NCB::EObjectsOrder::Ordered),
+                    NSystemInfo::TotalMemorySize(),
+                    localExecutor);
+            }
+            const TDataProvider& dataset = partDataset ? *partDataset : dataProvider;
+            AddLossChangeScores(
+                model,
+                dataset,
+                preparedTrees,
+                metricDescription,
                 lossDescription,
-                /*randomSeed*/ 0,
-                queryBegin,
-                queryEnd,
-                &queriesInfo,
-                localExecutor
-            );
+                needYetiRankPairs,
+                *metric,
+                localExecutor,
+                &scores);
+            profile.FinishIterationBlock(dataset.ObjectsData->GetObjectCount());
+            importanceLogger.Log(profile.GetProfileResults());
         }
-        scores.back().Add(
-            metric->Eval(approx, targetData->GetTarget().GetOrElse(TConstArrayRef<float>()), GetWeights(*targetData), queriesInfo, queryBegin, queryEnd, *localExecutor)
-        );
-        TVector<TVector<TVector<double>>> shapValues;
-        CalcShapValuesInternalForFeature(
-            preparedTrees,
+    } else {
+        const ui32 maxDocuments = Min(
+            totalDocumentCount,
+            Max(ui32(2e5), ui32(2e9 / dataProvider.ObjectsData->GetFeaturesLayout()->GetExternalFeatureCount())));
+        const auto dataset = GetSubset(dataProvider, maxDocuments, localExecutor);
+        const ui32 documentCount = dataset.ObjectsData->GetObjectCount();
+        CATBOOST_INFO_LOG << "Selected " << documentCount << " documents from " << totalDocumentCount << " for LossFunctionChange calculation." << Endl;
+
+        TShapPreparedTrees preparedTrees = PrepareTrees(model, &dataset, 0, EPreCalcShapValues::Auto, localExecutor, true);
+        TProfileInfo profile(documentCount);
+        TImportanceLogger importanceLogger(documentCount, "Process documents", "Started LossFunctionChange calculation", 1);
+        profile.StartIterationBlock();
+        AddLossChangeScores(
             model,
-            0,
-            begin,
-            end,
-            featuresCount,
-            objectsData,
-            &shapValues,
-            localExecutor);
-
-        for (int featureIdx = 0; featureIdx < featuresCount; ++featureIdx) {
-            NPar::TLocalExecutor::TExecRangeParams blockParams(begin, end);
-            blockParams.SetBlockCountToThreadCount();
-            localExecutor->ExecRange([&](ui32 docIdx) {
-                for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
-                    approx[dimensionIdx][docIdx] -= shapValues[docIdx - begin][featureIdx][dimensionIdx];
-                }
-            }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
-            scores[featureIdx].Add(
-                    metric->Eval(approx, targetData->GetTarget().GetOrElse(TConstArrayRef<float>()), GetWeights(*targetData), queriesInfo, queryBegin, queryEnd,
-                                 *localExecutor)
-            );
-            localExecutor->ExecRange([&](ui32 docIdx) {
-                for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
-                    approx[dimensionIdx][docIdx] += shapValues[docIdx - begin][featureIdx][dimensionIdx];
-                }
-            }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
-        }
-        if (needYetiRankPairs) {
-            for (ui32 queryIndex = queryBegin; queryIndex < queryEnd; ++queryIndex) {
-                queriesInfo[queryIndex].Competitors.clear();
-                queriesInfo[queryIndex].Competitors.shrink_to_fit();
-            }
-        }
-        profile.FinishIterationBlock(end - begin);
+            dataset,
+            preparedTrees,
+            metricDescription,
+            lossDescription,
+            needYetiRankPairs,
+            *metric,
+            localExecutor,
+            &scores);
+        profile.FinishIterationBlock(documentCount);
         importanceLogger.Log(profile.GetProfileResults());
     }
 
@@ -414,12 +516,13 @@ TVector<std::pair<double, TFeature>> CalcFeatureEffect(
         const TFullModel& model,
         const TDataProviderPtr dataset,
         EFstrType type,
-        NPar::TLocalExecutor* localExecutor)
+        NPar::TLocalExecutor* localExecutor,
+        bool useFullDataset)
 {
     type = GetFeatureImportanceType(model, bool(dataset), type);
     if (type == EFstrType::LossFunctionChange) {
         CB_ENSURE(dataset, "dataset is not provided");
-        return CalcFeatureEffectLossChange(model, *dataset.Get(), localExecutor);
+        return CalcFeatureEffectLossChange(model, *dataset.Get(), useFullDataset, localExecutor);
     } else {
         return CalcFeatureEffectAverageChange(model, dataset, localExecutor);
     }
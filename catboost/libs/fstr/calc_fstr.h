@@ -68,11 +68,16 @@ public:
     {}
 };
 
+/*
+ * useFullDataset affects LossFunctionChange only: by default it is calculated on a subset of the dataset
+ * (with size limited depending on feature count), if true, all documents are processed by bounded-size blocks
+ */
 TVector<std::pair<double, TFeature>> CalcFeatureEffect(
     const TFullModel& model,
     const NCB::TDataProviderPtr dataset, // can be nullptr
     EFstrType type,
-    NPar::TLocalExecutor* localExecutor);
+    NPar::TLocalExecutor* localExecutor,
+    bool useFullDataset = false);
 
 TVector<TFeatureEffect> CalcRegularFeatureEffect(
     const TVector<std::pair<double, TFeature>>& effect,
@@ -85,7 +85,8 @@ inline void CalcAndOutputFstr(const TFullModel& model,
                               NPar::TLocalExecutor* localExecutor,
                               const TString* regularFstrPath,
                               const TString* internalFstrPath,
-                              EFstrType type) {
+                              EFstrType type,
+                              bool useFullDataset = false) {
     const NCB::TFeaturesLayout layout(
         TVector<TFloatFeature>(
             model.ObliviousTrees->GetFloatFeatures().begin(),
@@ -97,7 +98,12 @@ inline void CalcAndOutputFstr(const TFullModel& model,
         )
     );
 
-    TVector<std::pair<double, TFeature>> internalEffect = CalcFeatureEffect(model, dataset, type, localExecutor);
+    TVector<std::pair<double, TFeature>> internalEffect = CalcFeatureEffect(
+        model,
+        dataset,
+        type,
+        localExecutor,
+        useFullDataset);
     if (internalFstrPath != nullptr && !internalFstrPath->empty()) {
         OutputFstr(layout, internalEffect, *internalFstrPath);
     }
@@ -569,7 +569,7 @@ static TVector<bool> GetDocumentPathToLeafForNonObliviousBlock(
 ) {
     const ui8* binFeatures = block.QuantizedData.data();
     const size_t docCountInBlock = block.ObjectsCount;
-    const TRepackedBin* treeSplitsPtr = forest.GetRepackedBins().data();
+    const TRepackedBin* treeSplitsPtr = NCB::NModelEvaluation::GetRepackedBins(forest, &block).data();
     const auto firstLeafOffsets = forest.GetFirstLeafOffsets();
     const int totalNodesCount = forest.GetTreeSplits().size();
     const bool isLastTree = static_cast<size_t>(treeIdx + 1) == forest.GetTreeStartOffsets().size();
@@ -577,10 +577,8 @@ static TVector<bool> GetDocumentPathToLeafForNonObliviousBlock(
     TVector<bool> mapNodeIdToIsGoRight;
     for (NCB::NModelEvaluation::TCalcerIndexType nodeIdx = forest.GetTreeStartOffsets()[treeIdx]; nodeIdx < endOffset; ++nodeIdx) {
         const TRepackedBin split = treeSplitsPtr[nodeIdx];
-        ui8 featureValue = binFeatures[split.FeatureIndex * docCountInBlock + docIdx];
-        if (!forest.GetOneHotFeatures().empty()) {
-            featureValue ^= split.XorMask;
-        }
+        // mask is zero for ordinary float and ctr splits
+        const ui8 featureValue = binFeatures[split.FeatureIndex * docCountInBlock + docIdx] ^ split.XorMask;
         mapNodeIdToIsGoRight.push_back(featureValue >= split.SplitIdx);
     }
     return mapNodeIdToIsGoRight;
@@ -0,0 +1,28 @@
+#include "sequential_test.h"
+
+#include "exception.h"
+
+#include <cmath>
+
+
+TSequentialSignTest::TSequentialSignTest(double significance, double winProbability)
+    : LogLikelihoodRatioStep(std::log(winProbability / (1 - winProbability)))
+    , LogLikelihoodRatioBound(std::log((1 - significance) / significance))
+{
+    CB_ENSURE(0 < significance && significance < 0.5, "Significance should be in (0, 0.5)");
+    CB_ENSURE(0.5 < winProbability && winProbability < 1, "Win probability should be in (0.5, 1)");
+}
+
+ESequentialTestVerdict TSequentialSignTest::AddOutcome(bool isTestedWinner) {
+    if (Verdict != ESequentialTestVerdict::Undecided) {
+        return Verdict;
+    }
+    ++OutcomeCount;
+    LogLikelihoodRatio += isTestedWinner ? LogLikelihoodRatioStep : -LogLikelihoodRatioStep;
+    if (LogLikelihoodRatio >= LogLikelihoodRatioBound) {
+        Verdict = ESequentialTestVerdict::Better;
+    } else if (LogLikelihoodRatio <= -LogLikelihoodRatioBound) {
+        Verdict = ESequentialTestVerdict::Worse;
+    }
+    return Verdict;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <util/system/types.h>
+
+
+enum class ESequentialTestVerdict {
+    Undecided,
+    Better,
+    Worse
+};
+
+/*
+ * Wald's sequential probability ratio test on outcomes of paired comparisons of tested and baseline.
+ * Hypotheses are "tested wins a comparison with probability WinProbability" (Better)
+ * and "tested wins with probability 1 - WinProbability" (Worse),
+ * probability to accept the wrong one is bounded by Significance.
+ * Once a verdict is reached it doesn't change.
+ */
+class TSequentialSignTest {
+public:
+    TSequentialSignTest(double significance, double winProbability);
+
+    // ties should be skipped by the caller
+    ESequentialTestVerdict AddOutcome(bool isTestedWinner);
+
+    ESequentialTestVerdict GetVerdict() const {
+        return Verdict;
+    }
+
+    ui32 GetOutcomeCount() const {
+        return OutcomeCount;
+    }
+
+private:
+    double LogLikelihoodRatioStep;
+    double LogLikelihoodRatioBound;
+
+    double LogLikelihoodRatio = 0;
+    ui32 OutcomeCount = 0;
+    ESequentialTestVerdict Verdict = ESequentialTestVerdict::Undecided;
+};
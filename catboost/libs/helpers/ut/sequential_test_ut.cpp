@@ -0,0 +1,41 @@
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/sequential_test.h>
+
+#include <library/unittest/registar.h>
+
+
+Y_UNIT_TEST_SUITE(TSequentialSignTestTest) {
+    Y_UNIT_TEST(TestVerdicts) {
+        // log(0.75 / 0.25) per outcome, bound log(0.95 / 0.05): three net wins or losses are needed
+        {
+            TSequentialSignTest test(0.05, 0.75);
+            UNIT_ASSERT_EQUAL(test.AddOutcome(true), ESequentialTestVerdict::Undecided);
+            UNIT_ASSERT_EQUAL(test.AddOutcome(false), ESequentialTestVerdict::Undecided);
+            UNIT_ASSERT_EQUAL(test.AddOutcome(true), ESequentialTestVerdict::Undecided);
+            UNIT_ASSERT_EQUAL(test.AddOutcome(true), ESequentialTestVerdict::Undecided);
+            UNIT_ASSERT_EQUAL(test.AddOutcome(true), ESequentialTestVerdict::Better);
+            UNIT_ASSERT_VALUES_EQUAL(test.GetOutcomeCount(), 5);
+            UNIT_ASSERT_EQUAL(test.AddOutcome(false), ESequentialTestVerdict::Better);
+            UNIT_ASSERT_VALUES_EQUAL(test.GetOutcomeCount(), 5);
+        }
+        {
+            TSequentialSignTest test(0.05, 0.75);
+            for (auto i = 0; i < 2; ++i) {
+                UNIT_ASSERT_EQUAL(test.AddOutcome(false), ESequentialTestVerdict::Undecided);
+            }
+            UNIT_ASSERT_EQUAL(test.AddOutcome(false), ESequentialTestVerdict::Worse);
+        }
+        {
+            TSequentialSignTest test(0.01, 0.75);
+            for (auto i = 0; i < 4; ++i) {
+                UNIT_ASSERT_EQUAL(test.AddOutcome(true), ESequentialTestVerdict::Undecided);
+            }
+            UNIT_ASSERT_EQUAL(test.AddOutcome(true), ESequentialTestVerdict::Better);
+        }
+    }
+
+    Y_UNIT_TEST(TestInvalidParams) {
+        UNIT_ASSERT_EXCEPTION(TSequentialSignTest(0.0, 0.75), TCatBoostException);
+        UNIT_ASSERT_EXCEPTION(TSequentialSignTest(0.05, 0.5), TCatBoostException);
+    }
+}
@@ -23,12 +23,20 @@ void TMetricsAndTimeLeftHistory::TryUpdateBestError(const IMetric& metric, doubl
     }
 }
 
-void TMetricsAndTimeLeftHistory::AddLearnError(const IMetric& metric, double error) {
+void TMetricsAndTimeLeftHistory::AddLearnError(const IMetric& metric, double error, bool isSubsampled) {
     LearnMetricsHistory.back()[metric.GetDescription()] = error;
-    TryUpdateBestError(metric, error, LearnBestError, false);
+    if (!isSubsampled) {
+        TryUpdateBestError(metric, error, LearnBestError, false);
+    }
 }
 
-void TMetricsAndTimeLeftHistory::AddTestError(size_t testIdx, const IMetric& metric, double error, bool updateBestIteration) {
+void TMetricsAndTimeLeftHistory::AddTestError(
+    size_t testIdx,
+    const IMetric& metric,
+    double error,
+    bool updateBestIteration,
+    bool isSubsampled
+) {
     if (testIdx >= TestMetricsHistory.back().size()) {
         TestMetricsHistory.back().resize(testIdx + 1);
     }
@@ -36,7 +44,9 @@ void TMetricsAndTimeLeftHistory::AddTestError(size_t testIdx, const IMetric& met
     if (testIdx >= TestBestError.size()) {
         TestBestError.resize(testIdx + 1);
     }
-    TryUpdateBestError(metric, error, TestBestError[testIdx], updateBestIteration);
+    if (!isSubsampled) {
+        TryUpdateBestError(metric, error, TestBestError[testIdx], updateBestIteration);
+    }
 }
 
 TString TOutputFiles::AlignFilePath(const TString& baseDir, const TString& fileName, const TString& namePrefix) {
@@ -34,10 +34,27 @@ struct TMetricsAndTimeLeftHistory {
     THashMap<TString, double> LearnBestError;
     TVector<THashMap<TString, double>> TestBestError;
 
-    Y_SAVELOAD_DEFINE(LearnMetricsHistory, TestMetricsHistory, TimeHistory, BestIteration, LearnBestError, TestBestError);
-
-    void AddLearnError(const IMetric& metric, double error);
-    void AddTestError(size_t testIdx, const IMetric& metric, double error, bool updateBestIteration);
+    /* [iter] true if metrics of the iteration (except the eval metric) were calculated on a subsample
+     * (see metric_sample_rate), may be shorter than metrics history, absent values are false.
+     * Subsampled values are not used for best errors.
+     */
+    TVector<bool> IsMetricsSubsampled;
+
+    Y_SAVELOAD_DEFINE(
+        LearnMetricsHistory,
+        TestMetricsHistory,
+        TimeHistory,
+        BestIteration,
+        LearnBestError,
+        TestBestError,
+        IsMetricsSubsampled
+    );
+
+    void AddLearnError(const IMetric& metric, double error, bool isSubsampled = false);
+    void AddTestError(size_t testIdx, const IMetric& metric, double error, bool updateBestIteration, bool isSubsampled = false);
+    bool IsMetricsSubsampledAt(size_t iter) const {
+        return iter < IsMetricsSubsampled.size() && IsMetricsSubsampled[iter];
+    }
 
 private:
     void TryUpdateBestError(const IMetric& metric, double error, THashMap<TString, double>& bestError, bool updateBestIteration);
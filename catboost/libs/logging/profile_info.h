@@ -2,12 +2,28 @@
 
 #include "logging.h"
 
+#include <library/chromium_trace/interface.h>
+
 #include <util/ysaveload.h>
 #include <util/generic/map.h>
 #include <util/stream/file.h>
 #include <util/stream/format.h>
+#include <util/system/defaults.h>
 #include <util/system/hp_timer.h>
 
+/* Fine-grained Chrome trace events of training stages (viewable in chrome://tracing).
+ * Events are recorded with the current thread id and only if a global trace sink is installed
+ * (see chrome_trace_log option), otherwise the guards are no-op.
+ * name must outlive the scope, args is a pointer to NChromiumTrace::TEventArgs that must outlive the scope too.
+ */
+#define CATBOOST_TRACE_SCOPE(name) \
+    ::NChromiumTrace::TCompleteEventGuard Y_GENERATE_UNIQUE_ID(catboostTraceGuard)( \
+        ::NChromiumTrace::GetGlobalTracer(), TStringBuf(name), AsStringBuf("catboost"))
+
+#define CATBOOST_TRACE_SCOPE_W_ARGS(name, args) \
+    ::NChromiumTrace::TCompleteEventGuard Y_GENERATE_UNIQUE_ID(catboostTraceGuard)( \
+        ::NChromiumTrace::GetGlobalTracer(), TStringBuf(name), AsStringBuf("catboost"), args)
+
 struct TProfileResults {
     TProfileResults(
         double passedTime,
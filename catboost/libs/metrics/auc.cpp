@@ -302,3 +302,113 @@ double CalcBinClassAuc(
     localExecutor.RunAdditionalThreads(threadCount - 1);
     return CalcBinClassAuc(positiveSamples, negativeSamples, &localExecutor);
 }
+
+// bin is the number of borders not greater than value, prevBin is checked first as approxes change little between iterations
+static ui32 GetApproxAucBin(TConstArrayRef<double> borders, double value, ui32 prevBin) {
+    const auto isInBin = [&] (ui32 bin) {
+        return (bin == 0 || borders[bin - 1] <= value) && (bin == borders.size() || value < borders[bin]);
+    };
+    if (prevBin <= borders.size()) {
+        if (isInBin(prevBin)) {
+            return prevBin;
+        }
+        if (prevBin > 0 && isInBin(prevBin - 1)) {
+            return prevBin - 1;
+        }
+        if (prevBin < borders.size() && isInBin(prevBin + 1)) {
+            return prevBin + 1;
+        }
+    }
+    return UpperBound(borders.begin(), borders.end(), value) - borders.begin();
+}
+
+TVector<double> CalcApproxAucBorders(TConstArrayRef<double> prediction, ui32 binCount) {
+    if (prediction.empty() || binCount < 2) {
+        return {};
+    }
+    const ui32 maxSampleSize = 32 * binCount;
+    const ui32 stride = Max<ui32>(1, prediction.size() / maxSampleSize);
+    TVector<double> sample;
+    sample.reserve(prediction.size() / stride + 1);
+    for (ui32 i = 0; i < prediction.size(); i += stride) {
+        sample.push_back(prediction[i]);
+    }
+    Sort(sample);
+    TVector<double> borders;
+    borders.reserve(binCount - 1);
+    for (ui32 bin = 1; bin < binCount; ++bin) {
+        const double border = sample[(ui64)bin * sample.size() / binCount];
+        if (borders.empty() || borders.back() < border) {
+            borders.push_back(border);
+        }
+    }
+    return borders;
+}
+
+double CalcApproxBinClassAuc(
+    TConstArrayRef<double> prediction,
+    TConstArrayRef<double> positiveWeight,
+    TConstArrayRef<double> negativeWeight,
+    TConstArrayRef<double> borders,
+    NPar::TLocalExecutor* localExecutor,
+    double* outErrorBound,
+    TArrayRef<ui32> bins
+) {
+    Y_ASSERT(prediction.size() == positiveWeight.size() && prediction.size() == negativeWeight.size());
+    Y_ASSERT(bins.empty() || bins.size() == prediction.size());
+    if (outErrorBound != nullptr) {
+        *outErrorBound = 0;
+    }
+    const ui32 binCount = borders.size() + 1;
+    const ui32 blockCount = Max<ui32>(1, Min<ui32>(localExecutor->GetThreadCount() + 1, prediction.size()));
+    NCB::TEqualRangesGenerator<ui32> rangesGenerator({0, (ui32)prediction.size()}, blockCount);
+    TVector<TVector<double>> positiveHistograms(blockCount, TVector<double>(binCount, 0));
+    TVector<TVector<double>> negativeHistograms(blockCount, TVector<double>(binCount, 0));
+    NPar::ParallelFor(
+        *localExecutor,
+        0,
+        blockCount,
+        [&](int blockId) {
+            auto& positiveHistogram = positiveHistograms[blockId];
+            auto& negativeHistogram = negativeHistograms[blockId];
+            for (ui32 i : rangesGenerator.GetRange(blockId).Iter()) {
+                ui32 bin;
+                if (bins.empty()) {
+                    bin = UpperBound(borders.begin(), borders.end(), prediction[i]) - borders.begin();
+                } else {
+                    bin = GetApproxAucBin(borders, prediction[i], bins[i]);
+                    bins[i] = bin;
+                }
+                positiveHistogram[bin] += positiveWeight[i];
+                negativeHistogram[bin] += negativeWeight[i];
+            }
+        }
+    );
+    for (ui32 blockId = 1; blockId < blockCount; ++blockId) {
+        for (ui32 bin = 0; bin < binCount; ++bin) {
+            positiveHistograms[0][bin] += positiveHistograms[blockId][bin];
+            negativeHistograms[0][bin] += negativeHistograms[blockId][bin];
+        }
+    }
+    const auto& positiveHistogram = positiveHistograms[0];
+    const auto& negativeHistogram = negativeHistograms[0];
+
+    double pairWeightSum = 0;
+    double tiedPairWeightSum = 0;
+    double negativeWeightBelow = 0;
+    for (ui32 bin = 0; bin < binCount; ++bin) {
+        const double tiedPairWeight = positiveHistogram[bin] * negativeHistogram[bin];
+        pairWeightSum += positiveHistogram[bin] * negativeWeightBelow + tiedPairWeight / 2.0;
+        tiedPairWeightSum += tiedPairWeight;
+        negativeWeightBelow += negativeHistogram[bin];
+    }
+    const double positiveWeightSum = Accumulate(positiveHistogram, 0.0);
+    const double negativeWeightSum = negativeWeightBelow;
+    if (positiveWeightSum == 0 || negativeWeightSum == 0) {
+        return 0;
+    }
+    if (outErrorBound != nullptr) {
+        *outErrorBound = tiedPairWeightSum / (2.0 * positiveWeightSum * negativeWeightSum);
+    }
+    return pairWeightSum / (positiveWeightSum * negativeWeightSum);
+}
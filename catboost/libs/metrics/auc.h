@@ -4,8 +4,26 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+
 double CalcAUC(TVector<NMetrics::TSample>* samples, NPar::TLocalExecutor* localExecutor, double* outWeightSum = nullptr, double* outPairWeightSum = nullptr);
 double CalcAUC(TVector<NMetrics::TSample>* samples, double* outWeightSum = nullptr, double* outPairWeightSum = nullptr, int threadCount = 1);
 
 double CalcBinClassAuc(TVector<NMetrics::TBinClassSample>* positiveSamples, TVector<NMetrics::TBinClassSample>* negativeSamples, NPar::TLocalExecutor* localExecutor);
 double CalcBinClassAuc(TVector<NMetrics::TBinClassSample>* positiveSamples, TVector<NMetrics::TBinClassSample>* negativeSamples, int threadCount = 1);
+
+// Approximate AUC over a fixed prediction histogram. Pairs falling into the same bin are counted as ties,
+// so the returned value differs from the exact AUC by at most *outErrorBound.
+// If bins is not empty it contains bins of objects from a previous call with the same borders, they are
+// checked and used as a starting point for the bin search, and updated with the current bins.
+TVector<double> CalcApproxAucBorders(TConstArrayRef<double> prediction, ui32 binCount);
+double CalcApproxBinClassAuc(
+    TConstArrayRef<double> prediction,
+    TConstArrayRef<double> positiveWeight,
+    TConstArrayRef<double> negativeWeight,
+    TConstArrayRef<double> borders,
+    NPar::TLocalExecutor* localExecutor,
+    double* outErrorBound = nullptr,
+    TArrayRef<ui32> bins = {}
+);
@@ -4,5 +4,6 @@ enum class EAucType {
     Classic,
     Ranking,
     Mu,
-    OneVsAll
+    OneVsAll,
+    Approx
 };
@@ -25,6 +25,8 @@
 #include <library/fast_exp/fast_exp.h>
 #include <library/fast_log/fast_log.h>
 
+#include <util/digest/murmur.h>
+#include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/hash.h>
 #include <util/generic/hash_set.h>
@@ -35,6 +37,8 @@
 #include <util/string/cast.h>
 #include <util/string/split.h>
 #include <util/string/printf.h>
+#include <util/system/guard.h>
+#include <util/system/mutex.h>
 #include <util/system/yassert.h>
 
 #include <limits>
@@ -2133,6 +2137,13 @@ namespace {
             UseWeights.SetDefaultValue(false);
         }
 
+        explicit TAUCMetric(ui32 approxBinCount)
+            : Type(EAucType::Approx)
+            , ApproxBinCount(approxBinCount) {
+            CB_ENSURE(approxBinCount >= 2, "Approx AUC requires at least 2 bins");
+            UseWeights.SetDefaultValue(false);
+        }
+
         explicit TAUCMetric(int positiveClass)
             : PositiveClass(positiveClass)
             , Type(EAucType::OneVsAll) {
@@ -2168,10 +2179,35 @@ namespace {
         TString GetDescription() const override;
         void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
 
+    private:
+        double EvalApprox(
+            TConstArrayRef<double> approx,
+            TConstArrayRef<double> approxDelta,
+            TConstArrayRef<float> target,
+            TConstArrayRef<float> weight,
+            int begin,
+            int end,
+            NPar::TLocalExecutor& executor) const;
+
     private:
         int PositiveClass = 1;
         EAucType Type;
         TMaybe<TVector<TVector<double>>> MisclassCostMatrix = Nothing();
+        ui32 ApproxBinCount = 0;
+
+        // Histogram borders of the approximate AUC and bins of objects are kept per dataset and reused
+        // between iterations while the tie error stays within 1 / ApproxBinCount.
+        // A dataset is identified by the hash of its target, not by data pointers that can be reused.
+        struct TApproxAucCache {
+            TVector<double> Borders;
+            TVector<ui32> Bins; // [objectIdx - begin]
+            ui64 LastUsage = 0;
+        };
+        using TApproxAucCacheKey = std::tuple<ui64, int, int>; // target hash, begin, end
+        static constexpr size_t MaxApproxAucCacheSize = 16; // least recently used datasets are evicted
+        mutable TMap<TApproxAucCacheKey, TApproxAucCache> ApproxAucCache;
+        mutable ui64 ApproxAucCacheUsageCounter = 0;
+        mutable TMutex ApproxAucCacheLock;
     };
 }
 
@@ -2183,6 +2219,10 @@ THolder<IMetric> MakeRankingAucMetric() {
     return MakeHolder<TAUCMetric>(EAucType::Ranking);
 }
 
+THolder<IMetric> MakeApproxAucMetric(ui32 binCount) {
+    return MakeHolder<TAUCMetric>(binCount);
+}
+
 THolder<IMetric> MakeMultiClassAucMetric(int positiveClass) {
     return MakeHolder<TAUCMetric>(positiveClass);
 }
@@ -2229,6 +2269,13 @@ TMetricHolder TAUCMetric::Eval(
         return error;
     }
 
+    if (Type == EAucType::Approx) {
+        TMetricHolder error(2);
+        error.Stats[0] = EvalApprox(approx[0], approxDelta.empty() ? TConstArrayRef<double>() : approxDelta[0], target, weight, begin, end, executor);
+        error.Stats[1] = 1;
+        return error;
+    }
+
     const auto realApprox = [&](int idx) {
         return approx[Type == EAucType::OneVsAll ? PositiveClass : 0][idx]
         + (approxDelta.empty() ? 0.0 : approxDelta[Type == EAucType::OneVsAll ? PositiveClass : 0][idx]);
@@ -2268,6 +2315,70 @@ TMetricHolder TAUCMetric::Eval(
     return error;
 }
 
+double TAUCMetric::EvalApprox(
+    TConstArrayRef<double> approx,
+    TConstArrayRef<double> approxDelta,
+    TConstArrayRef<float> target,
+    TConstArrayRef<float> weight,
+    int begin,
+    int end,
+    NPar::TLocalExecutor& executor
+) const {
+    const int size = end - begin;
+    TVector<double> currentApprox(approx.begin() + begin, approx.begin() + end);
+    if (!approxDelta.empty()) {
+        for (int i : xrange(size)) {
+            currentApprox[i] += approxDelta[begin + i];
+        }
+    }
+    TVector<double> positiveWeight(size);
+    TVector<double> negativeWeight(size);
+    for (int i : xrange(size)) {
+        const double currentTarget = target[begin + i];
+        CB_ENSURE(0 <= currentTarget && currentTarget <= 1, "All target values should be in the segment [0, 1], for Ranking AUC please use type=Ranking.");
+        const double currentWeight = UseWeights && !weight.empty() ? weight[begin + i] : 1.0;
+        positiveWeight[i] = currentTarget * currentWeight;
+        negativeWeight[i] = (1 - currentTarget) * currentWeight;
+    }
+
+    const TApproxAucCacheKey key(MurmurHash<ui64>(target.data() + begin, size * sizeof(float)), begin, end);
+    TApproxAucCache cache;
+    with_lock (ApproxAucCacheLock) {
+        auto it = ApproxAucCache.find(key);
+        if (it != ApproxAucCache.end()) {
+            cache = std::move(it->second);
+            ApproxAucCache.erase(it);
+        }
+    }
+    if (cache.Bins.ysize() != size) {
+        cache.Bins.assign(size, 0);
+    }
+
+    const double maxErrorBound = 1.0 / ApproxBinCount;
+    double errorBound = 0;
+    double result = 0;
+    if (!cache.Borders.empty()) {
+        result = CalcApproxBinClassAuc(currentApprox, positiveWeight, negativeWeight, cache.Borders, &executor, &errorBound, cache.Bins);
+    }
+    if (cache.Borders.empty() || errorBound > maxErrorBound) {
+        cache.Borders = CalcApproxAucBorders(currentApprox, ApproxBinCount);
+        result = CalcApproxBinClassAuc(currentApprox, positiveWeight, negativeWeight, cache.Borders, &executor, &errorBound, cache.Bins);
+    }
+
+    with_lock (ApproxAucCacheLock) {
+        cache.LastUsage = ++ApproxAucCacheUsageCounter;
+        if (ApproxAucCache.size() >= MaxApproxAucCacheSize) {
+            auto leastRecentlyUsed = MinElementBy(
+                ApproxAucCache,
+                [] (const auto& keyAndCache) { return keyAndCache.second.LastUsage; }
+            );
+            ApproxAucCache.erase(leastRecentlyUsed);
+        }
+        ApproxAucCache[key] = std::move(cache);
+    }
+    return result;
+}
+
 template<typename T>
 static TString ConstructDescriptionOfSquareMatrix(const TVector<TVector<T>>& matrix) {
     TString matrixInString = "";
@@ -2302,6 +2413,11 @@ TString TAUCMetric::GetDescription() const {
         case EAucType::Ranking: {
             return BuildDescription(ELossFunction::AUC, UseWeights, TMetricParam<TString>("type", ToString(EAucType::Ranking), /*userDefined*/true));
         }
+        case EAucType::Approx: {
+            const TMetricParam<TString> aucType("type", ToString(EAucType::Approx), /*userDefined*/true);
+            const TMetricParam<ui32> binCount("bins", ApproxBinCount, /*userDefined*/true);
+            return BuildDescription(ELossFunction::AUC, UseWeights, aucType, binCount);
+        }
         default: {
             Y_VERIFY(false);
         }
@@ -3949,7 +4065,7 @@ static TVector<THolder<IMetric>> CreateMetric(ELossFunction metric, TMap<TString
                 const TString name = params.at("type");
                 aucType = FromString<EAucType>(name);
                 if (approxDimension == 1) {
-                    CB_ENSURE(aucType == EAucType::Classic || aucType == EAucType::Ranking,
+                    CB_ENSURE(aucType == EAucType::Classic || aucType == EAucType::Ranking || aucType == EAucType::Approx,
                         "AUC type \"" << aucType << "\" isn't a singleclass AUC type");
                 } else {
                     CB_ENSURE(aucType == EAucType::Mu || aucType == EAucType::OneVsAll,
@@ -3965,6 +4081,12 @@ static TVector<THolder<IMetric>> CreateMetric(ELossFunction metric, TMap<TString
                     result.push_back(MakeRankingAucMetric());
                     break;
                 }
+                case EAucType::Approx: {
+                    validParams.insert("bins");
+                    const ui32 binCount = params.contains("bins") ? FromString<ui32>(params.at("bins")) : 4096;
+                    result.push_back(MakeApproxAucMetric(binCount));
+                    break;
+                }
                 case EAucType::Mu: {
                     validParams.insert("misclass_cost_matrix");
                     TMaybe<TVector<TVector<double>>> misclassCostMatrix = Nothing();
@@ -275,6 +275,7 @@ THolder<IMetric> MakeFilteredDcgMetric(ENdcgMetricType type, ENdcgDenominatorTyp
 
 THolder<IMetric> MakeBinClassAucMetric();
 THolder<IMetric> MakeRankingAucMetric();
+THolder<IMetric> MakeApproxAucMetric(ui32 binCount);
 THolder<IMetric> MakeMultiClassAucMetric(int positiveClass);
 THolder<IMetric> MakeMuAucMetric(const TMaybe<TVector<TVector<double>>>& misclassCostMatrix = Nothing());
 
@@ -1,4 +1,5 @@
 #include <catboost/libs/metrics/auc.h>
+#include <catboost/libs/metrics/metric.h>
 #include <catboost/libs/metrics/metric_holder.h>
 #include <catboost/libs/helpers/cpu_random.h>
 
@@ -474,4 +475,117 @@ Y_UNIT_TEST_SUITE(AUCMetricTests) {
         TestBinClassAucRandom(2000, 1000, false, EPS);
         TestBinClassAucRandom(2000, 2000, false, EPS);
     }
+
+    Y_UNIT_TEST(ApproxBinClassAucTest) {
+        TFastRng<ui64> rng(239);
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(7);
+        const ui32 size = 20000;
+        for (ui32 binCount : {2u, 16u, 256u, 4096u}) {
+            TVector<double> prediction(size), positiveWeight(size), negativeWeight(size);
+            TVector<NMetrics::TBinClassSample> positiveSamples, negativeSamples;
+            for (ui32 i = 0; i < size; ++i) {
+                const bool isPositive = rng.GenRandReal1() < 0.3;
+                prediction[i] = rng.GenRandReal1() + (isPositive ? 0.3 : 0.0);
+                const double weight = rng.GenRandReal1();
+                positiveWeight[i] = isPositive ? weight : 0.0;
+                negativeWeight[i] = isPositive ? 0.0 : weight;
+                (isPositive ? positiveSamples : negativeSamples).emplace_back(prediction[i], weight);
+            }
+            const double exactAuc = CalcBinClassAuc(&positiveSamples, &negativeSamples, &executor);
+            const TVector<double> borders = CalcApproxAucBorders(prediction, binCount);
+            UNIT_ASSERT(borders.size() < binCount);
+            double errorBound = 0;
+            const double approxAuc = CalcApproxBinClassAuc(prediction, positiveWeight, negativeWeight, borders, &executor, &errorBound);
+            UNIT_ASSERT_DOUBLES_EQUAL(approxAuc, exactAuc, errorBound + 1e-9);
+            if (binCount >= 256) {
+                UNIT_ASSERT(errorBound < 2.0 / binCount);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(ApproxBinClassAucBinsHintsTest) {
+        TFastRng<ui64> rng(17);
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+        const ui32 size = 10000;
+        TVector<double> prediction(size), positiveWeight(size), negativeWeight(size);
+        for (ui32 i = 0; i < size; ++i) {
+            const bool isPositive = rng.GenRandReal1() < 0.5;
+            prediction[i] = rng.GenRandReal1() + (isPositive ? 0.2 : 0.0);
+            positiveWeight[i] = isPositive ? 1.0 : 0.0;
+            negativeWeight[i] = isPositive ? 0.0 : 1.0;
+        }
+        const TVector<double> borders = CalcApproxAucBorders(prediction, 64);
+        const double expectedAuc = CalcApproxBinClassAuc(prediction, positiveWeight, negativeWeight, borders, &executor);
+
+        // hints can be arbitrary, even out of range
+        TVector<ui32> bins(size);
+        for (ui32 i = 0; i < size; ++i) {
+            bins[i] = rng.Uniform(borders.size() + 10);
+        }
+        for (int iteration = 0; iteration < 2; ++iteration) {
+            const double auc = CalcApproxBinClassAuc(prediction, positiveWeight, negativeWeight, borders, &executor, nullptr, bins);
+            UNIT_ASSERT_VALUES_EQUAL(auc, expectedAuc);
+            for (ui32 i = 0; i < size; ++i) {
+                UNIT_ASSERT_VALUES_EQUAL(bins[i], ui32(UpperBound(borders.begin(), borders.end(), prediction[i]) - borders.begin()));
+            }
+            for (auto& value : prediction) {
+                value += 0.001 * (rng.GenRandReal1() - 0.5);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(ApproxAucMetricReusesCacheTest) {
+        TFastRng<ui64> rng(42);
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+        const ui32 size = 10000;
+        const ui32 binCount = 256;
+        TVector<TVector<double>> approx(1, TVector<double>(size));
+        TVector<float> target(size);
+        TVector<double> positiveWeight(size), negativeWeight(size);
+        for (ui32 i = 0; i < size; ++i) {
+            target[i] = rng.GenRandReal1() < 0.4 ? 1.0f : 0.0f;
+            approx[0][i] = rng.GenRandReal1() + target[i] * 0.5;
+            positiveWeight[i] = target[i];
+            negativeWeight[i] = 1.0 - target[i];
+        }
+
+        auto metric = MakeApproxAucMetric(binCount);
+        const double firstAuc = metric->GetFinalError(metric->Eval(approx, target, {}, {}, 0, size, executor));
+        const TVector<double> firstBorders = CalcApproxAucBorders(approx[0], binCount);
+        UNIT_ASSERT_VALUES_EQUAL(
+            firstAuc,
+            CalcApproxBinClassAuc(approx[0], positiveWeight, negativeWeight, firstBorders, &executor)
+        );
+
+        // the next iteration changes approxes slightly, borders of the first call are still good enough
+        for (auto& value : approx[0]) {
+            value += 0.001 * (rng.GenRandReal1() - 0.5);
+        }
+        double errorBound = 0;
+        const double expectedSecondAuc = CalcApproxBinClassAuc(
+            approx[0], positiveWeight, negativeWeight, firstBorders, &executor, &errorBound
+        );
+        UNIT_ASSERT(errorBound <= 1.0 / binCount);
+        UNIT_ASSERT(CalcApproxAucBorders(approx[0], binCount) != firstBorders);
+
+        const double secondAuc = metric->GetFinalError(metric->Eval(approx, target, {}, {}, 0, size, executor));
+        UNIT_ASSERT_VALUES_EQUAL(secondAuc, expectedSecondAuc);
+
+        // another dataset doesn't use borders of the first one
+        TVector<float> otherTarget(target.rbegin(), target.rend());
+        for (ui32 i = 0; i < size; ++i) {
+            positiveWeight[i] = otherTarget[i];
+            negativeWeight[i] = 1.0 - otherTarget[i];
+        }
+        const double otherAuc = metric->GetFinalError(metric->Eval(approx, otherTarget, {}, {}, 0, size, executor));
+        UNIT_ASSERT_VALUES_EQUAL(
+            otherAuc,
+            CalcApproxBinClassAuc(
+                approx[0], positiveWeight, negativeWeight, CalcApproxAucBorders(approx[0], binCount), &executor
+            )
+        );
+    }
 }
@@ -92,7 +92,8 @@ namespace NCB::NModelEvaluation {
         size_t docCount,
         size_t blockSize,
         TFunctor callback,
-        const NCB::NModelEvaluation::TFeatureLayout* featureInfo
+        const NCB::NModelEvaluation::TFeatureLayout* featureInfo,
+        TEvaluationCounters* counters = nullptr // if not null, binarization stages are accounted, callback time is not
     ) {
         const size_t binSlots = blockSize * trees.GetEffectiveBinaryFeaturesBucketsCount();
 
@@ -116,6 +117,8 @@ namespace NCB::NModelEvaluation {
 
         for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
             const auto docCountInBlock = Min(blockSize, docCount - blockStart);
+            const auto binarizationTimer = StartStageTimer(counters);
+            const ui64 nestedStagesNs = counters ? counters->TextProcessingNs + counters->CtrCalcNs : 0;
             BinarizeFeatures(
                 trees,
                 ctrProvider,
@@ -129,8 +132,16 @@ namespace NCB::NModelEvaluation {
                 transposedHash,
                 ctrs,
                 estimatedFeatures,
-                featureInfo
+                featureInfo,
+                counters
             );
+            if (counters) {
+                const ui64 binarizeFeaturesNs = GetPassedNs(binarizationTimer);
+                const ui64 nestedStagesDeltaNs = counters->TextProcessingNs + counters->CtrCalcNs - nestedStagesNs;
+                counters->BinarizationNs += binarizeFeaturesNs - Min(binarizeFeaturesNs, nestedStagesDeltaNs);
+                counters->ObjectCount += docCountInBlock;
+                ++counters->BlockCount;
+            }
             callback(docCountInBlock, &quantizedData);
         }
     }
@@ -253,14 +253,14 @@ namespace NCB::NModelEvaluation {
     template <bool IsSingleClassModel, bool NeedXorMask, int SSEBlockCount, bool CalcLeafIndexesOnly = false>
     Y_FORCE_INLINE void CalcTreesBlockedImpl(
         const TObliviousTrees& trees,
+        const TRepackedBin* repackedBins,
         const ui8* __restrict binFeatures,
         const size_t docCountInBlock,
         TCalcerIndexType* __restrict indexesVecUI32,
         size_t treeStart,
         const size_t treeEnd,
         double* __restrict resultsPtr) {
-        const TRepackedBin* treeSplitsCurPtr =
-            trees.GetRepackedBins().data() + trees.GetTreeStartOffsets()[treeStart];
+        const TRepackedBin* treeSplitsCurPtr = repackedBins + trees.GetTreeStartOffsets()[treeStart];
 
         ui8* __restrict indexesVec = (ui8*)indexesVecUI32;
         const auto treeLeafPtr = trees.GetLeafValues().data();
@@ -365,42 +365,43 @@ namespace NCB::NModelEvaluation {
         size_t treeEnd,
         double* __restrict resultsPtr) {
         const ui8* __restrict binFeatures = quantizedData->QuantizedData.data();
+        const TRepackedBin* repackedBins = GetRepackedBins(trees, quantizedData).data();
         switch (docCountInBlock / SSE_BLOCK_SIZE) {
             case 0:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 0, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 1:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 1, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 2:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 2, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 3:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 3, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 4:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 4, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 5:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 5, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 6:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 6, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 7:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 7, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             case 8:
                 CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 8, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+                    trees, repackedBins, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
                 break;
             default:
                 Y_UNREACHABLE();
@@ -422,7 +423,7 @@ namespace NCB::NModelEvaluation {
         Y_ASSERT(calcIndexesOnly || (results && AllOf(results, results + trees.GetDimensionsCount(),
                                                       [](double value) { return value == 0.0; })));
         const TRepackedBin* treeSplitsCurPtr =
-            trees.GetRepackedBins().data() + trees.GetTreeStartOffsets()[treeStart];
+            GetRepackedBins(trees, quantizedData).data() + trees.GetTreeStartOffsets()[treeStart];
         const double* treeLeafPtr = trees.GetFirstLeafPtrForTree(treeStart);
         for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
             const auto curTreeSize = trees.GetTreeSizes()[treeId];
@@ -458,13 +459,13 @@ namespace NCB::NModelEvaluation {
     template <bool NeedXorMask>
     Y_FORCE_INLINE void CalcIndexesNonSymmetric(
         const TObliviousTrees& trees,
+        const TRepackedBin* __restrict treeSplitsPtr,
         const ui8* __restrict binFeatures,
         const size_t firstDocId,
         const size_t docCountInBlock,
         const size_t treeId,
         TCalcerIndexType* __restrict indexesVec
     ) {
-        const TRepackedBin* treeSplitsPtr = trees.GetRepackedBins().data();
         const TNonSymmetricTreeStepNode* treeStepNodes = trees.GetNonSymmetricStepNodes().data();
         std::fill(indexesVec + firstDocId, indexesVec + docCountInBlock, trees.GetTreeStartOffsets()[treeId]);
         size_t countStopped = 0;
@@ -496,7 +497,7 @@ namespace NCB::NModelEvaluation {
         double* __restrict resultsPtr
     ) {
         const ui8* __restrict binFeaturesI = quantizedData->QuantizedData.data();
-        const TRepackedBin* treeSplitsPtr = trees.GetRepackedBins().data();
+        const TRepackedBin* treeSplitsPtr = GetRepackedBins(trees, quantizedData).data();
         const i32* treeStepNodes = reinterpret_cast<const i32*>(trees.GetNonSymmetricStepNodes().data());
         const ui32* __restrict nonSymmetricNodeIdToLeafIdPtr = trees.GetNonSymmetricNodeIdToLeafId().data();
         const double* __restrict leafValuesPtr = trees.GetLeafValues().data();
@@ -612,7 +613,7 @@ namespace NCB::NModelEvaluation {
                 _mm_storeu_si128(indexesVec + 1, index1);
             }
             if (docId < docCountInBlock) {
-                CalcIndexesNonSymmetric<NeedXorMask>(trees, binFeaturesI, docId, docCountInBlock, treeId, indexes);
+                CalcIndexesNonSymmetric<NeedXorMask>(trees, treeSplitsPtr, binFeaturesI, docId, docCountInBlock, treeId, indexes);
             }
             if constexpr (CalcLeafIndexesOnly) {
                 const auto firstLeafOffsets = trees.GetFirstLeafOffsets();
@@ -661,8 +662,9 @@ namespace NCB::NModelEvaluation {
         double* __restrict resultsPtr
     ) {
         const ui8* __restrict binFeatures = quantizedData->QuantizedData.data();
+        const TRepackedBin* treeSplitsPtr = GetRepackedBins(trees, quantizedData).data();
         for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
-            CalcIndexesNonSymmetric<NeedXorMask>(trees, binFeatures, 0, docCountInBlock, treeId, indexesVec);
+            CalcIndexesNonSymmetric<NeedXorMask>(trees, treeSplitsPtr, binFeatures, 0, docCountInBlock, treeId, indexesVec);
             for (size_t docId = 0; docId < docCountInBlock; ++docId) {
                 indexesVec[docId] = trees.GetNonSymmetricNodeIdToLeafId()[indexesVec[docId]];
             }
@@ -707,7 +709,7 @@ namespace NCB::NModelEvaluation {
     ) {
         const ui8* __restrict binFeatures = quantizedData->QuantizedData.data();
         TCalcerIndexType index;
-        const TRepackedBin* treeSplitsPtr = trees.GetRepackedBins().data();
+        const TRepackedBin* treeSplitsPtr = GetRepackedBins(trees, quantizedData).data();
         const TNonSymmetricTreeStepNode* treeStepNodes = trees.GetNonSymmetricStepNodes().data();
         const auto firstLeafOffsets = trees.GetFirstLeafOffsets();
         for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
@@ -787,7 +789,7 @@ namespace NCB::NModelEvaluation {
         const bool areTreesOblivious = trees.IsOblivious();
         const bool isSingleDoc = (docCountInBlock == 1);
         const bool isSingleClassModel = (trees.GetDimensionsCount() == 1);
-        const bool needXorMask = !trees.GetOneHotFeatures().empty();
+        const bool needXorMask = !trees.GetOneHotFeatures().empty() || !trees.GetFloatFeatureBundles().empty();
         return FunctorTemplateParamsSubstitutor<CalcTreeFunctionInstantiationGetter>::Call(
             areTreesOblivious, isSingleDoc, isSingleClassModel, needXorMask, calcIndexesOnly);
     }
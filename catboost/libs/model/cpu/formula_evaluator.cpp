@@ -3,6 +3,14 @@
 
 #include "evaluator.h"
 
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/string/cast.h>
+#include <util/system/guard.h>
+#include <util/system/spinlock.h>
+
+#include <atomic>
+
 namespace NCB::NModelEvaluation {
     namespace NDetail {
         template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor, typename TTextFeatureAccessor>
@@ -18,7 +26,8 @@ namespace NCB::NModelEvaluation {
             size_t treeEnd,
             EPredictionType predictionType,
             TArrayRef<double> results,
-            const NCB::NModelEvaluation::TFeatureLayout* featureInfo = nullptr
+            const NCB::NModelEvaluation::TFeatureLayout* featureInfo = nullptr,
+            TEvaluationCounters* counters = nullptr
         ) {
             const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
             auto calcTrees = GetCalcTreesFunction(trees, blockSize);
@@ -46,6 +55,7 @@ namespace NCB::NModelEvaluation {
                 blockSize,
                 [&] (size_t docCountInBlock, const TCPUEvaluatorQuantizedData* quantizedData) {
                     auto blockResultsView = resultProcessor.GetViewForRawEvaluation(blockId);
+                    const auto treeTraversalTimer = StartStageTimer(counters);
                     calcTrees(
                         trees,
                         quantizedData,
@@ -55,20 +65,399 @@ namespace NCB::NModelEvaluation {
                         treeEnd,
                         blockResultsView.data()
                     );
+                    if (counters) {
+                        counters->TreeTraversalNs += GetPassedNs(treeTraversalTimer);
+                    }
                     resultProcessor.PostprocessBlock(blockId);
                     ++blockId;
                 },
+                featureInfo,
+                counters
+            );
+        }
+
+        static void DropUnreachableObjects(
+            const TEarlyExitParams& params,
+            double remainingMinSum,
+            double remainingMaxSum,
+            TConstArrayRef<double> results,
+            TArrayRef<bool> isDropped
+        ) {
+            if (params.Threshold.Defined()) {
+                for (size_t docId : xrange(results.size())) {
+                    if (!isDropped[docId] && results[docId] + remainingMaxSum < *params.Threshold) {
+                        isDropped[docId] = true;
+                    }
+                }
+            }
+            if (params.TopSize == 0) {
+                return;
+            }
+            TVector<double> lowerBounds;
+            size_t groupStart = 0;
+            for (ui32 groupSize : params.GroupSizes) {
+                const size_t groupEnd = groupStart + groupSize;
+                lowerBounds.clear();
+                for (size_t docId : xrange(groupStart, groupEnd)) {
+                    if (!isDropped[docId]) {
+                        lowerBounds.push_back(results[docId] + remainingMinSum);
+                    }
+                }
+                if (lowerBounds.size() > params.TopSize) {
+                    auto topBorder = lowerBounds.begin() + (params.TopSize - 1);
+                    NthElement(lowerBounds.begin(), topBorder, lowerBounds.end(), TGreater<double>());
+                    for (size_t docId : xrange(groupStart, groupEnd)) {
+                        if (!isDropped[docId] && results[docId] + remainingMaxSum < *topBorder) {
+                            isDropped[docId] = true;
+                        }
+                    }
+                }
+                groupStart = groupEnd;
+            }
+        }
+
+        template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
+        inline TEarlyExitStats CalcGenericWithEarlyExit(
+            const TObliviousTrees& trees,
+            const TIntrusivePtr<ICtrProvider>& ctrProvider,
+            TConstArrayRef<double> remainingMinLeafValueSums,
+            TConstArrayRef<double> remainingMaxLeafValueSums,
+            TFloatFeatureAccessor floatFeatureAccessor,
+            TCatFeatureAccessor catFeaturesAccessor,
+            size_t docCount,
+            const TEarlyExitParams& params,
+            TArrayRef<double> results,
+            TArrayRef<bool> isDropped,
+            const NCB::NModelEvaluation::TFeatureLayout* featureInfo
+        ) {
+            std::fill(results.begin(), results.end(), 0.0);
+            std::fill(isDropped.begin(), isDropped.end(), false);
+            const size_t treeCount = trees.GetTreeCount();
+            TEarlyExitStats stats;
+            stats.TotalTreeCount = docCount * treeCount;
+            if (docCount == 0 || treeCount == 0) {
+                stats.EvaluatedTreeCount = stats.TotalTreeCount;
+                DropUnreachableObjects(params, 0.0, 0.0, results, isDropped);
+                return stats;
+            }
+
+            // binarize once, trees are then applied block by block to the objects not dropped yet
+            const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+            const size_t maxBucketCount = trees.GetEffectiveBinaryFeaturesBucketsCount();
+            TVector<TVector<ui8>> blockQuantizedData;
+            TVector<bool> isBlockBundled;
+            ProcessDocsInBlocks(
+                trees,
+                ctrProvider,
+                floatFeatureAccessor,
+                catFeaturesAccessor,
+                docCount,
+                blockSize,
+                [&] (size_t docCountInBlock, const TCPUEvaluatorQuantizedData* quantizedData) {
+                    const ui8* data = quantizedData->QuantizedData.data();
+                    const size_t bucketCount = GetBinFeaturesBucketCount(trees, quantizedData);
+                    blockQuantizedData.emplace_back(data, data + docCountInBlock * bucketCount);
+                    isBlockBundled.push_back(quantizedData->HasBundledFloatFeatures);
+                },
                 featureInfo
             );
+
+            auto calcTrees = GetCalcTreesFunction(trees, blockSize);
+            auto calcTreesSingle = GetCalcTreesFunction(trees, 1);
+            TVector<TCalcerIndexType> indexesVec(blockSize);
+            TVector<ui32> activeDocs(Reserve(blockSize));
+            TVector<ui8> activeQuantizedHolder(blockSize * maxBucketCount);
+            TVector<double> activeResults(blockSize);
+            TCPUEvaluatorQuantizedData activeQuantizedData;
+            for (size_t treeStart = 0; treeStart < treeCount; treeStart += params.TreeBlockSize) {
+                const size_t treeEnd = Min(treeCount, treeStart + params.TreeBlockSize);
+                for (size_t blockId : xrange(blockQuantizedData.size())) {
+                    const size_t blockStart = blockId * blockSize;
+                    const size_t docCountInBlock = Min(blockSize, docCount - blockStart);
+                    activeDocs.clear();
+                    for (ui32 docId : xrange(docCountInBlock)) {
+                        if (!isDropped[blockStart + docId]) {
+                            activeDocs.push_back(docId);
+                        }
+                    }
+                    const size_t activeCount = activeDocs.size();
+                    if (activeCount == 0) {
+                        continue;
+                    }
+                    TVector<ui8>& blockData = blockQuantizedData[blockId];
+                    activeQuantizedData.HasBundledFloatFeatures = isBlockBundled[blockId];
+                    const size_t bucketCount = GetBinFeaturesBucketCount(trees, &activeQuantizedData);
+                    if (activeCount == docCountInBlock) {
+                        activeQuantizedData.QuantizedData = TMaybeOwningArrayHolder<ui8>::CreateNonOwning(blockData);
+                    } else {
+                        for (size_t bucketId : xrange(bucketCount)) {
+                            const ui8* src = blockData.data() + bucketId * docCountInBlock;
+                            ui8* dst = activeQuantizedHolder.data() + bucketId * activeCount;
+                            for (size_t i : xrange(activeCount)) {
+                                dst[i] = src[activeDocs[i]];
+                            }
+                        }
+                        activeQuantizedData.QuantizedData = TMaybeOwningArrayHolder<ui8>::CreateNonOwning(
+                            MakeArrayRef(activeQuantizedHolder.data(), activeCount * bucketCount));
+                    }
+                    std::fill(activeResults.begin(), activeResults.begin() + activeCount, 0.0);
+                    (activeCount == 1 ? calcTreesSingle : calcTrees)(
+                        trees,
+                        &activeQuantizedData,
+                        activeCount,
+                        activeCount == 1 ? nullptr : indexesVec.data(),
+                        treeStart,
+                        treeEnd,
+                        activeResults.data()
+                    );
+                    for (size_t i : xrange(activeCount)) {
+                        results[blockStart + activeDocs[i]] += activeResults[i];
+                    }
+                    stats.EvaluatedTreeCount += activeCount * (treeEnd - treeStart);
+                }
+                DropUnreachableObjects(
+                    params,
+                    remainingMinLeafValueSums[treeEnd],
+                    remainingMaxLeafValueSums[treeEnd],
+                    results,
+                    isDropped
+                );
+            }
+            return stats;
         }
 
+        struct TSparseFloatFeatureBinarization {
+            TConstArrayRef<float> Borders;
+            ui32 FlatIndex = 0;
+            size_t BucketOffset = 0;
+            float NanSubstitution = 0.0f;
+        };
+
+        inline void CalcSparseGeneric(
+            const TObliviousTrees& trees,
+            const TSparseFloatFeatures& features,
+            size_t treeStart,
+            size_t treeEnd,
+            EPredictionType predictionType,
+            TArrayRef<double> results,
+            const NCB::NModelEvaluation::TFeatureLayout* featureInfo
+        ) {
+            const size_t docCount = features.ObjectCount;
+            CB_ENSURE(
+                features.Offsets.size() == (features.ColumnMajor ? features.FeatureCount : docCount) + 1,
+                "Sparse features offsets size should be one more than the " << (features.ColumnMajor ? "feature" : "object") << " count"
+            );
+            CB_ENSURE(
+                features.Indices.size() == features.Values.size() && features.Offsets.back() <= features.Indices.size(),
+                "Sparse features indices and values are inconsistent with offsets"
+            );
+            for (auto i : xrange(features.Offsets.size() - 1)) {
+                CB_ENSURE(
+                    features.Offsets[i] <= features.Offsets[i + 1],
+                    "Sparse features offsets should be non-decreasing" << LabeledOutput(i, features.Offsets[i], features.Offsets[i + 1])
+                );
+            }
+            if (features.ColumnMajor) {
+                for (auto pos : xrange(features.Offsets.front(), features.Offsets.back())) {
+                    CB_ENSURE(
+                        features.Indices[pos] < docCount,
+                        "Object index " << features.Indices[pos] << " of sparse features is out of range" << LabeledOutput(docCount)
+                    );
+                }
+            }
+            std::fill(results.begin(), results.end(), 0.0);
+            if (trees.GetTreeCount() == 0 || docCount == 0) {
+                return;
+            }
+
+            const size_t bucketCount = trees.GetEffectiveBinaryFeaturesBucketsCount();
+            TVector<TSparseFloatFeatureBinarization> usedFeatures;
+            TVector<ui8> defaultBins(bucketCount);
+            size_t bucketOffset = 0;
+            for (const auto& floatFeature : trees.GetFloatFeatures()) {
+                if (!floatFeature.UsedInModel()) {
+                    continue;
+                }
+                TSparseFloatFeatureBinarization binarization;
+                binarization.Borders = floatFeature.Borders;
+                binarization.FlatIndex = featureInfo ?
+                    featureInfo->GetRemappedPosition(floatFeature).FlatIndex :
+                    floatFeature.Position.FlatIndex;
+                CB_ENSURE(
+                    binarization.FlatIndex < features.FeatureCount,
+                    "Not enough features provided" << LabeledOutput(binarization.FlatIndex, features.FeatureCount)
+                );
+                binarization.BucketOffset = bucketOffset;
+                binarization.NanSubstitution = std::numeric_limits<float>::quiet_NaN();
+                if (floatFeature.HasNans && floatFeature.NanValueTreatment != TFloatFeature::ENanValueTreatment::AsIs) {
+                    const float infinity = std::numeric_limits<float>::infinity();
+                    binarization.NanSubstitution =
+                        floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsFalse ? -infinity : infinity;
+                }
+                BinarizeFloatValue(0.0f, binarization.Borders, 1, defaultBins.data() + bucketOffset);
+                bucketOffset += (binarization.Borders.size() + MAX_VALUES_PER_BIN - 1) / MAX_VALUES_PER_BIN;
+                usedFeatures.push_back(binarization);
+            }
+            CB_ENSURE_INTERNAL(bucketOffset == bucketCount, "Sparse evaluation expects float features only");
+
+            // flat feature index -> index in usedFeatures
+            TVector<i32> usedFeatureIndices;
+            for (auto i : xrange(usedFeatures.size())) {
+                const ui32 flatIndex = usedFeatures[i].FlatIndex;
+                if (usedFeatureIndices.size() <= flatIndex) {
+                    usedFeatureIndices.resize(flatIndex + 1, -1);
+                }
+                usedFeatureIndices[flatIndex] = static_cast<i32>(i);
+            }
+            // positions of the next values of the used columns
+            TVector<size_t> columnCursors;
+            if (features.ColumnMajor) {
+                for (const auto& feature : usedFeatures) {
+                    columnCursors.push_back(features.Offsets[feature.FlatIndex]);
+                }
+            }
+
+            const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+            auto calcTrees = GetCalcTreesFunction(trees, blockSize);
+            TVector<TCalcerIndexType> indexesVec(blockSize);
+            TVector<ui8> blockBins(blockSize * bucketCount);
+            TCPUEvaluatorQuantizedData quantizedData;
+            quantizedData.QuantizedData = TMaybeOwningArrayHolder<ui8>::CreateNonOwning(blockBins);
+            TEvalResultProcessor resultProcessor(
+                docCount,
+                results,
+                predictionType,
+                trees.GetDimensionsCount(),
+                blockSize
+            );
+            ui32 blockId = 0;
+            for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+                const size_t docCountInBlock = Min(blockSize, docCount - blockStart);
+                for (auto bucketId : xrange(bucketCount)) {
+                    std::fill_n(blockBins.data() + bucketId * docCountInBlock, docCountInBlock, defaultBins[bucketId]);
+                }
+                auto binarizeValue = [&] (const TSparseFloatFeatureBinarization& feature, size_t docId, float value) {
+                    if (IsNan(value)) {
+                        value = feature.NanSubstitution;
+                    }
+                    BinarizeFloatValue(
+                        value,
+                        feature.Borders,
+                        docCountInBlock,
+                        blockBins.data() + feature.BucketOffset * docCountInBlock + docId
+                    );
+                };
+                if (features.ColumnMajor) {
+                    const size_t blockEnd = blockStart + docCountInBlock;
+                    for (auto i : xrange(usedFeatures.size())) {
+                        const auto& feature = usedFeatures[i];
+                        const size_t columnEnd = features.Offsets[feature.FlatIndex + 1];
+                        size_t& cursor = columnCursors[i];
+                        for (; cursor < columnEnd && features.Indices[cursor] < blockEnd; ++cursor) {
+                            CB_ENSURE(
+                                features.Indices[cursor] >= blockStart,
+                                "Object indices of sparse column " << feature.FlatIndex << " should be sorted"
+                            );
+                            binarizeValue(feature, features.Indices[cursor] - blockStart, features.Values[cursor]);
+                        }
+                    }
+                } else {
+                    for (auto docId : xrange(docCountInBlock)) {
+                        const size_t objectIdx = blockStart + docId;
+                        for (size_t pos = features.Offsets[objectIdx]; pos < features.Offsets[objectIdx + 1]; ++pos) {
+                            const ui32 flatIndex = features.Indices[pos];
+                            if (flatIndex < usedFeatureIndices.size() && usedFeatureIndices[flatIndex] >= 0) {
+                                binarizeValue(usedFeatures[usedFeatureIndices[flatIndex]], docId, features.Values[pos]);
+                            }
+                        }
+                    }
+                }
+                auto blockResultsView = resultProcessor.GetViewForRawEvaluation(blockId);
+                calcTrees(
+                    trees,
+                    &quantizedData,
+                    docCountInBlock,
+                    docCount == 1 ? nullptr : indexesVec.data(),
+                    treeStart,
+                    treeEnd,
+                    blockResultsView.data()
+                );
+                resultProcessor.PostprocessBlock(blockId);
+                ++blockId;
+            }
+        }
+
+        // counters of the evaluator shared by concurrent calls, a copy starts collecting from zero
+        class TEvaluationCountersAccumulator {
+        public:
+            TEvaluationCountersAccumulator() = default;
+
+            TEvaluationCountersAccumulator(const TEvaluationCountersAccumulator& other)
+                : Enabled(other.IsEnabled())
+            {}
+
+            bool IsEnabled() const {
+                return Enabled.load(std::memory_order_relaxed);
+            }
+
+            void SetEnabled(bool enabled) {
+                Enabled.store(enabled, std::memory_order_relaxed);
+            }
+
+            void Add(const TEvaluationCounters& counters) {
+                TGuard<TAdaptiveLock> guard(Lock);
+                Counters += counters;
+            }
+
+            TEvaluationCounters Get() const {
+                TGuard<TAdaptiveLock> guard(Lock);
+                return Counters;
+            }
+
+            void Reset() {
+                TGuard<TAdaptiveLock> guard(Lock);
+                Counters = TEvaluationCounters();
+            }
+
+        private:
+            std::atomic<bool> Enabled{false};
+            TAdaptiveLock Lock;
+            TEvaluationCounters Counters;
+        };
+
+        // counters of a single evaluation call, added to the accumulated ones at the end of the call
+        class TEvaluationCountersCollector {
+        public:
+            explicit TEvaluationCountersCollector(TEvaluationCountersAccumulator* accumulator)
+                : Accumulator(accumulator->IsEnabled() ? accumulator : nullptr)
+            {}
+
+            ~TEvaluationCountersCollector() {
+                if (Accumulator) {
+                    Accumulator->Add(CallCounters);
+                }
+            }
+
+            TEvaluationCounters* GetCallCounters() {
+                return Accumulator ? &CallCounters : nullptr;
+            }
+
+        private:
+            TEvaluationCountersAccumulator* Accumulator;
+            TEvaluationCounters CallCounters;
+        };
+
         class TCpuEvaluator final : public IModelEvaluator {
         public:
             explicit TCpuEvaluator(const TFullModel& fullModel)
                 : ObliviousTrees(fullModel.ObliviousTrees)
                 , CtrProvider(fullModel.CtrProvider)
                 , TextProcessingCollection(fullModel.TextProcessingCollection)
-            {}
+            {
+                if (ObliviousTrees->GetDimensionsCount() == 1) {
+                    CalcRemainingLeafValueBounds();
+                }
+            }
 
             void SetPredictionType(EPredictionType type) override {
                 PredictionType = type;
@@ -95,8 +484,35 @@ namespace NCB::NModelEvaluation {
             }
 
             void SetProperty(const TStringBuf propName, const TStringBuf propValue) override {
-                CB_ENSURE(false, "CPU evaluator don't have any properties. Got: " << propName);
-                Y_UNUSED(propValue);
+                if (propName == "CollectCounters") {
+                    Counters.SetEnabled(FromString<bool>(propValue));
+                } else if (propName == "ResetCounters") {
+                    Counters.Reset();
+                } else {
+                    CB_ENSURE(false, "CPU evaluator don't have property " << propName);
+                }
+            }
+
+            TString GetProperty(const TStringBuf propName) const override {
+                if (propName == "CollectCounters") {
+                    return ToString(Counters.IsEnabled());
+                }
+                const TEvaluationCounters counters = Counters.Get();
+                const std::pair<TStringBuf, ui64> counterValues[] = {
+                    {"ObjectCount", counters.ObjectCount},
+                    {"BlockCount", counters.BlockCount},
+                    {"BinarizationNs", counters.BinarizationNs},
+                    {"CtrCalcNs", counters.CtrCalcNs},
+                    {"TextProcessingNs", counters.TextProcessingNs},
+                    {"TreeTraversalNs", counters.TreeTraversalNs},
+                    {"CtrHashMissCount", counters.CtrHashMissCount}
+                };
+                for (const auto& [counterName, counterValue] : counterValues) {
+                    if (counterName == propName) {
+                        return ToString(counterValue);
+                    }
+                }
+                CB_ENSURE(false, "CPU evaluator don't have property " << propName);
             }
 
             void CalcFlatTransposed(
@@ -141,6 +557,7 @@ namespace NCB::NModelEvaluation {
                 }
 
                 CB_ENSURE(docCount.Defined(), "couldn't determine document count, something went wrong");
+                TEvaluationCountersCollector countersCollector(&Counters);
                 CalcGeneric(
                     *ObliviousTrees,
                     CtrProvider,
@@ -157,7 +574,8 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    countersCollector.GetCallCounters()
                 );
             }
 
@@ -185,6 +603,7 @@ namespace NCB::NModelEvaluation {
                         "insufficient flat features vector size: " << flatFeaturesVec.size() << " expected: " << expectedFlatVecSize
                     );
                 }
+                TEvaluationCountersCollector countersCollector(&Counters);
                 CalcGeneric(
                     *ObliviousTrees,
                     CtrProvider,
@@ -201,6 +620,94 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
+                    featureInfo,
+                    countersCollector.GetCallCounters()
+                );
+            }
+
+            TEarlyExitStats CalcFlatWithEarlyExit(
+                TConstArrayRef<TConstArrayRef<float>> features,
+                const TEarlyExitParams& params,
+                TArrayRef<double> results,
+                TArrayRef<bool> isDropped,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                if (!featureInfo) {
+                    featureInfo = ExtFeatureLayout.Get();
+                }
+                CB_ENSURE(
+                    ObliviousTrees->GetDimensionsCount() == 1,
+                    "Early exit evaluation is supported only for single dimension models"
+                );
+                CB_ENSURE(
+                    PredictionType == EPredictionType::RawFormulaVal,
+                    "Early exit evaluation supports only " << EPredictionType::RawFormulaVal << " prediction type"
+                );
+                CB_ENSURE(
+                    ObliviousTrees->GetTextFeatures().empty(),
+                    "Early exit evaluation is not implemented for models with text features"
+                );
+                CB_ENSURE(params.TreeBlockSize > 0, "Tree block size should be positive");
+                CB_ENSURE(
+                    results.size() == features.size() && isDropped.size() == features.size(),
+                    "Results and dropped flags should have an element per object"
+                );
+                if (params.TopSize > 0) {
+                    CB_ENSURE(
+                        Accumulate(params.GroupSizes, size_t(0)) == features.size(),
+                        "Group sizes should sum up to the object count"
+                    );
+                }
+                auto expectedFlatVecSize = ObliviousTrees->GetFlatFeatureVectorExpectedSize();
+                if (featureInfo && featureInfo->FlatIndexes) {
+                    expectedFlatVecSize = *MaxElement(featureInfo->FlatIndexes->begin(), featureInfo->FlatIndexes->end());
+                }
+                for (const auto& flatFeaturesVec : features) {
+                    CB_ENSURE(
+                        flatFeaturesVec.size() >= expectedFlatVecSize,
+                        "insufficient flat features vector size: " << flatFeaturesVec.size() << " expected: " << expectedFlatVecSize
+                    );
+                }
+                return CalcGenericWithEarlyExit(
+                    *ObliviousTrees,
+                    CtrProvider,
+                    RemainingMinLeafValueSums,
+                    RemainingMaxLeafValueSums,
+                    [&features](TFeaturePosition position, size_t index) -> float {
+                        return features[index][position.FlatIndex];
+                    },
+                    [&features](TFeaturePosition position, size_t index) -> int {
+                        return ConvertFloatCatFeatureToIntHash(features[index][position.FlatIndex]);
+                    },
+                    features.size(),
+                    params,
+                    results,
+                    isDropped,
+                    featureInfo
+                );
+            }
+
+            void CalcFlatSparse(
+                const TSparseFloatFeatures& features,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                if (!featureInfo) {
+                    featureInfo = ExtFeatureLayout.Get();
+                }
+                CB_ENSURE(
+                    ObliviousTrees->GetUsedCatFeaturesCount() == 0 && ObliviousTrees->GetUsedTextFeaturesCount() == 0,
+                    "Sparse features evaluation is supported only for models without categorical and text features"
+                );
+                CalcSparseGeneric(
+                    *ObliviousTrees,
+                    features,
+                    treeStart,
+                    treeEnd,
+                    PredictionType,
+                    results,
                     featureInfo
                 );
             }
@@ -219,6 +726,7 @@ namespace NCB::NModelEvaluation {
                     ObliviousTrees->GetFlatFeatureVectorExpectedSize() <= features.size(),
                     "Not enough features provided"
                 );
+                TEvaluationCountersCollector countersCollector(&Counters);
                 CalcGeneric(
                     *ObliviousTrees,
                     CtrProvider,
@@ -235,7 +743,8 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    countersCollector.GetCallCounters()
                 );
             }
 
@@ -276,6 +785,7 @@ namespace NCB::NModelEvaluation {
                 }
                 ValidateInputFeatures(floatFeatures, catFeatures, textFeatures, featureInfo);
                 const size_t docCount = Max(catFeatures.size(), floatFeatures.size());
+                TEvaluationCountersCollector countersCollector(&Counters);
                 CalcGeneric(
                     *ObliviousTrees,
                     CtrProvider,
@@ -294,7 +804,8 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    countersCollector.GetCallCounters()
                 );
             }
 
@@ -335,6 +846,7 @@ namespace NCB::NModelEvaluation {
                 }
                 ValidateInputFeatures(floatFeatures, catFeatures, textFeatures, featureInfo);
                 const size_t docCount = Max(catFeatures.size(), floatFeatures.size(), textFeatures.size());
+                TEvaluationCountersCollector countersCollector(&Counters);
                 CalcGeneric(
                     *ObliviousTrees,
                     CtrProvider,
@@ -353,7 +865,8 @@ namespace NCB::NModelEvaluation {
                     treeEnd,
                     PredictionType,
                     results,
-                    featureInfo
+                    featureInfo,
+                    countersCollector.GetCallCounters()
                 );
             }
 
@@ -424,11 +937,12 @@ namespace NCB::NModelEvaluation {
             ) const override {
                 const TCPUEvaluatorQuantizedData* cpuQuantizedFeatures = reinterpret_cast<const TCPUEvaluatorQuantizedData*>(quantizedFeatures);
                 CB_ENSURE(cpuQuantizedFeatures != nullptr, "Expected pointer to TCPUEvaluatorQuantizedData");
-                if (ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount() != 0) {
+                const size_t bucketCount = GetBinFeaturesBucketCount(*ObliviousTrees, cpuQuantizedFeatures);
+                if (bucketCount != 0) {
                     CB_ENSURE(
-                        cpuQuantizedFeatures->BlockStride % ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount() == 0,
+                        cpuQuantizedFeatures->BlockStride % bucketCount == 0,
                         "Unexpected block stride: " << cpuQuantizedFeatures->BlockStride
-                        << " (EffectiveBinaryFeaturesBucketsCount == " << ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount() << " )"
+                        << " (BinaryFeaturesBucketsCount == " << bucketCount << " )"
                     );
                 }
                 CB_ENSURE(cpuQuantizedFeatures->BlocksCount * FORMULA_EVALUATION_BLOCK_SIZE >= cpuQuantizedFeatures->ObjectsCount);
@@ -464,11 +978,12 @@ namespace NCB::NModelEvaluation {
             ) const override {
                 const TCPUEvaluatorQuantizedData* cpuQuantizedFeatures = reinterpret_cast<const TCPUEvaluatorQuantizedData*>(quantizedFeatures);
                 CB_ENSURE(cpuQuantizedFeatures != nullptr, "Expected pointer to TCPUEvaluatorQuantizedData");
-                if (ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount() != 0) {
+                const size_t bucketCount = GetBinFeaturesBucketCount(*ObliviousTrees, cpuQuantizedFeatures);
+                if (bucketCount != 0) {
                     CB_ENSURE(
-                        cpuQuantizedFeatures->BlockStride % ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount() == 0,
+                        cpuQuantizedFeatures->BlockStride % bucketCount == 0,
                         "Unexpected block stride: " << cpuQuantizedFeatures->BlockStride
-                        << " (EffectiveBinaryFeaturesBucketsCount == " << ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount() << " )"
+                        << " (BinaryFeaturesBucketsCount == " << bucketCount << " )"
                     );
                 }
                 CB_ENSURE(cpuQuantizedFeatures->BlocksCount * FORMULA_EVALUATION_BLOCK_SIZE >= cpuQuantizedFeatures->ObjectsCount);
@@ -575,6 +1090,28 @@ namespace NCB::NModelEvaluation {
                 }
             }
 
+            // suffix sums of per tree minimal and maximal leaf values: bounds on what trees [treeId, treeCount) can add
+            void CalcRemainingLeafValueBounds() {
+                const size_t treeCount = ObliviousTrees->GetTreeCount();
+                RemainingMinLeafValueSums.assign(treeCount + 1, 0.0);
+                RemainingMaxLeafValueSums.assign(treeCount + 1, 0.0);
+                if (treeCount == 0) {
+                    return;
+                }
+                const auto& leafValues = ObliviousTrees->GetLeafValues();
+                const auto& firstLeafOffsets = ObliviousTrees->GetFirstLeafOffsets();
+                const auto treeLeafCounts = ObliviousTrees->GetTreeLeafCounts();
+                for (size_t treeId = treeCount; treeId > 0; --treeId) {
+                    const auto treeLeafValuesBegin = leafValues.begin() + firstLeafOffsets[treeId - 1];
+                    const auto [minLeafValue, maxLeafValue] = std::minmax_element(
+                        treeLeafValuesBegin,
+                        treeLeafValuesBegin + treeLeafCounts[treeId - 1]
+                    );
+                    RemainingMinLeafValueSums[treeId - 1] = RemainingMinLeafValueSums[treeId] + *minLeafValue;
+                    RemainingMaxLeafValueSums[treeId - 1] = RemainingMaxLeafValueSums[treeId] + *maxLeafValue;
+                }
+            }
+
             static TStringBuf TextFeatureAccessorStub(TFeaturePosition position, size_t index) {
                 Y_UNUSED(position, index);
                 CB_ENSURE(false, "This type of apply interface is not implemented with text features yet");
@@ -585,6 +1122,9 @@ namespace NCB::NModelEvaluation {
             const TIntrusivePtr<TTextProcessingCollection> TextProcessingCollection;
             EPredictionType PredictionType = EPredictionType::RawFormulaVal;
             TMaybe<TFeatureLayout> ExtFeatureLayout;
+            TVector<double> RemainingMinLeafValueSums;
+            TVector<double> RemainingMaxLeafValueSums;
+            mutable TEvaluationCountersAccumulator Counters;
         };
     }
 
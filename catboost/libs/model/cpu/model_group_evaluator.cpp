@@ -0,0 +1,158 @@
+#include "model_group_evaluator.h"
+
+#include "evaluator.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/hash.h>
+#include <util/generic/map.h>
+#include <util/generic/xrange.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace NCB::NModelEvaluation {
+    static TVector<TFloatFeature> MergeFloatFeatures(TConstArrayRef<const TFullModel*> models) {
+        TMap<int, TFloatFeature> indexToFeature;
+        THashMap<int, size_t> indexToUsingModelCount;
+        // exclusive bundles are specific to a model learn set, so bundle ids of different models are made distinct
+        int bundleIdOffset = 0;
+        for (const auto* model : models) {
+            int maxBundleId = -1;
+            for (const auto& modelFeature : model->ObliviousTrees->GetFloatFeatures()) {
+                TFloatFeature feature = modelFeature;
+                if (feature.ExclusiveBundleId >= 0) {
+                    maxBundleId = Max(maxBundleId, feature.ExclusiveBundleId);
+                    feature.ExclusiveBundleId += bundleIdOffset;
+                }
+                if (feature.UsedInModel()) {
+                    ++indexToUsingModelCount[feature.Position.Index];
+                }
+                auto [it, inserted] = indexToFeature.emplace(feature.Position.Index, feature);
+                if (inserted) {
+                    continue;
+                }
+                auto& mergedFeature = it->second;
+                CB_ENSURE(
+                    mergedFeature.Position == feature.Position,
+                    "Float feature " << feature.Position.Index << " flat index mismatch: "
+                    << mergedFeature.Position.FlatIndex << " != " << feature.Position.FlatIndex
+                );
+                if (!feature.UsedInModel()) {
+                    continue;
+                }
+                if (!mergedFeature.UsedInModel()) {
+                    mergedFeature = feature;
+                    continue;
+                }
+                CB_ENSURE(
+                    mergedFeature.NanValueTreatment == feature.NanValueTreatment,
+                    "Nan value treatment differs for float feature " << feature.Position.Index
+                );
+                // without HasNans nans are not substituted and fall into the first bin, as with AsFalse treatment
+                CB_ENSURE(
+                    mergedFeature.HasNans == feature.HasNans ||
+                    feature.NanValueTreatment != TFloatFeature::ENanValueTreatment::AsTrue,
+                    "Nan values of float feature " << feature.Position.Index << " are binarized differently by the models"
+                );
+                mergedFeature.HasNans |= feature.HasNans;
+                TVector<float> borders;
+                std::set_union(
+                    mergedFeature.Borders.begin(),
+                    mergedFeature.Borders.end(),
+                    feature.Borders.begin(),
+                    feature.Borders.end(),
+                    std::back_inserter(borders)
+                );
+                mergedFeature.Borders = std::move(borders);
+            }
+            bundleIdOffset += maxBundleId + 1;
+        }
+        TVector<TFloatFeature> floatFeatures;
+        for (auto& [index, feature] : indexToFeature) {
+            const auto usingModelCount = indexToUsingModelCount.find(index);
+            if (usingModelCount == indexToUsingModelCount.end() || usingModelCount->second != 1) {
+                feature.ExclusiveBundleId = -1;
+            }
+            floatFeatures.push_back(std::move(feature));
+        }
+        return floatFeatures;
+    }
+
+    TModelGroupEvaluator::TModelGroupEvaluator(TConstArrayRef<const TFullModel*> models) {
+        CB_ENSURE(!models.empty(), "Model group should not be empty");
+        for (const auto* model : models) {
+            CB_ENSURE(
+                model->ObliviousTrees->GetUsedCatFeaturesCount() == 0 &&
+                model->ObliviousTrees->GetUsedTextFeaturesCount() == 0,
+                "Shared binarization is supported only for models with float features"
+            );
+        }
+        const auto floatFeatures = MergeFloatFeatures(models);
+        for (const auto* model : models) {
+            Trees.push_back(*model->ObliviousTrees);
+            Trees.back().ExtendFloatFeaturesBorders(floatFeatures);
+        }
+        Y_ASSERT(AllOf(Trees, [&] (const TObliviousTrees& trees) {
+            return trees.GetEffectiveBinaryFeaturesBucketsCount() == Trees[0].GetEffectiveBinaryFeaturesBucketsCount();
+        }));
+    }
+
+    TVector<TVector<double>> TModelGroupEvaluator::CalcFlat(TConstArrayRef<TConstArrayRef<float>> features) const {
+        const size_t docCount = features.size();
+        TVector<TVector<double>> results;
+        for (const auto& trees : Trees) {
+            results.emplace_back(docCount * trees.GetDimensionsCount(), 0.0);
+        }
+        if (docCount == 0) {
+            return results;
+        }
+        // all the trees have the same float features, the first ones define binarization
+        const TObliviousTrees& sharedTrees = Trees[0];
+        const size_t expectedFlatVecSize = sharedTrees.GetFlatFeatureVectorExpectedSize();
+        for (const auto& flatFeaturesVec : features) {
+            CB_ENSURE(
+                flatFeaturesVec.size() >= expectedFlatVecSize,
+                "insufficient flat features vector size: " << flatFeaturesVec.size() << " expected: " << expectedFlatVecSize
+            );
+        }
+        const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+        TVector<TTreeCalcFunction> calcTreesFunctions;
+        for (const auto& trees : Trees) {
+            calcTreesFunctions.push_back(GetCalcTreesFunction(trees, blockSize));
+        }
+        TVector<TCalcerIndexType> indexesVec(blockSize);
+        size_t blockStart = 0;
+        ProcessDocsInBlocks(
+            sharedTrees,
+            /*ctrProvider*/ nullptr,
+            [&features](TFeaturePosition position, size_t index) -> float {
+                return features[index][position.FlatIndex];
+            },
+            [](TFeaturePosition, size_t) -> int {
+                CB_ENSURE_INTERNAL(false, "Model group has no categorical features");
+                return 0;
+            },
+            docCount,
+            blockSize,
+            [&] (size_t docCountInBlock, const TCPUEvaluatorQuantizedData* quantizedData) {
+                for (auto modelIdx : xrange(Trees.size())) {
+                    const auto& trees = Trees[modelIdx];
+                    calcTreesFunctions[modelIdx](
+                        trees,
+                        quantizedData,
+                        docCountInBlock,
+                        docCount == 1 ? nullptr : indexesVec.data(),
+                        0,
+                        trees.GetTreeCount(),
+                        results[modelIdx].data() + blockStart * trees.GetDimensionsCount()
+                    );
+                }
+                blockStart += docCountInBlock;
+            },
+            /*featureInfo*/ nullptr
+        );
+        return results;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <catboost/libs/model/model.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+
+namespace NCB::NModelEvaluation {
+    /**
+     * Applies several models to the same objects with the shared binarization: float features borders of
+     * all models are merged, every block of objects is binarized once and all the models trees are
+     * evaluated over the same bins. Models should have float features only.
+     */
+    class TModelGroupEvaluator {
+    public:
+        explicit TModelGroupEvaluator(TConstArrayRef<const TFullModel*> models);
+
+        size_t GetModelCount() const {
+            return Trees.size();
+        }
+
+        /**
+         * @return raw formula values [modelIdx][objectIdx * modelDimensionsCount + dimension]
+         */
+        TVector<TVector<double>> CalcFlat(TConstArrayRef<TConstArrayRef<float>> features) const;
+
+    private:
+        // models trees over the merged float features, so they share binarization layout
+        TVector<TObliviousTrees> Trees;
+    };
+}
@@ -8,13 +8,30 @@
 
 #include <library/sse/sse.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/hash.h>
+#include <util/generic/maybe.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
+#include <util/system/hp_timer.h>
 
 namespace NCB::NModelEvaluation {
     constexpr size_t FORMULA_EVALUATION_BLOCK_SIZE = 128;
 
+    // timer of an evaluation stage, started only if counters are collected
+    inline TMaybe<THPTimer> StartStageTimer(const TEvaluationCounters* counters) {
+        if (!counters) {
+            return Nothing();
+        }
+        return MakeMaybe<THPTimer>();
+    }
+
+    inline ui64 GetPassedNs(const TMaybe<THPTimer>& timer) {
+        return static_cast<ui64>(timer->Passed() * 1e9);
+    }
+
     class TCPUEvaluatorQuantizedData final : public IQuantizedData {
     public:
         TCPUEvaluatorQuantizedData() = default;
@@ -27,12 +44,15 @@ namespace NCB::NModelEvaluation {
         size_t ObjectsCount = 0;
         size_t BlocksCount = 0;
         size_t BlockStride = 0;
+        // float features from the model exclusive bundles are stored one byte per bundle
+        bool HasBundledFloatFeatures = false;
         TMaybeOwningArrayHolder<ui8> QuantizedData;
 
         TCPUEvaluatorQuantizedData ExtractBlock(size_t blockId) const {
             TCPUEvaluatorQuantizedData result;
             result.BlocksCount = 1;
-            size_t width = QuantizedData.GetSize() / ObjectsCount;
+            result.HasBundledFloatFeatures = HasBundledFloatFeatures;
+            size_t width = BlockStride / FORMULA_EVALUATION_BLOCK_SIZE;
 
             result.ObjectsCount = Min(
                 FORMULA_EVALUATION_BLOCK_SIZE, ObjectsCount - FORMULA_EVALUATION_BLOCK_SIZE * (blockId));
@@ -51,6 +71,22 @@ namespace NCB::NModelEvaluation {
         }
     };
 
+    inline const TVector<TRepackedBin>& GetRepackedBins(
+        const TObliviousTrees& trees,
+        const TCPUEvaluatorQuantizedData* quantizedData
+    ) {
+        return quantizedData->HasBundledFloatFeatures ? trees.GetBundledRepackedBins() : trees.GetRepackedBins();
+    }
+
+    inline size_t GetBinFeaturesBucketCount(
+        const TObliviousTrees& trees,
+        const TCPUEvaluatorQuantizedData* quantizedData
+    ) {
+        return quantizedData->HasBundledFloatFeatures ?
+            trees.GetBundledBinaryFeaturesBucketsCount() :
+            trees.GetEffectiveBinaryFeaturesBucketsCount();
+    }
+
     inline void OneHotBinsFromTransposedCatFeatures(
         const TConstArrayRef<TOneHotFeature> OneHotFeatures,
         const THashMap<int, int> catFeaturePackedIndex,
@@ -258,11 +294,122 @@ namespace NCB::NModelEvaluation {
 
 #endif
 
-/**
-* This function binarizes
-*/
-    template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor, typename TTextFeatureAccessor>
-    inline void BinarizeFeatures(
+    /**
+     * Binarize a single value: bucket values are written to result, result + stride and so on,
+     * one per MAX_VALUES_PER_BIN borders, same as BinarizeFloats does for a column
+     */
+    inline void BinarizeFloatValue(
+        float value,
+        const TConstArrayRef<float> borders,
+        size_t stride,
+        ui8* result
+    ) {
+        // NaN is not greater than any border, LowerBound returns begin for it as well
+        const size_t smallerBorderCount = LowerBound(borders.begin(), borders.end(), value) - borders.begin();
+        for (size_t blockStart = 0; blockStart < borders.size(); blockStart += MAX_VALUES_PER_BIN) {
+            const size_t blockEnd = Min(blockStart + MAX_VALUES_PER_BIN, borders.size());
+            *result = (ui8)(ClampVal(smallerBorderCount, blockStart, blockEnd) - blockStart);
+            result += stride;
+        }
+    }
+
+    template <typename TFloatFeatureAccessor>
+    Y_FORCE_INLINE void BinarizeFloatFeature(
+        const TFloatFeature& floatFeature,
+        TFeaturePosition position,
+        size_t docCount,
+        TFloatFeatureAccessor floatAccessor,
+        size_t start,
+        ui8*& result
+    ) {
+        if (!floatFeature.HasNans ||
+            floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsIs) {
+            BinarizeFloats<false>(
+                position,
+                docCount,
+                floatAccessor,
+                floatFeature.Borders,
+                start,
+                result
+            );
+        } else {
+            const float infinity = std::numeric_limits<float>::infinity();
+            if (floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsFalse) {
+                BinarizeFloats<true>(
+                    position,
+                    docCount,
+                    floatAccessor,
+                    floatFeature.Borders,
+                    start,
+                    result,
+                    -infinity
+                );
+            } else {
+                Y_ASSERT(floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsTrue);
+                BinarizeFloats<true>(
+                    position,
+                    docCount,
+                    floatAccessor,
+                    floatFeature.Borders,
+                    start,
+                    result,
+                    infinity
+                );
+            }
+        }
+    }
+
+    /**
+     * Writes one bucket per exclusive bundle: 1-based index of the bundle feature with the value greater
+     * than its border or 0. Returns false if some document has several such features.
+     */
+    template <typename TFloatFeatureAccessor>
+    inline bool BinarizeFloatFeatureBundles(
+        const TObliviousTrees& trees,
+        size_t docCount,
+        TFloatFeatureAccessor floatAccessor,
+        size_t start,
+        ui8*& result,
+        const TFeatureLayout* featureInfo
+    ) {
+        Y_ASSERT(docCount <= FORMULA_EVALUATION_BLOCK_SIZE);
+        ui8 featureBins[FORMULA_EVALUATION_BLOCK_SIZE];
+        for (const auto& bundle : trees.GetFloatFeatureBundles()) {
+            for (auto inBundleIdx : xrange(bundle.size())) {
+                const auto& floatFeature = trees.GetFloatFeatures()[bundle[inBundleIdx]];
+                TFeaturePosition position = floatFeature.Position;
+                if (featureInfo) {
+                    position = featureInfo->GetRemappedPosition(floatFeature);
+                }
+                std::fill_n(featureBins, docCount, 0);
+                ui8* featureBinsPtr = featureBins;
+                BinarizeFloatFeature(floatFeature, position, docCount, floatAccessor, start, featureBinsPtr);
+                const ui8 valueInBundle = static_cast<ui8>(inBundleIdx + 1);
+                for (size_t docId = 0; docId < docCount; ++docId) {
+                    if (featureBins[docId] != 0) {
+                        if (result[docId] != 0) {
+                            return false;
+                        }
+                        result[docId] = valueInBundle;
+                    }
+                }
+            }
+            result += docCount;
+        }
+        return true;
+    }
+
+    /**
+     * Binarizes features in the ordinary or in the bundled layout.
+     * Returns false if features are not exclusive for some document and bundled layout can't be used.
+     */
+    template <
+        bool UseBundles,
+        typename TFloatFeatureAccessor,
+        typename TCatFeatureAccessor,
+        typename TTextFeatureAccessor
+    >
+    inline bool BinarizeFeaturesInLayout(
         const TObliviousTrees& trees,
         const TIntrusivePtr<ICtrProvider>& ctrProvider,
         const TIntrusivePtr<TTextProcessingCollection>& textProcessingCollection,
@@ -275,15 +422,19 @@ namespace NCB::NModelEvaluation {
         TArrayRef<ui32> transposedHash,
         TArrayRef<float> ctrs,
         TArrayRef<float> estimatedFeatures,
-        const TFeatureLayout* featureInfo = nullptr
+        const TFeatureLayout* featureInfo,
+        TEvaluationCounters* counters
     ) {
         const auto fullDocCount = end - start;
         auto result = *(cpuEvaluatorQuantizedData->QuantizedData);
+        // bundled layout takes no more space than the ordinary one
         auto expectedQuantizedFeaturesLen = trees.GetEffectiveBinaryFeaturesBucketsCount() * fullDocCount;
         CB_ENSURE(result.size() >= expectedQuantizedFeaturesLen, "Not enough space to store quantized features");
         cpuEvaluatorQuantizedData->BlocksCount = 0;
-        cpuEvaluatorQuantizedData->BlockStride =
-            trees.GetEffectiveBinaryFeaturesBucketsCount() * FORMULA_EVALUATION_BLOCK_SIZE;
+        cpuEvaluatorQuantizedData->HasBundledFloatFeatures = UseBundles;
+        cpuEvaluatorQuantizedData->BlockStride = (UseBundles ?
+            trees.GetBundledBinaryFeaturesBucketsCount() :
+            trees.GetEffectiveBinaryFeaturesBucketsCount()) * FORMULA_EVALUATION_BLOCK_SIZE;
         cpuEvaluatorQuantizedData->ObjectsCount = fullDocCount;
         ui8* resultPtr = result.data();
         std::fill(result.begin(), result.begin() + expectedQuantizedFeaturesLen, 0);
@@ -291,48 +442,20 @@ namespace NCB::NModelEvaluation {
             ui8* resultPtrForBlockStart = resultPtr;
             ++cpuEvaluatorQuantizedData->BlocksCount;
             auto docCount = Min(end - start, FORMULA_EVALUATION_BLOCK_SIZE);
-            for (const auto& floatFeature : trees.GetFloatFeatures()) {
-                if (!floatFeature.UsedInModel()) {
+            for (auto floatFeatureIdx : xrange(trees.GetFloatFeatures().size())) {
+                const auto& floatFeature = trees.GetFloatFeatures()[floatFeatureIdx];
+                if (!floatFeature.UsedInModel() || (UseBundles && trees.IsFloatFeatureBundled(floatFeatureIdx))) {
                     continue;
                 }
                 TFeaturePosition position = floatFeature.Position;
                 if (featureInfo) {
                     position = featureInfo->GetRemappedPosition(floatFeature);
                 }
-                if (!floatFeature.HasNans ||
-                    floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsIs) {
-                    BinarizeFloats<false>(
-                        position,
-                        docCount,
-                        floatAccessor,
-                        floatFeature.Borders,
-                        start,
-                        resultPtr
-                    );
-                } else {
-                    const float infinity = std::numeric_limits<float>::infinity();
-                    if (floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsFalse) {
-                        BinarizeFloats<true>(
-                            position,
-                            docCount,
-                            floatAccessor,
-                            floatFeature.Borders,
-                            start,
-                            resultPtr,
-                            -infinity
-                        );
-                    } else {
-                        Y_ASSERT(floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsTrue);
-                        BinarizeFloats<true>(
-                            position,
-                            docCount,
-                            floatAccessor,
-                            floatFeature.Borders,
-                            start,
-                            resultPtr,
-                            infinity
-                        );
-                    }
+                BinarizeFloatFeature(floatFeature, position, docCount, floatAccessor, start, resultPtr);
+            }
+            if constexpr (UseBundles) {
+                if (!BinarizeFloatFeatureBundles(trees, docCount, floatAccessor, start, resultPtr, featureInfo)) {
+                    return false;
                 }
             }
             if (trees.GetUsedTextFeaturesCount() > 0 &&
@@ -343,6 +466,7 @@ namespace NCB::NModelEvaluation {
                     "Fail to apply with text features: TextProcessingCollection must present in FullModel"
                 );
 
+                const auto textProcessingTimer = StartStageTimer(counters);
                 TVector<TStringBuf> texts;
                 texts.yresize(docCount);
 
@@ -396,6 +520,9 @@ namespace NCB::NModelEvaluation {
                         resultPtr
                     );
                 }
+                if (counters) {
+                    counters->TextProcessingNs += GetPassedNs(textProcessingTimer);
+                }
             }
             if (trees.GetUsedCatFeaturesCount() != 0) {
                 THashMap<int, int> catFeaturePackedIndexes;
@@ -425,13 +552,18 @@ namespace NCB::NModelEvaluation {
                     resultPtr
                 );
                 if (!trees.GetUsedModelCtrs().empty()) {
+                    const auto ctrCalcTimer = StartStageTimer(counters);
                     ctrProvider->CalcCtrs(
                         trees.GetUsedModelCtrs(),
                         TConstArrayRef<ui8>(resultPtrForBlockStart, docCount * trees.GetEffectiveBinaryFeaturesBucketsCount()),
                         transposedHash,
                         docCount,
-                        ctrs
+                        ctrs,
+                        counters ? &counters->CtrHashMissCount : nullptr
                     );
+                    if (counters) {
+                        counters->CtrCalcNs += GetPassedNs(ctrCalcTimer);
+                    }
                 }
                 size_t ctrFloatsPosition = 0;
                 for (const auto& ctr : trees.GetCtrFeatures()) {
@@ -448,6 +580,64 @@ namespace NCB::NModelEvaluation {
                 }
             }
         }
+        return true;
+    }
+
+/**
+* This function binarizes
+*/
+    template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor, typename TTextFeatureAccessor>
+    inline void BinarizeFeatures(
+        const TObliviousTrees& trees,
+        const TIntrusivePtr<ICtrProvider>& ctrProvider,
+        const TIntrusivePtr<TTextProcessingCollection>& textProcessingCollection,
+        TFloatFeatureAccessor floatAccessor,
+        TCatFeatureAccessor catFeatureAccessor,
+        TTextFeatureAccessor textFeatureAccessor,
+        size_t start,
+        size_t end,
+        TCPUEvaluatorQuantizedData* cpuEvaluatorQuantizedData,
+        TArrayRef<ui32> transposedHash,
+        TArrayRef<float> ctrs,
+        TArrayRef<float> estimatedFeatures,
+        const TFeatureLayout* featureInfo = nullptr,
+        TEvaluationCounters* counters = nullptr // if not null, text processing and CTRs calculation stages are accounted
+    ) {
+        if (!trees.GetFloatFeatureBundles().empty() && BinarizeFeaturesInLayout</*UseBundles*/true>(
+                trees,
+                ctrProvider,
+                textProcessingCollection,
+                floatAccessor,
+                catFeatureAccessor,
+                textFeatureAccessor,
+                start,
+                end,
+                cpuEvaluatorQuantizedData,
+                transposedHash,
+                ctrs,
+                estimatedFeatures,
+                featureInfo,
+                counters))
+        {
+            return;
+        }
+        // features of some bundle are not exclusive on these documents
+        BinarizeFeaturesInLayout</*UseBundles*/false>(
+            trees,
+            ctrProvider,
+            textProcessingCollection,
+            floatAccessor,
+            catFeatureAccessor,
+            textFeatureAccessor,
+            start,
+            end,
+            cpuEvaluatorQuantizedData,
+            transposedHash,
+            ctrs,
+            estimatedFeatures,
+            featureInfo,
+            counters
+        );
     }
 
 /**
@@ -473,6 +663,7 @@ namespace NCB::NModelEvaluation {
         cpuEvaluatorQuantizedData->BlockStride =
             trees.GetEffectiveBinaryFeaturesBucketsCount() * FORMULA_EVALUATION_BLOCK_SIZE;
         cpuEvaluatorQuantizedData->BlocksCount = 0;
+        cpuEvaluatorQuantizedData->HasBundledFloatFeatures = false;
         cpuEvaluatorQuantizedData->ObjectsCount = end - start;
         for (; start < end; start += FORMULA_EVALUATION_BLOCK_SIZE) {
             size_t blockEnd = Min(start + FORMULA_EVALUATION_BLOCK_SIZE, end);
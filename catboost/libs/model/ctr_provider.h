@@ -29,7 +29,8 @@ public:
         const TConstArrayRef<ui8>& binarizedFeatures, // vector of binarized float & one hot features
         const TConstArrayRef<ui32>& hashedCatFeatures,
         size_t docCount,
-        TArrayRef<float> result) = 0;
+        TArrayRef<float> result,
+        ui64* hashMissCount = nullptr) = 0; // if not null, incremented by the count of calculated values with hash absent in ctr tables
 
     virtual void SetupBinFeatureIndexes(
         const TConstArrayRef<TFloatFeature> floatFeatures,
@@ -76,6 +76,10 @@ namespace NCB::NModelEvaluation {
                 }
             }
 
+            TString GetProperty(const TStringBuf propName) const override {
+                CB_ENSURE(false, "GPU evaluator don't have property " << propName);
+            }
+
             EPredictionType GetPredictionType() const override {
                 return PredictionType;
             }
@@ -1,7 +1,31 @@
 #include "evaluation_interface.h"
 
+#include <catboost/libs/helpers/exception.h>
+
 
 namespace NCB::NModelEvaluation {
+    TEarlyExitStats IModelEvaluator::CalcFlatWithEarlyExit(
+        TConstArrayRef<TConstArrayRef<float>> features,
+        const TEarlyExitParams& params,
+        TArrayRef<double> results,
+        TArrayRef<bool> isDropped,
+        const TFeatureLayout* featureInfo
+    ) const {
+        Y_UNUSED(features, params, results, isDropped, featureInfo);
+        CB_ENSURE(false, "Early exit evaluation is not supported by this evaluator");
+    }
+
+    void IModelEvaluator::CalcFlatSparse(
+        const TSparseFloatFeatures& features,
+        size_t treeStart,
+        size_t treeEnd,
+        TArrayRef<double> results,
+        const TFeatureLayout* featureInfo
+    ) const {
+        Y_UNUSED(features, treeStart, treeEnd, results, featureInfo);
+        CB_ENSURE(false, "Sparse features evaluation is not supported by this evaluator");
+    }
+
     TModelEvaluatorPtr CreateEvaluator(EFormulaEvaluatorType formualEvaluatorType, const TFullModel& model) {
         return TEvaluationBackendFactory::Construct(formualEvaluatorType, model);
     }
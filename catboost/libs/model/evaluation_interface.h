@@ -53,6 +53,68 @@ namespace NCB {  // split due to CUDA-compiler inability to parse nested namespa
             }
         };
 
+        //! Parameters of evaluation which stops summing trees for an object once its outcome is decided.
+        struct TEarlyExitParams {
+            //! Objects whose raw prediction can't reach Threshold anymore are dropped.
+            TMaybe<double> Threshold;
+            //! If TopSize is nonzero, objects that can't get into TopSize best of their group are dropped.
+            //! Groups are consecutive object ranges with sizes GroupSizes.
+            size_t TopSize = 0;
+            TConstArrayRef<ui32> GroupSizes;
+            //! Number of trees evaluated between two checks of the bounds.
+            size_t TreeBlockSize = 16;
+        };
+
+        struct TEarlyExitStats {
+            size_t EvaluatedTreeCount = 0; // summed over all objects
+            size_t TotalTreeCount = 0;
+
+        public:
+            double GetSkippedTreeFraction() const {
+                return TotalTreeCount ? 1.0 - (double)EvaluatedTreeCount / TotalTreeCount : 0.0;
+            }
+        };
+
+        //! Float features of objects in compressed sparse row (CSR) or column (CSC) format.
+        //! Omitted values are zeros.
+        struct TSparseFloatFeatures {
+            //! If true, Offsets delimit columns (CSC), otherwise rows (CSR).
+            bool ColumnMajor = false;
+            size_t ObjectCount = 0;
+            size_t FeatureCount = 0;
+            //! ObjectCount + 1 (CSR) or FeatureCount + 1 (CSC) positions in Indices and Values.
+            TConstArrayRef<size_t> Offsets;
+            //! Flat feature indices (CSR) or object indices, sorted within each column (CSC).
+            TConstArrayRef<ui32> Indices;
+            TConstArrayRef<float> Values;
+        };
+
+        //! Per stage counters of evaluation on raw features, collected by the CPU evaluator if enabled
+        //! with SetProperty("CollectCounters", "true"). Times are summed over all calls, concurrent ones included.
+        struct TEvaluationCounters {
+            ui64 ObjectCount = 0;
+            ui64 BlockCount = 0;
+            //! Float features binarization, categorical features hashing and one-hot encoding, CTRs binarization.
+            ui64 BinarizationNs = 0;
+            ui64 CtrCalcNs = 0;
+            ui64 TextProcessingNs = 0;
+            ui64 TreeTraversalNs = 0;
+            //! Number of calculated CTR values with categorical features combination absent in the model CTR tables.
+            ui64 CtrHashMissCount = 0;
+
+        public:
+            TEvaluationCounters& operator+=(const TEvaluationCounters& rhs) {
+                ObjectCount += rhs.ObjectCount;
+                BlockCount += rhs.BlockCount;
+                BinarizationNs += rhs.BinarizationNs;
+                CtrCalcNs += rhs.CtrCalcNs;
+                TextProcessingNs += rhs.TextProcessingNs;
+                TreeTraversalNs += rhs.TreeTraversalNs;
+                CtrHashMissCount += rhs.CtrHashMissCount;
+                return *this;
+            }
+        };
+
         class IModelEvaluator {
         public:
             virtual ~IModelEvaluator() = default;
@@ -69,6 +131,8 @@ namespace NCB {  // split due to CUDA-compiler inability to parse nested namespa
 
             virtual void SetProperty(const TStringBuf propName, const TStringBuf propValue) = 0;
 
+            virtual TString GetProperty(const TStringBuf propName) const = 0;
+
             // TODO(kirillovs): maybe write special class for results (on gpu it'll hold floats in possibly managed memory)
             TVector<double> CreateVectorForPredictions(size_t docCount) const {
                 switch (GetPredictionType())
@@ -149,6 +213,40 @@ namespace NCB {  // split due to CUDA-compiler inability to parse nested namespa
                 CalcFlatSingle(features, 0, GetTreeCount(), results, featureInfo);
             }
 
+            /**
+             * Evaluate raw predictions of a single dimension model in blocks of trees and stop evaluating
+             * an object once early exit bounds (see TEarlyExitParams) guarantee it is dropped.
+             * @param[out] results full raw predictions for kept objects, partial sums for dropped ones
+             * @param[out] isDropped whether the object was dropped
+             */
+            virtual TEarlyExitStats CalcFlatWithEarlyExit(
+                TConstArrayRef<TConstArrayRef<float>> features,
+                const TEarlyExitParams& params,
+                TArrayRef<double> results,
+                TArrayRef<bool> isDropped,
+                const TFeatureLayout* featureInfo = nullptr
+            ) const;
+
+            /**
+             * Evaluate model on sparse float features. Only non-default values are binarized, the rest of
+             * the objects get bins of zero value. Models with categorical or text features are not supported.
+             */
+            virtual void CalcFlatSparse(
+                const TSparseFloatFeatures& features,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo = nullptr
+            ) const;
+
+            void CalcFlatSparse(
+                const TSparseFloatFeatures& features,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo = nullptr
+            ) const {
+                CalcFlatSparse(features, 0, GetTreeCount(), results, featureInfo);
+            }
+
             virtual void Calc(
                 TConstArrayRef<TConstArrayRef<float>> floatFeatures,
                 TConstArrayRef<TConstArrayRef<int>> catFeatures,
@@ -33,7 +33,8 @@ flatbuffers::Offset<NCatBoostFbs::TFloatFeature> TFloatFeature::FBSerialize(
         Position.FlatIndex,
         &Borders,
         FeatureId.empty() ? nullptr : FeatureId.data(),
-        NanModeToFbsEnumValue(NanValueTreatment)
+        NanModeToFbsEnumValue(NanValueTreatment),
+        ExclusiveBundleId
     );
 }
 
@@ -45,6 +46,7 @@ void TFloatFeature::FBDeserialize(const NCatBoostFbs::TFloatFeature* fbObj) {
     Position.Index = fbObj->Index();
     Position.FlatIndex = fbObj->FlatIndex();
     NanValueTreatment = NanModeFromFbsEnumValue(fbObj->NanValueTreatment());
+    ExclusiveBundleId = fbObj->ExclusiveBundleId();
     if (fbObj->Borders()) {
         Borders.assign(fbObj->Borders()->begin(), fbObj->Borders()->end());
     }
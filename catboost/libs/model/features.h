@@ -46,6 +46,12 @@ public:
     TVector<float> Borders;
     TString FeatureId;
     ENanValueTreatment NanValueTreatment = ENanValueTreatment::AsIs;
+    /**
+     * Index of the learn dataset exclusive features bundle the feature belonged to, -1 if none.
+     * Binary features from the same bundle never had non-default values simultaneously on learn,
+     * so the evaluator may store them in one byte.
+     */
+    int ExclusiveBundleId = -1;
 
 public:
     TFloatFeature() = default;
@@ -17,6 +17,7 @@ namespace NCB { // split due to CUDA-compiler inability to support nested namesp
         class IModelEvaluator;
         class IQuantizedData;
         class ILeafIndexCalcer;
+        struct TSparseFloatFeatures;
 
         using TModelEvaluatorPtr = TAtomicSharedPtr<IModelEvaluator>;
         using TConstModelEvaluatorPtr = TAtomicSharedPtr<const IModelEvaluator>;
@@ -22,6 +22,7 @@
 #include <util/generic/algorithm.h>
 #include <util/generic/fwd.h>
 #include <util/generic/guid.h>
+#include <util/generic/map.h>
 #include <util/generic/variant.h>
 #include <util/generic/xrange.h>
 #include <util/generic/ylimits.h>
@@ -279,10 +280,13 @@ void TObliviousTrees::UpdateRuntimeData() const {
     ref.UsedEstimatedFeaturesCount = 0;
     ref.MinimalSufficientFloatFeaturesVectorSize = 0;
     ref.MinimalSufficientCatFeaturesVectorSize = 0;
-    for (const auto& feature : FloatFeatures) {
+    TVector<ui32> floatFeatureFirstBucket(FloatFeatures.size(), 0);
+    for (auto floatFeatureIdx : xrange(FloatFeatures.size())) {
+        const auto& feature = FloatFeatures[floatFeatureIdx];
         if (!feature.UsedInModel()) {
             continue;
         }
+        floatFeatureFirstBucket[floatFeatureIdx] = ref.EffectiveBinFeaturesBucketCount;
         ++ref.UsedFloatFeaturesCount;
         ref.MinimalSufficientFloatFeaturesVectorSize = static_cast<size_t>(feature.Position.Index) + 1;
         for (int borderId = 0; borderId < feature.Borders.ysize(); ++borderId) {
@@ -295,6 +299,7 @@ void TObliviousTrees::UpdateRuntimeData() const {
         ref.EffectiveBinFeaturesBucketCount
             += (feature.Borders.size() + MAX_VALUES_PER_BIN - 1) / MAX_VALUES_PER_BIN;
     }
+    const ui32 floatFeaturesBucketCount = ref.EffectiveBinFeaturesBucketCount;
     for (const auto& feature : CatFeatures) {
         if (!feature.UsedInModel()) {
             continue;
@@ -355,6 +360,61 @@ void TObliviousTrees::UpdateRuntimeData() const {
         ref.EffectiveBinFeaturesBucketCount
             += (feature.Borders.size() + MAX_VALUES_PER_BIN - 1) / MAX_VALUES_PER_BIN;
     }
+
+    // ctr provider computes ctrs from the binarized features in the ordinary layout, so no bundling with ctrs
+    ref.IsFloatFeatureBundled.assign(FloatFeatures.size(), false);
+    if (CtrFeatures.empty()) {
+        TMap<int, TVector<size_t>> bundleIdToFloatFeatures;
+        for (auto floatFeatureIdx : xrange(FloatFeatures.size())) {
+            const auto& feature = FloatFeatures[floatFeatureIdx];
+            if (feature.ExclusiveBundleId < 0 || feature.Borders.size() != 1) {
+                continue;
+            }
+            auto& bundle = bundleIdToFloatFeatures[feature.ExclusiveBundleId];
+            if (bundle.size() < MAX_VALUES_PER_BIN) {
+                bundle.push_back(floatFeatureIdx);
+            }
+        }
+        for (auto& [bundleId, bundle] : bundleIdToFloatFeatures) {
+            if (bundle.size() < 2) {
+                continue;
+            }
+            for (auto floatFeatureIdx : bundle) {
+                ref.IsFloatFeatureBundled[floatFeatureIdx] = true;
+            }
+            ref.FloatFeatureBundles.push_back(std::move(bundle));
+        }
+    }
+    ref.BundledBinFeaturesBucketCount = ref.EffectiveBinFeaturesBucketCount;
+    TVector<ui32> bundledBucketIdx; // [bucketIdx]
+    TVector<ui8> valueInBundle; // [bucketIdx], 0 if bucket is not bundled
+    if (!ref.FloatFeatureBundles.empty()) {
+        bundledBucketIdx.resize(ref.EffectiveBinFeaturesBucketCount);
+        valueInBundle.resize(ref.EffectiveBinFeaturesBucketCount, 0);
+        ui32 bundledBucketCount = 0;
+        for (auto floatFeatureIdx : xrange(FloatFeatures.size())) {
+            const auto& feature = FloatFeatures[floatFeatureIdx];
+            if (!feature.UsedInModel() || ref.IsFloatFeatureBundled[floatFeatureIdx]) {
+                continue;
+            }
+            const ui32 bucketCount = (feature.Borders.size() + MAX_VALUES_PER_BIN - 1) / MAX_VALUES_PER_BIN;
+            for (auto i : xrange(bucketCount)) {
+                bundledBucketIdx[floatFeatureFirstBucket[floatFeatureIdx] + i] = bundledBucketCount++;
+            }
+        }
+        for (const auto& bundle : ref.FloatFeatureBundles) {
+            for (auto inBundleIdx : xrange(bundle.size())) {
+                const ui32 bucketIdx = floatFeatureFirstBucket[bundle[inBundleIdx]];
+                bundledBucketIdx[bucketIdx] = bundledBucketCount;
+                valueInBundle[bucketIdx] = static_cast<ui8>(inBundleIdx + 1);
+            }
+            ++bundledBucketCount;
+        }
+        for (auto bucketIdx : xrange(floatFeaturesBucketCount, ref.EffectiveBinFeaturesBucketCount)) {
+            bundledBucketIdx[bucketIdx] = bundledBucketCount++;
+        }
+        ref.BundledBinFeaturesBucketCount = bundledBucketCount;
+    }
     for (const auto& binSplit : TreeSplits) {
         const auto& feature = ref.BinFeatures[binSplit];
         const auto& featureIndex = splitIds[binSplit];
@@ -371,6 +431,15 @@ void TObliviousTrees::UpdateRuntimeData() const {
             rb.SplitIdx = 0xff;
         }
         ref.RepackedBins.push_back(rb);
+        if (!ref.FloatFeatureBundles.empty()) {
+            TRepackedBin bundledRb = rb;
+            bundledRb.FeatureIndex = bundledBucketIdx[rb.FeatureIndex];
+            if (valueInBundle[rb.FeatureIndex] != 0) {
+                bundledRb.XorMask = ((~valueInBundle[rb.FeatureIndex]) & 0xff);
+                bundledRb.SplitIdx = 0xff;
+            }
+            ref.BundledRepackedBins.push_back(bundledRb);
+        }
     }
 }
 
@@ -381,6 +450,53 @@ void TObliviousTrees::DropUnusedFeatures() {
     UpdateRuntimeData();
 }
 
+void TObliviousTrees::ExtendFloatFeaturesBorders(const TVector<TFloatFeature>& floatFeatures) {
+    THashMap<int, size_t> indexToNewFeature;
+    TVector<int> newFeatureFirstBinFeature(floatFeatures.size());
+    int newFloatBinFeatureCount = 0;
+    for (auto i : xrange(floatFeatures.size())) {
+        indexToNewFeature[floatFeatures[i].Position.Index] = i;
+        newFeatureFirstBinFeature[i] = newFloatBinFeatureCount;
+        newFloatBinFeatureCount += floatFeatures[i].Borders.ysize();
+    }
+    // float bin features go first, in the order of features and borders
+    TVector<int> floatBinFeatureRemap;
+    for (const auto& feature : FloatFeatures) {
+        if (!feature.UsedInModel()) {
+            continue;
+        }
+        const auto newFeatureIdx = indexToNewFeature.FindPtr(feature.Position.Index);
+        CB_ENSURE(newFeatureIdx, "Float feature " << feature.Position.Index << " is missing");
+        const auto& newFeature = floatFeatures[*newFeatureIdx];
+        CB_ENSURE(
+            newFeature.Position == feature.Position,
+            "Float feature " << feature.Position.Index << " flat index mismatch: "
+            << newFeature.Position.FlatIndex << " != " << feature.Position.FlatIndex
+        );
+        CB_ENSURE(
+            newFeature.NanValueTreatment == feature.NanValueTreatment,
+            "Float feature " << feature.Position.Index << " nan value treatment differs"
+        );
+        for (float border : feature.Borders) {
+            const auto borderIdx = LowerBound(newFeature.Borders.begin(), newFeature.Borders.end(), border)
+                - newFeature.Borders.begin();
+            CB_ENSURE(
+                borderIdx < newFeature.Borders.ysize() && newFeature.Borders[borderIdx] == border,
+                "Float feature " << feature.Position.Index << " has no border " << border
+            );
+            floatBinFeatureRemap.push_back(newFeatureFirstBinFeature[*newFeatureIdx] + borderIdx);
+        }
+    }
+    const int floatBinFeatureCount = floatBinFeatureRemap.ysize();
+    for (auto& split : TreeSplits) {
+        split = split < floatBinFeatureCount ?
+            floatBinFeatureRemap[split] :
+            split - floatBinFeatureCount + newFloatBinFeatureCount;
+    }
+    FloatFeatures = floatFeatures;
+    UpdateRuntimeData();
+}
+
 void TObliviousTrees::ConvertObliviousToAsymmetric() {
     if (!IsOblivious()) {
         return;
@@ -508,6 +624,24 @@ void TFullModel::CalcFlat(
     GetCurrentEvaluator()->CalcFlat(features, treeStart, treeEnd, results, featureInfo);
 }
 
+NCB::NModelEvaluation::TEarlyExitStats TFullModel::CalcFlatWithEarlyExit(
+    TConstArrayRef<TConstArrayRef<float>> features,
+    const NCB::NModelEvaluation::TEarlyExitParams& params,
+    TArrayRef<double> results,
+    TArrayRef<bool> isDropped,
+    const TFeatureLayout* featureInfo) const {
+    return GetCurrentEvaluator()->CalcFlatWithEarlyExit(features, params, results, isDropped, featureInfo);
+}
+
+void TFullModel::CalcFlatSparse(
+    const NCB::NModelEvaluation::TSparseFloatFeatures& features,
+    size_t treeStart,
+    size_t treeEnd,
+    TArrayRef<double> results,
+    const TFeatureLayout* featureInfo) const {
+    GetCurrentEvaluator()->CalcFlatSparse(features, treeStart, treeEnd, results, featureInfo);
+}
+
 void TFullModel::CalcFlatSingle(
     TConstArrayRef<float> features,
     size_t treeStart,
@@ -866,6 +1000,9 @@ namespace {
                     (int) other.NanValueTreatment
                 );
                 feature.HasNans |= other.HasNans;
+                if (feature.ExclusiveBundleId != other.ExclusiveBundleId) {
+                    feature.ExclusiveBundleId = -1;
+                }
             }
         }
     };
@@ -120,6 +120,20 @@ public:
 
         ui32 EffectiveBinFeaturesBucketCount = 0;
 
+        /**
+         * Groups of indexes in FloatFeatures of binary float features from the same exclusive bundle.
+         * Each group takes a single bucket in the bundled layout: the byte holds 1-based index of the
+         * feature with the value greater than its border or 0 if there is none.
+         * Bundled layout is: not bundled float features, bundles, then all other features.
+         */
+        TVector<TVector<size_t>> FloatFeatureBundles;
+        TVector<bool> IsFloatFeatureBundled; // [floatFeatureIdx]
+
+        //! Same as RepackedBins but for the bundled layout, empty if model has no bundles
+        TVector<TRepackedBin> BundledRepackedBins;
+
+        ui32 BundledBinFeaturesBucketCount = 0;
+
         //! Offset of first tree leaf in flat tree leafs array
         TVector<size_t> TreeFirstLeafOffsets;
     };
@@ -373,6 +387,12 @@ public:
      */
      void DropUnusedFeatures();
 
+    /**
+     * Internal usage only. Replaces float features with the ones at the same positions having a superset
+     *  of the current borders, tree splits are remapped to the new binary features.
+     */
+    void ExtendFloatFeaturesBorders(const TVector<TFloatFeature>& floatFeatures);
+
     /**
      * Internal usage only. Updates UsedModelCtrs and BinFeatures vectors in RuntimeData to contain all
      *  features currently used in model.
@@ -401,6 +421,21 @@ public:
         return RuntimeData->RepackedBins;
     }
 
+    const TVector<TVector<size_t>>& GetFloatFeatureBundles() const {
+        CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
+        return RuntimeData->FloatFeatureBundles;
+    }
+
+    bool IsFloatFeatureBundled(size_t floatFeatureIdx) const {
+        CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
+        return RuntimeData->IsFloatFeatureBundled[floatFeatureIdx];
+    }
+
+    const TVector<TRepackedBin>& GetBundledRepackedBins() const {
+        CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
+        return RuntimeData->BundledRepackedBins;
+    }
+
     const TVector<size_t>& GetFirstLeafOffsets() const {
         CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
         return RuntimeData->TreeFirstLeafOffsets;
@@ -482,6 +517,12 @@ public:
         return RuntimeData->EffectiveBinFeaturesBucketCount;
     }
 
+    //! Equals to GetEffectiveBinaryFeaturesBucketsCount() if model has no exclusive bundles
+    ui32 GetBundledBinaryFeaturesBucketsCount() const {
+        CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
+        return RuntimeData->BundledBinFeaturesBucketCount;
+    }
+
     size_t GetFlatFeatureVectorExpectedSize() const {
         return (size_t)Max(
             CatFeatures.empty() ? 0 : CatFeatures.back().Position.FlatIndex + 1,
@@ -615,6 +656,22 @@ public:
         }
     }
 
+    /**
+     * Set property of the current evaluator, e.g. SetEvaluatorProperty("CollectCounters", "true")
+     */
+    void SetEvaluatorProperty(TStringBuf propName, TStringBuf propValue) {
+        with_lock(CurrentEvaluatorLock) {
+            if (!Evaluator) {
+                Evaluator = NCB::NModelEvaluation::CreateEvaluator(FormulaEvaluatorType, *this);
+            }
+            Evaluator->SetProperty(propName, propValue);
+        }
+    }
+
+    TString GetEvaluatorProperty(TStringBuf propName) const {
+        return GetCurrentEvaluator()->GetProperty(propName);
+    }
+
     bool operator==(const TFullModel& other) const {
         return *ObliviousTrees == *other.ObliviousTrees;
     }
@@ -824,6 +881,43 @@ public:
         CalcFlat(featureRefs, results, featureInfo);
     }
 
+    /**
+     * CalcFlat with early exit: trees are evaluated in blocks and objects that are guaranteed to be dropped
+     *  by params (threshold or top size in group) are not evaluated further.
+     * @param[out] results Raw predictions, partial sums for dropped objects. Only single class models are supported.
+     * @param[out] isDropped Flags of dropped objects
+     * @return Counts of evaluated and total trees
+     */
+    NCB::NModelEvaluation::TEarlyExitStats CalcFlatWithEarlyExit(
+        TConstArrayRef<TConstArrayRef<float>> features,
+        const NCB::NModelEvaluation::TEarlyExitParams& params,
+        TArrayRef<double> results,
+        TArrayRef<bool> isDropped,
+        const TFeatureLayout* featureInfo = nullptr
+    ) const;
+
+    /**
+     * Evaluate raw formula predictions on float features in CSR or CSC format. Values omitted from
+     *  the sparse matrix are zeros, their bins are precomputed once per feature.
+     * Only models without categorical and text features are supported.
+     * @param[out] results indexation is the same as for CalcFlat
+     */
+    void CalcFlatSparse(
+        const NCB::NModelEvaluation::TSparseFloatFeatures& features,
+        size_t treeStart,
+        size_t treeEnd,
+        TArrayRef<double> results,
+        const TFeatureLayout* featureInfo = nullptr
+    ) const;
+
+    void CalcFlatSparse(
+        const NCB::NModelEvaluation::TSparseFloatFeatures& features,
+        TArrayRef<double> results,
+        const TFeatureLayout* featureInfo = nullptr
+    ) const {
+        CalcFlatSparse(features, 0, GetTreeCount(), results, featureInfo);
+    }
+
     /**
      * Same as CalcFlat method but for one object
      * @param[in] features flat features array reference. First dimension is object index, second dimension is
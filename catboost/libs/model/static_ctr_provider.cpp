@@ -2,6 +2,7 @@
 
 #include "ctr_helpers.h"
 
+#include <util/generic/algorithm.h>
 #include <util/generic/xrange.h>
 #include <util/string/cast.h>
 
@@ -10,7 +11,8 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                                   const TConstArrayRef<ui8>& binarizedFeatures,
                                   const TConstArrayRef<ui32>& hashedCatFeatures,
                                   size_t docCount,
-                                  TArrayRef<float> result) {
+                                  TArrayRef<float> result,
+                                  ui64* hashMissCount) {
     if (neededCtrs.empty()) {
         return;
     }
@@ -44,6 +46,12 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
             for (size_t docId = 0; docId < samplesCount; ++docId) {
                 ptrBuckets[docId] = hashIndexResolver.GetIndex(ctrHashes[docId]);
             }
+            if (hashMissCount) {
+                *hashMissCount += CountIf(
+                    buckets,
+                    [] (ui64 bucket) { return bucket == NCatboost::TDenseIndexHashView::NotFoundIndex; }
+                );
+            }
             if (ctrType == ECtrType::BinarizedTargetMeanValue || ctrType == ECtrType::FloatTargetMeanValue) {
                 const auto emptyVal = ctr->Calc(0.f, 0.f);
                 auto ctrMean = learnCtr.GetTypedArrayRefForBlobData<TCtrMeanHistory>();
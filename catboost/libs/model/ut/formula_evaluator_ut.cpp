@@ -2,6 +2,7 @@
 
 #include <catboost/libs/data/data_provider_builders.h>
 #include <catboost/libs/model/cpu/evaluator.h>
+#include <catboost/libs/model/cpu/model_group_evaluator.h>
 #include <catboost/libs/model/model.h>
 #include <catboost/libs/train_lib/train_model.h>
 #include <catboost/private/libs/text_features/ut/lib/text_features_data.h>
@@ -92,6 +93,29 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         CheckFlatCalcResult(model, expectedPredicts, expectedLeafIndexes);
     }
 
+    Y_UNIT_TEST(TestFlatCalcExclusiveBundles) {
+        auto model = SimpleFloatModel();
+        const auto modelFloatFeatures = model.ObliviousTrees->GetFloatFeatures();
+        TVector<TFloatFeature> floatFeatures(modelFloatFeatures.begin(), modelFloatFeatures.end());
+        floatFeatures[1].ExclusiveBundleId = 0;
+        floatFeatures[2].ExclusiveBundleId = 0;
+        model.ObliviousTrees.GetMutable()->SetFloatFeatures(floatFeatures);
+        model.UpdateDynamicData();
+        UNIT_ASSERT_VALUES_EQUAL(model.ObliviousTrees->GetFloatFeatureBundles().size(), 1);
+        UNIT_ASSERT_VALUES_EQUAL(
+            model.ObliviousTrees->GetBundledBinaryFeaturesBucketsCount() + 1,
+            model.ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount()
+        );
+
+        // features 1 and 2 are exclusive on first 6 samples only, the others are evaluated without bundles
+        const TVector<TConstArrayRef<float>> exclusiveFeatures(FLOAT_FEATURES.begin(), FLOAT_FEATURES.begin() + 6);
+        CheckFlatCalcResult(model, xrange<double>(6), xrange<ui32>(6), exclusiveFeatures);
+        CheckFlatCalcResult(model, xrange<double>(8), xrange<ui32>(8));
+        model.ObliviousTrees.GetMutable()->ConvertObliviousToAsymmetric();
+        CheckFlatCalcResult(model, xrange<double>(6), xrange<ui32>(6), exclusiveFeatures);
+        CheckFlatCalcResult(model, xrange<double>(8), xrange<ui32>(8));
+    }
+
     Y_UNIT_TEST(TestFlatCalcOnDeepTree) {
         const size_t treeDepth = 9;
         auto model = SimpleDeepTreeModel(treeDepth);
@@ -129,6 +153,26 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         CheckFlatCalcResult(model, expectedPredicts, xrange(4), features);
     }
 
+    Y_UNIT_TEST(TestEvaluationCounters) {
+        auto model = SimpleFloatModel();
+        TVector<double> predicts(FLOAT_FEATURES.size());
+        model.CalcFlat(FLOAT_FEATURES, predicts);
+        UNIT_ASSERT_VALUES_EQUAL(model.GetEvaluatorProperty("ObjectCount"), "0");
+
+        model.SetEvaluatorProperty("CollectCounters", "true");
+        model.CalcFlat(FLOAT_FEATURES, predicts);
+        model.CalcFlatSingle(FLOAT_FEATURES[0], MakeArrayRef(predicts.data(), 1));
+        UNIT_ASSERT_VALUES_EQUAL(model.GetEvaluatorProperty("ObjectCount"), ToString(FLOAT_FEATURES.size() + 1));
+        UNIT_ASSERT_VALUES_EQUAL(model.GetEvaluatorProperty("BlockCount"), "2");
+        UNIT_ASSERT_VALUES_EQUAL(model.GetEvaluatorProperty("CtrHashMissCount"), "0");
+        UNIT_ASSERT_VALUES_EQUAL(model.GetEvaluatorProperty("CtrCalcNs"), "0");
+        UNIT_ASSERT_EXCEPTION(model.GetEvaluatorProperty("UnknownCounter"), TCatBoostException);
+
+        model.SetEvaluatorProperty("ResetCounters", "");
+        UNIT_ASSERT_VALUES_EQUAL(model.GetEvaluatorProperty("ObjectCount"), "0");
+        UNIT_ASSERT_VALUES_EQUAL(model.GetEvaluatorProperty("CollectCounters"), "true");
+    }
+
     Y_UNIT_TEST(TestCatOnlyModel) {
         const auto model = TrainCatOnlyModel();
 
@@ -147,6 +191,18 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         UNIT_ASSERT_NO_EXCEPTION(applyBatch());
     }
 
+    Y_UNIT_TEST(TestCatOnlyModelCtrHashMisses) {
+        auto model = TrainCatOnlyModel();
+        model.SetEvaluatorProperty("CollectCounters", "true");
+        const TVector<TStringBuf> unseenValues[] = {{"x", "y", "z"}};
+        double result = 0.;
+        model.Calc({}, unseenValues, MakeArrayRef(&result, 1));
+        UNIT_ASSERT_VALUES_EQUAL(
+            model.GetEvaluatorProperty("CtrHashMissCount"),
+            ToString(model.ObliviousTrees->GetUsedModelCtrs().size())
+        );
+    }
+
     static void CheckCalcTextResult(
         const TFullModel& model,
         TConstArrayRef<TVector<TStringBuf>> transposedTextFeatures,
@@ -247,6 +303,210 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
             numEstimatedFeatures
         );
     }
+
+    Y_UNIT_TEST(TestEarlyExit) {
+        // trees add sampleId, 10 * sampleId and 100 * sampleId
+        auto model = SimpleFloatModel(3);
+        for (bool asymmetric : {false, true}) {
+            if (asymmetric) {
+                model.ObliviousTrees.GetMutable()->ConvertObliviousToAsymmetric();
+            }
+            TVector<double> predicts(DATA.size());
+            TVector<bool> isDropped(DATA.size());
+            {
+                TEarlyExitParams params;
+                params.Threshold = 701.0;
+                params.TreeBlockSize = 1;
+                const auto stats = model.CalcFlatWithEarlyExit(FLOAT_FEATURES, params, predicts, isDropped);
+                UNIT_ASSERT_VALUES_EQUAL(stats.TotalTreeCount, 24);
+                UNIT_ASSERT_VALUES_EQUAL(stats.EvaluatedTreeCount, 23);
+                for (ui32 sampleId : xrange(DATA.size())) {
+                    UNIT_ASSERT_VALUES_EQUAL(isDropped[sampleId], sampleId < 7);
+                    UNIT_ASSERT_DOUBLES_EQUAL(predicts[sampleId], (sampleId == 0 ? 0.0 : 111.0 * sampleId), 1e-9);
+                }
+            }
+            {
+                TEarlyExitParams params;
+                params.Threshold = 780.0;
+                params.TreeBlockSize = 2;
+                const auto stats = model.CalcFlatWithEarlyExit(FLOAT_FEATURES, params, predicts, isDropped);
+                UNIT_ASSERT_VALUES_EQUAL(stats.EvaluatedTreeCount, 16);
+                UNIT_ASSERT_DOUBLES_EQUAL(stats.GetSkippedTreeFraction(), 1.0 / 3, 1e-9);
+                for (ui32 sampleId : xrange(DATA.size())) {
+                    UNIT_ASSERT(isDropped[sampleId]);
+                    UNIT_ASSERT_DOUBLES_EQUAL(predicts[sampleId], 11.0 * sampleId, 1e-9);
+                }
+            }
+            {
+                const TVector<ui32> groupSizes = {4, 4};
+                TEarlyExitParams params;
+                params.TopSize = 1;
+                params.GroupSizes = groupSizes;
+                model.CalcFlatWithEarlyExit(FLOAT_FEATURES, params, predicts, isDropped);
+                for (ui32 sampleId : xrange(DATA.size())) {
+                    UNIT_ASSERT_VALUES_EQUAL(isDropped[sampleId], sampleId != 3 && sampleId != 7);
+                    UNIT_ASSERT_DOUBLES_EQUAL(predicts[sampleId], 111.0 * sampleId, 1e-9);
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestFlatCalcSparse) {
+        auto model = SimpleFloatModel(3);
+        const size_t featureCount = DATA[0].size();
+        TVector<size_t> rowOffsets = {0};
+        TVector<ui32> rowIndices;
+        TVector<float> rowValues;
+        for (const auto& sample : DATA) {
+            for (ui32 featureId : xrange(featureCount)) {
+                if (sample[featureId] != 0.0f) {
+                    rowIndices.push_back(featureId);
+                    rowValues.push_back(sample[featureId]);
+                }
+            }
+            rowOffsets.push_back(rowIndices.size());
+        }
+        TVector<size_t> columnOffsets = {0};
+        TVector<ui32> columnIndices;
+        TVector<float> columnValues;
+        for (ui32 featureId : xrange(featureCount)) {
+            for (ui32 sampleId : xrange(DATA.size())) {
+                if (DATA[sampleId][featureId] != 0.0f) {
+                    columnIndices.push_back(sampleId);
+                    columnValues.push_back(DATA[sampleId][featureId]);
+                }
+            }
+            columnOffsets.push_back(columnIndices.size());
+        }
+        for (bool asymmetric : {false, true}) {
+            if (asymmetric) {
+                model.ObliviousTrees.GetMutable()->ConvertObliviousToAsymmetric();
+            }
+            TVector<double> expectedPredicts(DATA.size());
+            model.CalcFlat(FLOAT_FEATURES, expectedPredicts);
+            for (bool columnMajor : {false, true}) {
+                TSparseFloatFeatures features;
+                features.ColumnMajor = columnMajor;
+                features.ObjectCount = DATA.size();
+                features.FeatureCount = featureCount;
+                features.Offsets = columnMajor ? columnOffsets : rowOffsets;
+                features.Indices = columnMajor ? columnIndices : rowIndices;
+                features.Values = columnMajor ? columnValues : rowValues;
+                TVector<double> predicts(DATA.size());
+                model.CalcFlatSparse(features, predicts);
+                UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestFlatCalcSparseInvalidInput) {
+        const auto model = SimpleFloatModel();
+        const TVector<float> values = {1.f, 1.f};
+        TVector<double> predicts(2);
+        TSparseFloatFeatures features;
+        features.ObjectCount = 2;
+        features.FeatureCount = 3;
+        features.Values = values;
+
+        // CSR with decreasing offsets
+        const TVector<size_t> rowOffsets = {0, 2, 1};
+        const TVector<ui32> rowIndices = {0, 1};
+        features.Offsets = rowOffsets;
+        features.Indices = rowIndices;
+        UNIT_ASSERT_EXCEPTION(model.CalcFlatSparse(features, predicts), TCatBoostException);
+
+        // CSC with object index out of range
+        features.ColumnMajor = true;
+        const TVector<size_t> columnOffsets = {0, 2, 2, 2};
+        const TVector<ui32> columnIndices = {0, 2};
+        features.Offsets = columnOffsets;
+        features.Indices = columnIndices;
+        UNIT_ASSERT_EXCEPTION(model.CalcFlatSparse(features, predicts), TCatBoostException);
+    }
+}
+
+Y_UNIT_TEST_SUITE(TModelGroupEvaluator) {
+    Y_UNIT_TEST(TestCalcFlat) {
+        // models have different borders of feature 0 and different approx dimensions
+        auto obliviousModel = SimpleFloatModel(2);
+        auto asymmetricModel = SimpleFloatModel(1);
+        asymmetricModel.ObliviousTrees.GetMutable()->ConvertObliviousToAsymmetric();
+        const auto multiValueModel = MultiValueFloatModel();
+        const TVector<const TFullModel*> models = {&obliviousModel, &asymmetricModel, &multiValueModel};
+
+        const TModelGroupEvaluator evaluator(models);
+        UNIT_ASSERT_VALUES_EQUAL(evaluator.GetModelCount(), models.size());
+        for (size_t docCount : {size_t(1), FLOAT_FEATURES.size()}) {
+            const TVector<TConstArrayRef<float>> features(FLOAT_FEATURES.begin(), FLOAT_FEATURES.begin() + docCount);
+            const auto groupPredicts = evaluator.CalcFlat(features);
+            UNIT_ASSERT_VALUES_EQUAL(groupPredicts.size(), models.size());
+            for (auto modelIdx : xrange(models.size())) {
+                TVector<double> expectedPredicts(docCount * models[modelIdx]->GetDimensionsCount());
+                models[modelIdx]->CalcFlat(features, expectedPredicts);
+                UNIT_ASSERT_EQUAL(groupPredicts[modelIdx], expectedPredicts);
+            }
+        }
+
+        // feature 1 has nans in one model only, they fall into the first bin in both models
+        TVector<TFloatFeature> floatFeatures(
+            obliviousModel.ObliviousTrees->GetFloatFeatures().begin(),
+            obliviousModel.ObliviousTrees->GetFloatFeatures().end()
+        );
+        floatFeatures[1].HasNans = true;
+        floatFeatures[1].NanValueTreatment = TFloatFeature::ENanValueTreatment::AsFalse;
+        obliviousModel.ObliviousTrees.GetMutable()->SetFloatFeatures(floatFeatures);
+        obliviousModel.UpdateDynamicData();
+        TVector<TFloatFeature> asymmetricFloatFeatures(
+            asymmetricModel.ObliviousTrees->GetFloatFeatures().begin(),
+            asymmetricModel.ObliviousTrees->GetFloatFeatures().end()
+        );
+        asymmetricFloatFeatures[1].NanValueTreatment = TFloatFeature::ENanValueTreatment::AsFalse;
+        asymmetricModel.ObliviousTrees.GetMutable()->SetFloatFeatures(asymmetricFloatFeatures);
+        asymmetricModel.UpdateDynamicData();
+        const TVector<const TFullModel*> nanModels = {&obliviousModel, &asymmetricModel};
+        const TVector<TVector<float>> nanData = {
+            {0.f, std::numeric_limits<float>::quiet_NaN(), 1.f},
+            {3.f, std::numeric_limits<float>::quiet_NaN(), 0.f}
+        };
+        const auto nanFeatures = GetFeatureRef(nanData);
+        const auto nanGroupPredicts = TModelGroupEvaluator(nanModels).CalcFlat(nanFeatures);
+        for (auto modelIdx : xrange(nanModels.size())) {
+            TVector<double> expectedPredicts(nanData.size());
+            nanModels[modelIdx]->CalcFlat(nanFeatures, expectedPredicts);
+            UNIT_ASSERT_EQUAL(nanGroupPredicts[modelIdx], expectedPredicts);
+        }
+
+        // with AsTrue treatment nans are substituted only in the model with HasNans
+        floatFeatures[1].NanValueTreatment = TFloatFeature::ENanValueTreatment::AsTrue;
+        obliviousModel.ObliviousTrees.GetMutable()->SetFloatFeatures(floatFeatures);
+        obliviousModel.UpdateDynamicData();
+        asymmetricFloatFeatures[1].NanValueTreatment = TFloatFeature::ENanValueTreatment::AsTrue;
+        asymmetricModel.ObliviousTrees.GetMutable()->SetFloatFeatures(asymmetricFloatFeatures);
+        asymmetricModel.UpdateDynamicData();
+        UNIT_ASSERT_EXCEPTION(TModelGroupEvaluator{nanModels}, TCatBoostException);
+    }
+
+    Y_UNIT_TEST(TestExclusiveBundlesAreNotShared) {
+        auto firstModel = SimpleFloatModel();
+        auto secondModel = SimpleFloatModel();
+        for (auto* model : {&firstModel, &secondModel}) {
+            TVector<TFloatFeature> floatFeatures(
+                model->ObliviousTrees->GetFloatFeatures().begin(),
+                model->ObliviousTrees->GetFloatFeatures().end()
+            );
+            floatFeatures[1].ExclusiveBundleId = 0;
+            floatFeatures[2].ExclusiveBundleId = 0;
+            model->ObliviousTrees.GetMutable()->SetFloatFeatures(floatFeatures);
+            model->UpdateDynamicData();
+        }
+        const TVector<const TFullModel*> models = {&firstModel, &secondModel};
+        const auto groupPredicts = TModelGroupEvaluator(models).CalcFlat(FLOAT_FEATURES);
+        for (auto modelIdx : xrange(models.size())) {
+            TVector<double> expectedPredicts(FLOAT_FEATURES.size());
+            models[modelIdx]->CalcFlat(FLOAT_FEATURES, expectedPredicts);
+            UNIT_ASSERT_EQUAL(groupPredicts[modelIdx], expectedPredicts);
+        }
+    }
 }
 
 Y_UNIT_TEST_SUITE(TNonSymmetricTreeModel) {
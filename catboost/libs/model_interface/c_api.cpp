@@ -6,6 +6,7 @@
 #include <util/generic/singleton.h>
 #include <util/stream/file.h>
 #include <util/string/builder.h>
+#include <util/string/cast.h>
 
 #define FULL_MODEL_PTR(x) ((TFullModel*)(x))
 
@@ -69,6 +70,36 @@ EXPORT bool EnableGPUEvaluation(ModelCalcerHandle* modelHandle, int deviceId) {
     return true;
 }
 
+EXPORT bool EnableEvaluationCounters(ModelCalcerHandle* modelHandle, bool enable) {
+    try {
+        FULL_MODEL_PTR(modelHandle)->SetEvaluatorProperty("CollectCounters", ToString(enable));
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+        return false;
+    }
+    return true;
+}
+
+EXPORT bool ResetEvaluationCounters(ModelCalcerHandle* modelHandle) {
+    try {
+        FULL_MODEL_PTR(modelHandle)->SetEvaluatorProperty("ResetCounters", "");
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+        return false;
+    }
+    return true;
+}
+
+EXPORT bool GetEvaluationCounter(ModelCalcerHandle* modelHandle, const char* counterName, unsigned long long* value) {
+    try {
+        *value = FromString<unsigned long long>(FULL_MODEL_PTR(modelHandle)->GetEvaluatorProperty(counterName));
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+        return false;
+    }
+    return true;
+}
+
 EXPORT bool CalcModelPredictionFlat(ModelCalcerHandle* modelHandle, size_t docCount, const float** floatFeatures, size_t floatFeaturesSize, double* result, size_t resultSize) {
     try {
         if (docCount == 1) {
@@ -87,6 +118,30 @@ EXPORT bool CalcModelPredictionFlat(ModelCalcerHandle* modelHandle, size_t docCo
     return true;
 }
 
+EXPORT bool CalcModelPredictionSparse(
+        ModelCalcerHandle* modelHandle,
+        size_t docCount, size_t featureCount,
+        bool columnMajor,
+        const size_t* offsets,
+        const unsigned int* indices,
+        const float* values, size_t valuesSize,
+        double* result, size_t resultSize) {
+    try {
+        NCB::NModelEvaluation::TSparseFloatFeatures features;
+        features.ColumnMajor = columnMajor;
+        features.ObjectCount = docCount;
+        features.FeatureCount = featureCount;
+        features.Offsets = TConstArrayRef<size_t>(offsets, (columnMajor ? featureCount : docCount) + 1);
+        features.Indices = TConstArrayRef<ui32>(indices, valuesSize);
+        features.Values = TConstArrayRef<float>(values, valuesSize);
+        FULL_MODEL_PTR(modelHandle)->CalcFlatSparse(features, TArrayRef<double>(result, resultSize));
+    } catch (...) {
+        Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
+        return false;
+    }
+    return true;
+}
+
 EXPORT bool CalcModelPrediction(
         ModelCalcerHandle* modelHandle,
         size_t docCount,
@@ -65,6 +65,34 @@ EXPORT bool LoadFullModelFromBuffer(
 */
 EXPORT bool EnableGPUEvaluation(ModelCalcerHandle* modelHandle, int deviceId);
 
+/**
+ * Enable or disable collection of per stage evaluation counters, see GetEvaluationCounter
+ * Collection is supported by CPU evaluation only and is disabled by default.
+ * @param calcer model handle
+ * @param enable
+ * @return false if error occured
+ */
+EXPORT bool EnableEvaluationCounters(ModelCalcerHandle* modelHandle, bool enable);
+
+/**
+ * Reset evaluation counters to zero
+ * @param calcer model handle
+ * @return false if error occured
+ */
+EXPORT bool ResetEvaluationCounters(ModelCalcerHandle* modelHandle);
+
+/**
+ * Get evaluation counter summed over all model predictions calculated since counters collection was enabled.
+ * Available counters: ObjectCount, BlockCount, BinarizationNs, CtrCalcNs, TextProcessingNs, TreeTraversalNs
+ * (wall-clock times of evaluation stages in nanoseconds) and CtrHashMissCount
+ * (count of CTR values of categorical features combinations missing in the model CTR tables).
+ * @param calcer model handle
+ * @param counterName zero terminated counter name
+ * @param value pointer to user allocated counter value
+ * @return false if error occured
+ */
+EXPORT bool GetEvaluationCounter(ModelCalcerHandle* modelHandle, const char* counterName, unsigned long long* value);
+
 /**
  * **Use this method only if you really understand what you want.**
  * Calculate raw model predictions on flat feature vectors
@@ -84,6 +112,30 @@ EXPORT bool CalcModelPredictionFlat(
     const float** floatFeatures, size_t floatFeaturesSize,
     double* result, size_t resultSize);
 
+/**
+ * Calculate raw model predictions on float features in compressed sparse row (CSR) or column (CSC) format.
+ * Values omitted from the sparse matrix are zeros. Models with categorical features are not supported.
+ * @param calcer model handle
+ * @param docCount number of objects
+ * @param featureCount number of flat features
+ * @param columnMajor if true features are in CSC format, otherwise in CSR format
+ * @param offsets docCount + 1 (CSR) or featureCount + 1 (CSC) positions in indices and values arrays
+ * @param indices feature indices (CSR) or object indices, sorted within each column (CSC)
+ * @param values feature values
+ * @param valuesSize size of indices and values arrays
+ * @param result pointer to user allocated results vector
+ * @param resultSize Result size should be equal to modelApproxDimension * docCount
+ * @return false if error occured
+ */
+EXPORT bool CalcModelPredictionSparse(
+    ModelCalcerHandle* modelHandle,
+    size_t docCount, size_t featureCount,
+    bool columnMajor,
+    const size_t* offsets,
+    const unsigned int* indices,
+    const float* values, size_t valuesSize,
+    double* result, size_t resultSize);
+
 /**
  * Calculate raw model predictions on float features and string categorical feature values
  * @param calcer model handle
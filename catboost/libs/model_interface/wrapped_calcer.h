@@ -53,6 +53,27 @@ public:
             throw std::runtime_error(GetErrorString());
         }
     }
+    /**
+     * Enable or disable collection of per stage evaluation counters (CPU evaluation only)
+     * @param[in] enable
+     */
+    void EnableEvaluationCounters(bool enable = true) {
+        if (!::EnableEvaluationCounters(CalcerHolder.get(), enable)) {
+            throw std::runtime_error(GetErrorString());
+        }
+    }
+    /**
+     * Get evaluation counter value, e.g. "ObjectCount" or "TreeTraversalNs"
+     * @param[in] counterName
+     * @return counter value summed since counters collection was enabled
+     */
+    unsigned long long GetEvaluationCounter(const std::string& counterName) const {
+        unsigned long long value = 0;
+        if (!::GetEvaluationCounter(CalcerHolder.get(), counterName.c_str(), &value)) {
+            throw std::runtime_error(GetErrorString());
+        }
+        return value;
+    }
     /**
      * Evaluate model on single object flat features vector.
      * Flat here means that float features and categorical feature are in the same float array.
@@ -0,0 +1,103 @@
+#include "synthetic_data.h"
+
+#include <catboost/private/libs/algo_helpers/error_functions.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <cmath>
+
+using namespace NCB::NBenchmarks;
+
+
+namespace {
+    constexpr ui32 DERS_OBJECT_COUNT = 1000000;
+
+    struct TDersBenchData {
+        TVector<double> Approxes;
+        TVector<double> ExpApproxes;
+        TVector<double> ApproxDeltas;
+        TVector<float> BinaryTargets;
+        TVector<float> Targets;
+        TVector<float> Weights;
+
+    public:
+        TDersBenchData() {
+            TFastRng64 rng(SEED);
+            for (auto i : xrange(DERS_OBJECT_COUNT)) {
+                Y_UNUSED(i);
+                const double approx = 2.0 * rng.GenRandReal1() - 1.0;
+                Approxes.push_back(approx);
+                ExpApproxes.push_back(std::exp(approx));
+                ApproxDeltas.push_back(1.0 + 0.1 * rng.GenRandReal1());
+                BinaryTargets.push_back(rng.GenRandReal1() > 0.5 ? 1.0f : 0.0f);
+                Targets.push_back(rng.GenRandReal1());
+                Weights.push_back(0.5f + rng.GenRandReal1());
+            }
+        }
+    };
+}
+
+
+Y_CPU_BENCHMARK(LoglossCalcDersRange, iface) {
+    const auto& benchData = *Singleton<TDersBenchData>();
+    const TCrossEntropyError error(/*isExpApprox*/ true);
+    TVector<TDers> ders(DERS_OBJECT_COUNT);
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        error.CalcDersRange(
+            0,
+            DERS_OBJECT_COUNT,
+            /*calcThirdDer*/ false,
+            benchData.ExpApproxes.data(),
+            benchData.ApproxDeltas.data(),
+            benchData.BinaryTargets.data(),
+            benchData.Weights.data(),
+            ders.data()
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(ders.data());
+    }
+}
+
+Y_CPU_BENCHMARK(RMSECalcDersRange, iface) {
+    const auto& benchData = *Singleton<TDersBenchData>();
+    const TRMSEError error(/*isExpApprox*/ false);
+    TVector<TDers> ders(DERS_OBJECT_COUNT);
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        error.CalcDersRange(
+            0,
+            DERS_OBJECT_COUNT,
+            /*calcThirdDer*/ false,
+            benchData.Approxes.data(),
+            /*approxDeltas*/ nullptr,
+            benchData.Targets.data(),
+            /*weights*/ nullptr,
+            ders.data()
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(ders.data());
+    }
+}
+
+Y_CPU_BENCHMARK(LoglossCalcFirstDerRange, iface) {
+    const auto& benchData = *Singleton<TDersBenchData>();
+    const TCrossEntropyError error(/*isExpApprox*/ true);
+    TVector<double> firstDers(DERS_OBJECT_COUNT);
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        error.CalcFirstDerRange(
+            0,
+            DERS_OBJECT_COUNT,
+            benchData.ExpApproxes.data(),
+            /*approxDeltas*/ nullptr,
+            benchData.BinaryTargets.data(),
+            /*weights*/ nullptr,
+            firstDers.data()
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(firstDers.data());
+    }
+}
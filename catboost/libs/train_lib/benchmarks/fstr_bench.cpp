@@ -0,0 +1,45 @@
+#include "synthetic_data.h"
+
+#include <catboost/libs/fstr/shap_values.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+
+using namespace NCB;
+using namespace NCB::NBenchmarks;
+
+
+namespace {
+    constexpr ui32 SHAP_OBJECT_COUNT = 2000;
+
+    struct TShapBenchData {
+        TFullModel Model;
+        TDataProviderPtr Dataset;
+
+    public:
+        TShapBenchData() {
+            const auto data = GenerateSyntheticData(OBJECT_COUNT, FLOAT_FEATURE_COUNT, /*catFeatureCount*/ 0);
+            Model = TrainSyntheticModel(MakeDataProvider(data), /*iterations*/ 100, /*depth*/ 6);
+            Dataset = MakeDataProvider(
+                GenerateSyntheticData(SHAP_OBJECT_COUNT, FLOAT_FEATURE_COUNT, /*catFeatureCount*/ 0, SEED + 1)
+            );
+        }
+    };
+}
+
+
+Y_CPU_BENCHMARK(ShapValues, iface) {
+    const auto& benchData = *Singleton<TShapBenchData>();
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        auto shapValues = CalcShapValues(
+            benchData.Model,
+            *benchData.Dataset,
+            /*logPeriod*/ 0,
+            EPreCalcShapValues::Auto,
+            GetBenchmarkLocalExecutor()
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(shapValues.data());
+    }
+}
@@ -0,0 +1,52 @@
+#include "synthetic_data.h"
+
+#include <catboost/libs/metrics/auc.h>
+#include <catboost/libs/metrics/sample.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+using namespace NCB::NBenchmarks;
+
+
+namespace {
+    constexpr ui32 AUC_OBJECT_COUNT = 1000000;
+
+    struct TAucBenchData {
+        TVector<NMetrics::TSample> Samples;
+
+    public:
+        TAucBenchData() {
+            TFastRng64 rng(SEED);
+            for (auto i : xrange(AUC_OBJECT_COUNT)) {
+                Y_UNUSED(i);
+                const double target = rng.GenRandReal1() > 0.8 ? 1.0 : 0.0;
+                Samples.emplace_back(target, target * 0.5 + rng.GenRandReal1(), 1.0);
+            }
+        }
+    };
+}
+
+
+// samples are sorted inplace by CalcAUC, so every iteration works on a fresh copy
+Y_CPU_BENCHMARK(AUC, iface) {
+    const auto& benchData = *Singleton<TAucBenchData>();
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        TVector<NMetrics::TSample> samples = benchData.Samples;
+        Y_DO_NOT_OPTIMIZE_AWAY(CalcAUC(&samples));
+    }
+}
+
+Y_CPU_BENCHMARK(AUCMultiThreaded, iface) {
+    const auto& benchData = *Singleton<TAucBenchData>();
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        TVector<NMetrics::TSample> samples = benchData.Samples;
+        Y_DO_NOT_OPTIMIZE_AWAY(CalcAUC(&samples, GetBenchmarkLocalExecutor()));
+    }
+}
@@ -0,0 +1,97 @@
+#include "synthetic_data.h"
+
+#include <catboost/libs/model/model.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/vector.h>
+
+using namespace NCB;
+using namespace NCB::NBenchmarks;
+
+
+namespace {
+    // 200 trees of depth 6, float features only: BinarizeFeatures and CalcIndexes/leaf gathering
+    struct TFloatModelBenchData {
+        TSyntheticData Data;
+        TVector<TVector<float>> FloatFeaturesRows;
+        TFullModel Model;
+
+    public:
+        TFloatModelBenchData()
+            : Data(GenerateSyntheticData(OBJECT_COUNT, FLOAT_FEATURE_COUNT, /*catFeatureCount*/ 0))
+            , FloatFeaturesRows(Data.GetFloatFeaturesRows())
+            , Model(TrainSyntheticModel(MakeDataProvider(Data), /*iterations*/ 200, /*depth*/ 6))
+        {}
+    };
+
+    // 100 trees of depth 6 with categorical features: adds TStaticCtrProvider::CalcCtrs
+    struct TCatModelBenchData {
+        TSyntheticData Data;
+        TVector<TVector<float>> FloatFeaturesRows;
+        TVector<TVector<int>> CatFeaturesRows;
+        TFullModel Model;
+
+    public:
+        TCatModelBenchData()
+            : Data(GenerateSyntheticData(OBJECT_COUNT, FLOAT_FEATURE_COUNT, CAT_FEATURE_COUNT))
+            , FloatFeaturesRows(Data.GetFloatFeaturesRows())
+            , CatFeaturesRows(Data.GetHashedCatFeaturesRows())
+            , Model(TrainSyntheticModel(MakeDataProvider(Data), /*iterations*/ 100, /*depth*/ 6))
+        {}
+    };
+
+    template <class T>
+    TVector<TConstArrayRef<T>> MakeRowRefs(const TVector<TVector<T>>& rows) {
+        return TVector<TConstArrayRef<T>>(rows.begin(), rows.end());
+    }
+}
+
+
+Y_CPU_BENCHMARK(CalcFlatFloatFeatures, iface) {
+    const auto& benchData = *Singleton<TFloatModelBenchData>();
+    const auto rowRefs = MakeRowRefs(benchData.FloatFeaturesRows);
+    TVector<double> predictions(benchData.Data.GetObjectCount());
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        benchData.Model.CalcFlat(rowRefs, predictions);
+        Y_DO_NOT_OPTIMIZE_AWAY(predictions.data());
+    }
+}
+
+Y_CPU_BENCHMARK(CalcFlatSingleFloatFeatures, iface) {
+    const auto& benchData = *Singleton<TFloatModelBenchData>();
+    double prediction = 0.0;
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        const auto& row = benchData.FloatFeaturesRows[i % benchData.FloatFeaturesRows.size()];
+        benchData.Model.CalcFlatSingle(row, MakeArrayRef(&prediction, 1));
+        Y_DO_NOT_OPTIMIZE_AWAY(prediction);
+    }
+}
+
+Y_CPU_BENCHMARK(CalcLeafIndexesFloatFeatures, iface) {
+    const auto& benchData = *Singleton<TFloatModelBenchData>();
+    const auto& model = benchData.Model;
+    const size_t treeCount = model.GetTreeCount();
+    TVector<ui32> leafIndexes(treeCount);
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        const auto& row = benchData.FloatFeaturesRows[i % benchData.FloatFeaturesRows.size()];
+        model.CalcLeafIndexesSingle(row, TConstArrayRef<TStringBuf>(), 0, treeCount, leafIndexes);
+        Y_DO_NOT_OPTIMIZE_AWAY(leafIndexes.data());
+    }
+}
+
+Y_CPU_BENCHMARK(CalcWithCtrs, iface) {
+    const auto& benchData = *Singleton<TCatModelBenchData>();
+    const auto floatRowRefs = MakeRowRefs(benchData.FloatFeaturesRows);
+    const auto catRowRefs = MakeRowRefs(benchData.CatFeaturesRows);
+    TVector<double> predictions(benchData.Data.GetObjectCount());
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        benchData.Model.Calc(floatRowRefs, catRowRefs, predictions);
+        Y_DO_NOT_OPTIMIZE_AWAY(predictions.data());
+    }
+}
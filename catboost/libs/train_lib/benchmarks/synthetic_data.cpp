@@ -0,0 +1,157 @@
+#include "synthetic_data.h"
+
+#include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+
+
+namespace NCB {
+    namespace NBenchmarks {
+
+        TVector<TVector<float>> TSyntheticData::GetFloatFeaturesRows() const {
+            TVector<TVector<float>> rows(GetObjectCount(), TVector<float>(FloatFeatures.size()));
+            for (auto featureIdx : xrange(FloatFeatures.size())) {
+                for (auto objectIdx : xrange(GetObjectCount())) {
+                    rows[objectIdx][featureIdx] = FloatFeatures[featureIdx][objectIdx];
+                }
+            }
+            return rows;
+        }
+
+        TVector<TVector<int>> TSyntheticData::GetHashedCatFeaturesRows() const {
+            TVector<TVector<int>> rows(GetObjectCount(), TVector<int>(CatFeatures.size()));
+            for (auto featureIdx : xrange(CatFeatures.size())) {
+                for (auto objectIdx : xrange(GetObjectCount())) {
+                    rows[objectIdx][featureIdx] = CalcCatFeatureHashInt(CatFeatures[featureIdx][objectIdx]);
+                }
+            }
+            return rows;
+        }
+
+        TSyntheticData GenerateSyntheticData(
+            ui32 objectCount,
+            ui32 floatFeatureCount,
+            ui32 catFeatureCount,
+            ui64 seed
+        ) {
+            TFastRng64 rng(seed);
+
+            TSyntheticData data;
+            data.FloatFeatures.resize(floatFeatureCount, TVector<float>(objectCount));
+            data.CatFeatures.resize(catFeatureCount, TVector<TString>(objectCount));
+            data.Target.resize(objectCount);
+
+            for (auto objectIdx : xrange(objectCount)) {
+                double score = 0.0;
+                for (auto featureIdx : xrange(floatFeatureCount)) {
+                    const float value = rng.GenRandReal1();
+                    data.FloatFeatures[featureIdx][objectIdx] = value;
+                    score += (featureIdx % 2 ? value : -value) / (featureIdx + 1);
+                }
+                for (auto featureIdx : xrange(catFeatureCount)) {
+                    const ui32 value = rng.Uniform(CAT_FEATURE_UNIQUE_VALUES_COUNT);
+                    data.CatFeatures[featureIdx][objectIdx] = ToString(value);
+                    score += (value % 3 == 0) ? 0.3 : 0.0;
+                }
+                data.Target[objectIdx] = (score + 0.5 * rng.GenRandReal1() > 0.5) ? 1.0f : 0.0f;
+            }
+            return data;
+        }
+
+        TDataProviderPtr MakeDataProvider(const TSyntheticData& data) {
+            const ui32 floatFeatureCount = data.FloatFeatures.size();
+            const ui32 catFeatureCount = data.CatFeatures.size();
+
+            return CreateDataProvider(
+                [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                    TVector<ui32> catFeatureIndices;
+                    for (auto catFeatureIdx : xrange(catFeatureCount)) {
+                        catFeatureIndices.push_back(floatFeatureCount + catFeatureIdx);
+                    }
+
+                    TDataMetaInfo metaInfo;
+                    metaInfo.HasTarget = true;
+                    metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                        floatFeatureCount + catFeatureCount,
+                        catFeatureIndices,
+                        TVector<ui32>{},
+                        TVector<TString>{}
+                    );
+
+                    visitor->Start(metaInfo, data.GetObjectCount(), EObjectsOrder::Undefined, {});
+
+                    for (auto featureIdx : xrange(floatFeatureCount)) {
+                        visitor->AddFloatFeature(
+                            featureIdx,
+                            TMaybeOwningConstArrayHolder<float>::CreateOwning(
+                                TVector<float>(data.FloatFeatures[featureIdx])
+                            )
+                        );
+                    }
+                    for (auto catFeatureIdx : xrange(catFeatureCount)) {
+                        visitor->AddCatFeature(
+                            floatFeatureCount + catFeatureIdx,
+                            TConstArrayRef<TString>(data.CatFeatures[catFeatureIdx])
+                        );
+                    }
+                    visitor->AddTarget(data.Target);
+
+                    visitor->Finish();
+                }
+            );
+        }
+
+        TFullModel TrainSyntheticModel(
+            TDataProviderPtr learnData,
+            ui32 iterations,
+            ui32 depth,
+            ui32 threadCount
+        ) {
+            TDataProviders dataProviders;
+            dataProviders.Learn = std::move(learnData);
+
+            NJson::TJsonValue params;
+            params.InsertValue("loss_function", "Logloss");
+            params.InsertValue("iterations", iterations);
+            params.InsertValue("depth", depth);
+            params.InsertValue("random_seed", SEED);
+            params.InsertValue("thread_count", threadCount);
+            params.InsertValue("logging_level", "Silent");
+            params.InsertValue("allow_writing_files", false);
+
+            TFullModel model;
+            TrainModel(
+                params,
+                nullptr,
+                Nothing(),
+                Nothing(),
+                std::move(dataProviders),
+                /*initModel*/ Nothing(),
+                /*initLearnProgress*/ nullptr,
+                "",
+                &model,
+                /*evalResultPtrs*/ {}
+            );
+            return model;
+        }
+
+        namespace {
+            struct TBenchmarkLocalExecutor : public NPar::TLocalExecutor {
+                TBenchmarkLocalExecutor() {
+                    RunAdditionalThreads(THREAD_COUNT - 1);
+                }
+            };
+        }
+
+        NPar::TLocalExecutor* GetBenchmarkLocalExecutor() {
+            return Singleton<TBenchmarkLocalExecutor>();
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <catboost/libs/data/data_provider.h>
+#include <catboost/libs/model/model.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+    namespace NBenchmarks {
+
+        // fixed sizes and seed to make benchmark results comparable between runs
+        constexpr ui32 OBJECT_COUNT = 20000;
+        constexpr ui32 FLOAT_FEATURE_COUNT = 50;
+        constexpr ui32 CAT_FEATURE_COUNT = 10;
+        constexpr ui32 CAT_FEATURE_UNIQUE_VALUES_COUNT = 100;
+        constexpr ui64 SEED = 20200123;
+
+        constexpr ui32 THREAD_COUNT = 4;
+
+        struct TSyntheticData {
+            TVector<TVector<float>> FloatFeatures; // [featureIdx][objectIdx]
+            TVector<TVector<TString>> CatFeatures; // [featureIdx][objectIdx]
+            TVector<float> Target; // binary, depends on features
+
+        public:
+            ui32 GetObjectCount() const {
+                return Target.size();
+            }
+
+            // [objectIdx][featureIdx]
+            TVector<TVector<float>> GetFloatFeaturesRows() const;
+
+            // [objectIdx][featureIdx], hashed with CalcCatFeatureHash
+            TVector<TVector<int>> GetHashedCatFeaturesRows() const;
+        };
+
+        TSyntheticData GenerateSyntheticData(
+            ui32 objectCount,
+            ui32 floatFeatureCount,
+            ui32 catFeatureCount,
+            ui64 seed = SEED
+        );
+
+        TDataProviderPtr MakeDataProvider(const TSyntheticData& data);
+
+        TFullModel TrainSyntheticModel(
+            TDataProviderPtr learnData,
+            ui32 iterations,
+            ui32 depth,
+            ui32 threadCount = THREAD_COUNT
+        );
+
+        NPar::TLocalExecutor* GetBenchmarkLocalExecutor();
+    }
+}
@@ -0,0 +1,48 @@
+#include "synthetic_data.h"
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+
+using namespace NCB;
+using namespace NCB::NBenchmarks;
+
+
+/* Standalone calls of CalcStatsAndScores and ComputeOnlineCTRs require a fully
+ * initialized TLearnContext, so they are measured with short training runs
+ * where they dominate: tree structure search over float features and online CTRs
+ * computation for categorical features.
+ */
+
+namespace {
+    struct TFloatPoolBenchData {
+        TDataProviderPtr Pool = MakeDataProvider(
+            GenerateSyntheticData(OBJECT_COUNT, FLOAT_FEATURE_COUNT, /*catFeatureCount*/ 0)
+        );
+    };
+
+    struct TCatPoolBenchData {
+        TDataProviderPtr Pool = MakeDataProvider(
+            GenerateSyntheticData(OBJECT_COUNT, /*floatFeatureCount*/ 0, CAT_FEATURE_COUNT)
+        );
+    };
+}
+
+
+Y_CPU_BENCHMARK(TrainFloatFeatures, iface) {
+    const auto& benchData = *Singleton<TFloatPoolBenchData>();
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        auto model = TrainSyntheticModel(benchData.Pool, /*iterations*/ 10, /*depth*/ 6);
+        Y_DO_NOT_OPTIMIZE_AWAY(model.GetTreeCount());
+    }
+}
+
+Y_CPU_BENCHMARK(TrainCatFeatures, iface) {
+    const auto& benchData = *Singleton<TCatPoolBenchData>();
+
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        auto model = TrainSyntheticModel(benchData.Pool, /*iterations*/ 10, /*depth*/ 6);
+        Y_DO_NOT_OPTIMIZE_AWAY(model.GetTreeCount());
+    }
+}
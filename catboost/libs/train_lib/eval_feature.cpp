@@ -15,6 +15,7 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/parallel_tasks.h>
 #include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/libs/helpers/sequential_test.h>
 #include <catboost/libs/helpers/vector_helpers.h>
 #include <catboost/libs/helpers/wx_test.h>
 #include <catboost/libs/loggers/catboost_logger_helpers.h>
@@ -55,10 +56,14 @@ TString ToString(const TFeatureEvaluationSummary& summary) {
     TString featureEvalTsv;
 
     TStringOutput featureEvalStream(featureEvalTsv);
+    const bool hasSequentialTests = !summary.SequentialTests.empty();
     featureEvalStream << "p-value\tbest iteration in each fold\t";
     for (const auto& metricName : summary.MetricNames) {
         featureEvalStream << metricName << '\t';
     }
+    if (hasSequentialTests) {
+        featureEvalStream << "sequential test verdict\tevaluated fold count\t";
+    }
     featureEvalStream << "feature set" << Endl;
     for (ui32 featureSetIdx : xrange(summary.FeatureSets.size())) {
         featureEvalStream << summary.WxTest[featureSetIdx] << '\t';
@@ -68,6 +73,10 @@ TString ToString(const TFeatureEvaluationSummary& summary) {
         for (double delta : summary.AverageMetricDelta[featureSetIdx]) {
             featureEvalStream << delta << '\t';
         }
+        if (hasSequentialTests) {
+            featureEvalStream << summary.SequentialTests[featureSetIdx].GetVerdict() << '\t';
+            featureEvalStream << bestIterations.size() << '\t';
+        }
         const auto& featureSet = summary.FeatureSets[featureSetIdx];
         featureEvalStream << JoinRange(",", featureSet.begin(), featureSet.end());
         featureEvalStream << Endl;
@@ -116,7 +125,7 @@ static ui32 GetBestIterationInFold(
 
 static TVector<ui32> GetBestIterations(
     const TVector<EMetricBestValue>& bestValueType,
-    const TVector<TFoldContext>& folds
+    TConstArrayRef<TFoldContext> folds
 ) {
     TVector<ui32> bestIterations; // [foldIdx]
     for (const auto& fold : folds) {
@@ -130,7 +139,7 @@ static TVector<ui32> GetBestIterations(
 static TVector<double> GetMetricValues(
     ui32 metricIdx,
     const TVector<ui32>& bestIterations,
-    const TVector<TFoldContext>& folds
+    TConstArrayRef<TFoldContext> folds
 ) {
     Y_ASSERT(bestIterations.size() == folds.size());
     TVector<double> metricValues;
@@ -142,10 +151,29 @@ static TVector<double> GetMetricValues(
     return metricValues;
 }
 
+// sign of the loss improvement of tested over baseline at their best iterations
+static int CompareBestLoss(
+    const TVector<EMetricBestValue>& bestValueType,
+    const TFoldContext& baselineFold,
+    const TFoldContext& testedFold
+) {
+    constexpr ui32 lossIdx = 0;
+    const auto getBestLoss = [&] (const TFoldContext& fold) {
+        return fold.MetricValuesOnTest[GetBestIterationInFold(bestValueType, fold.MetricValuesOnTest)][lossIdx];
+    };
+    const double baselineLoss = getBestLoss(baselineFold);
+    const double testedLoss = getBestLoss(testedFold);
+    if (baselineLoss == testedLoss) {
+        return 0;
+    }
+    const bool isTestedLess = testedLoss < baselineLoss;
+    return isTestedLess == (bestValueType[lossIdx] == EMetricBestValue::Min) ? 1 : -1;
+}
+
 void TFeatureEvaluationSummary::AppendFeatureSetMetrics(
     ui32 featureSetIdx,
-    const TVector<TFoldContext>& baselineFolds,
-    const TVector<TFoldContext>& testedFolds
+    TConstArrayRef<TFoldContext> baselineFolds,
+    TConstArrayRef<TFoldContext> testedFolds
 ) {
     const auto featureSetCount = FeatureSets.size();
     CB_ENSURE_INTERNAL(featureSetIdx < featureSetCount, "Feature set index is too large");
@@ -661,79 +689,96 @@ static void EvaluateFeaturesImpl(
     const ui32 iterationCount = dataSpecificOptions.BoostingOptions->IterationCount;
     const THolder<ITrainingCallbacks> evalFeatureCallbacks = MakeHolder<TEvalFeatureCallbacks>(iterationCount);
 
-    const auto trainFullModels = [&] (
+    const auto genFoldRandomSeeds = [&] () {
+        TVector<ui64> randomSeeds(foldCount);
+        for (auto& randomSeed : randomSeeds) {
+            randomSeed = rand.GenRand();
+        }
+        return randomSeeds;
+    };
+
+    // folds are trained in order, so foldContexts always contain a prefix of folds
+    const auto trainFoldModel = [&] (
         const TString& trainDirPrefix,
+        ui32 foldIdx,
+        ui64 randomSeed,
         TVector<TTrainingDataProviders>* foldsData,
         TVector<TFoldContext>* foldContexts) {
-        Y_ASSERT(foldContexts->empty());
+        Y_ASSERT(foldContexts->size() == foldIdx);
         const ui32 offset = cvParams.Initialized() ? 0 : featureEvalOptions.Offset.Get();
-        for (auto foldIdx : xrange(foldCount)) {
-            foldContexts->emplace_back(
-                offset + foldIdx,
-                taskType,
-                outputFileOptions,
-                std::move((*foldsData)[foldIdx]),
-                rand.GenRand(),
-                /*hasFullModel*/true
-            );
-        }
+        foldContexts->emplace_back(
+            offset + foldIdx,
+            taskType,
+            outputFileOptions,
+            std::move((*foldsData)[foldIdx]),
+            randomSeed,
+            /*hasFullModel*/true
+        );
+        auto& foldContext = foldContexts->back();
 
         const auto topLevelTrainDir = outputFileOptions.GetTrainDir();
         const bool isCalcFstr = outputFileOptions.CreateFstrRegularFullPath() || outputFileOptions.CreateFstrIternalFullPath();
 
-        for (auto foldIdx : xrange(foldCount)) {
-            THPTimer timer;
-            TErrorTracker errorTracker = CreateErrorTracker(
-                overfittingDetectorOptions,
-                bestPossibleValue,
-                bestValueType,
-                /*hasTest*/(*foldsData)[foldIdx].Test.size());
-
-            const auto foldTrainDir = trainDirPrefix + "fold_" + ToString((*foldContexts)[foldIdx].FoldIdx + results->FoldRangeOffset);
-            Train(
-                dataSpecificOptions,
-                JoinFsPaths(topLevelTrainDir, foldTrainDir),
-                objectiveDescriptor,
-                evalMetricDescriptor,
-                labelConverter,
-                metrics,
-                errorTracker.IsActive(),
-                evalFeatureCallbacks,
-                &(*foldContexts)[foldIdx],
-                modelTrainerHolder.Get(),
-                &NPar::LocalExecutor()
-            );
-            CB_ENSURE(
-                (*foldContexts)[foldIdx].FullModel.Defined(),
-                "Fold " << (*foldContexts)[foldIdx].FoldIdx << ": model is missing"
-            );
-            const auto treeCount = (*foldContexts)[foldIdx].FullModel->GetTreeCount();
-            CB_ENSURE(
-                iterationCount == treeCount,
-                "Fold " << (*foldContexts)[foldIdx].FoldIdx << ": model size (" << treeCount <<
-                ") differs from iteration count (" << iterationCount << ")"
-            );
-            CATBOOST_INFO_LOG << "Fold " << (*foldContexts)[foldIdx].FoldIdx << ": model built in " <<
-                FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec" << Endl;
-
-            if (isCalcFstr) {
-                auto foldOutputOptions = outputFileOptions;
-                foldOutputOptions.SetTrainDir(JoinFsPaths(topLevelTrainDir, foldTrainDir));
-                const auto foldRegularFstrPath = foldOutputOptions.CreateFstrRegularFullPath();
-                const auto foldInternalFstrPath = foldOutputOptions.CreateFstrIternalFullPath();
-                const auto& model = (*foldContexts)[foldIdx].FullModel.GetRef();
-                CalcAndOutputFstr(
-                    model,
-                    /*dataset*/nullptr,
-                    &NPar::LocalExecutor(),
-                    foldRegularFstrPath ? &foldRegularFstrPath : nullptr,
-                    foldInternalFstrPath ? &foldInternalFstrPath : nullptr,
-                    outputFileOptions.GetFstrType());
-            }
+        THPTimer timer;
+        TErrorTracker errorTracker = CreateErrorTracker(
+            overfittingDetectorOptions,
+            bestPossibleValue,
+            bestValueType,
+            /*hasTest*/foldContext.TrainingData.Test.size());
+
+        const auto foldTrainDir = trainDirPrefix + "fold_" + ToString(foldContext.FoldIdx + results->FoldRangeOffset);
+        Train(
+            dataSpecificOptions,
+            JoinFsPaths(topLevelTrainDir, foldTrainDir),
+            objectiveDescriptor,
+            evalMetricDescriptor,
+            labelConverter,
+            metrics,
+            errorTracker.IsActive(),
+            evalFeatureCallbacks,
+            &foldContext,
+            modelTrainerHolder.Get(),
+            &NPar::LocalExecutor()
+        );
+        CB_ENSURE(
+            foldContext.FullModel.Defined(),
+            "Fold " << foldContext.FoldIdx << ": model is missing"
+        );
+        const auto treeCount = foldContext.FullModel->GetTreeCount();
+        CB_ENSURE(
+            iterationCount == treeCount,
+            "Fold " << foldContext.FoldIdx << ": model size (" << treeCount <<
+            ") differs from iteration count (" << iterationCount << ")"
+        );
+        CATBOOST_INFO_LOG << "Fold " << foldContext.FoldIdx << ": model built in " <<
+            FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec" << Endl;
+
+        if (isCalcFstr) {
+            auto foldOutputOptions = outputFileOptions;
+            foldOutputOptions.SetTrainDir(JoinFsPaths(topLevelTrainDir, foldTrainDir));
+            const auto foldRegularFstrPath = foldOutputOptions.CreateFstrRegularFullPath();
+            const auto foldInternalFstrPath = foldOutputOptions.CreateFstrIternalFullPath();
+            const auto& model = foldContext.FullModel.GetRef();
+            CalcAndOutputFstr(
+                model,
+                /*dataset*/nullptr,
+                &NPar::LocalExecutor(),
+                foldRegularFstrPath ? &foldRegularFstrPath : nullptr,
+                foldInternalFstrPath ? &foldInternalFstrPath : nullptr,
+                outputFileOptions.GetFstrType());
         }
 
+        (*foldsData)[foldIdx] = std::move(foldContext.TrainingData);
+    };
+
+    const auto trainFullModels = [&] (
+        const TString& trainDirPrefix,
+        TConstArrayRef<ui64> randomSeeds,
+        TVector<TTrainingDataProviders>* foldsData,
+        TVector<TFoldContext>* foldContexts) {
+        Y_ASSERT(foldContexts->empty());
         for (auto foldIdx : xrange(foldCount)) {
-            (*foldsData)[foldIdx] = std::move((*foldContexts)[foldIdx].TrainingData);
+            trainFoldModel(trainDirPrefix, foldIdx, randomSeeds[foldIdx], foldsData, foldContexts);
         }
 
         if (testFoldsData) {
@@ -745,26 +790,47 @@ static void EvaluateFeaturesImpl(
 
     if (featureEvalOptions.FeaturesToEvaluate->empty()) {
         auto baselineDirPrefix = TStringBuilder() << "Baseline_";
-        trainFullModels(baselineDirPrefix, &foldsData, &baselineFoldContexts);
+        trainFullModels(baselineDirPrefix, genFoldRandomSeeds(), &foldsData, &baselineFoldContexts);
         return;
     }
 
+    const bool isSequentialTesting = featureEvalOptions.SequentialTesting.Get();
+    if (isSequentialTesting && results->SequentialTests.empty()) {
+        const TSequentialSignTest sequentialTest(
+            featureEvalOptions.SequentialTestSignificance.Get(),
+            featureEvalOptions.SequentialTestWinProbability.Get());
+        results->SequentialTests.resize(featureEvalOptions.FeaturesToEvaluate->size(), sequentialTest);
+    }
+
     const auto useCommonBaseline = featureEvalOptions.FeatureEvalMode != NCB::EFeatureEvalMode::OneVsOthers;
+    TVector<TTrainingDataProviders> baselineFoldsData;
+    TVector<ui64> baselineRandomSeeds;
+    TString baselineDirPrefix;
     for (ui32 featureSetIdx : xrange(featureEvalOptions.FeaturesToEvaluate->size())) {
         const auto haveBaseline = featureSetIdx > 0 && useCommonBaseline;
         if (!haveBaseline) {
-            auto newFoldsData = UpdateIgnoredFeaturesInLearn(
+            baselineFoldsData = UpdateIgnoredFeaturesInLearn(
                 taskType,
                 featureEvalOptions,
                 ETrainingKind::Baseline,
                 featureSetIdx,
                 foldsData);
             baselineFoldContexts.clear();
-            auto baselineDirPrefix = TStringBuilder() << "Baseline_";
+            baselineDirPrefix = TStringBuilder() << "Baseline_";
             if (!useCommonBaseline) {
-                baselineDirPrefix << "set_" << featureSetIdx << "_";
+                baselineDirPrefix += TStringBuilder() << "set_" << featureSetIdx << "_";
             }
-            trainFullModels(baselineDirPrefix, &newFoldsData, &baselineFoldContexts);
+            baselineRandomSeeds = genFoldRandomSeeds();
+            // in sequential mode baseline folds are trained on demand, when some feature set needs them
+            if (!isSequentialTesting) {
+                trainFullModels(baselineDirPrefix, baselineRandomSeeds, &baselineFoldsData, &baselineFoldContexts);
+            }
+        }
+
+        // seeds are drawn for decided feature sets too, so that folds get the same seeds as in the full mode
+        const auto testedRandomSeeds = genFoldRandomSeeds();
+        if (isSequentialTesting && results->SequentialTests[featureSetIdx].GetVerdict() != ESequentialTestVerdict::Undecided) {
+            continue;
         }
 
         TVector<TFoldContext> testedFoldContexts;
@@ -775,9 +841,32 @@ static void EvaluateFeaturesImpl(
             featureSetIdx,
             foldsData);
         const auto testingDirPrefix = TStringBuilder() << "Testing_set_" << featureSetIdx << "_";
-        trainFullModels(testingDirPrefix, &newFoldsData, &testedFoldContexts);
+        if (!isSequentialTesting) {
+            trainFullModels(testingDirPrefix, testedRandomSeeds, &newFoldsData, &testedFoldContexts);
+            results->AppendFeatureSetMetrics(featureSetIdx, baselineFoldContexts, testedFoldContexts);
+            continue;
+        }
 
-        results->AppendFeatureSetMetrics(featureSetIdx, baselineFoldContexts, testedFoldContexts);
+        auto& sequentialTest = results->SequentialTests[featureSetIdx];
+        for (auto foldIdx : xrange(foldCount)) {
+            if (baselineFoldContexts.size() == foldIdx) {
+                trainFoldModel(baselineDirPrefix, foldIdx, baselineRandomSeeds[foldIdx], &baselineFoldsData, &baselineFoldContexts);
+            }
+            trainFoldModel(testingDirPrefix, foldIdx, testedRandomSeeds[foldIdx], &newFoldsData, &testedFoldContexts);
+            const int lossImprovement = CompareBestLoss(
+                results->MetricTypes,
+                baselineFoldContexts[foldIdx],
+                testedFoldContexts[foldIdx]);
+            if (lossImprovement != 0 && sequentialTest.AddOutcome(lossImprovement > 0) != ESequentialTestVerdict::Undecided) {
+                CATBOOST_NOTICE_LOG << "Feature set " << featureSetIdx << ": " << sequentialTest.GetVerdict()
+                    << " than baseline after " << sequentialTest.GetOutcomeCount() << " folds with different loss" << Endl;
+                break;
+            }
+        }
+        results->AppendFeatureSetMetrics(
+            featureSetIdx,
+            MakeArrayRef(baselineFoldContexts.data(), testedFoldContexts.size()),
+            testedFoldContexts);
     }
 }
 
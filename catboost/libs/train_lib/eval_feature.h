@@ -2,12 +2,14 @@
 
 #include <catboost/private/libs/algo_helpers/custom_objective_descriptor.h>
 #include <catboost/libs/data/data_provider.h>
+#include <catboost/libs/helpers/sequential_test.h>
 #include <catboost/libs/metrics/metric.h>
 #include <catboost/private/libs/options/feature_eval_options.h>
 #include <catboost/libs/train_lib/cross_validation.h>
 
 #include <library/json/json_value.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
 #include <util/generic/string.h>
@@ -26,6 +28,8 @@ struct TFeatureEvaluationSummary {
     TVector<double> WxTest; // [feature set count]
     TVector<TVector<double>> AverageMetricDelta; // [feature set count][metric count]
 
+    TVector<TSequentialSignTest> SequentialTests; // [feature set count], empty without sequential testing
+
     ui32 FoldRangeOffset;
 
 public:
@@ -37,8 +41,8 @@ public:
 
     void AppendFeatureSetMetrics(
         ui32 featureSetIdx,
-        const TVector<TFoldContext>& baselineFoldContexts,
-        const TVector<TFoldContext>& testedFoldContexts);
+        TConstArrayRef<TFoldContext> baselineFoldContexts,
+        TConstArrayRef<TFoldContext> testedFoldContexts);
 
     void CalcWxTestAndAverageDelta();
 };
@@ -38,6 +38,7 @@
 #include <catboost/private/libs/pairs/util.h>
 #include <catboost/private/libs/target/classification_target_helper.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/grid_creator/binarization.h>
 #include <library/json/json_prettifier.h>
 
@@ -226,6 +227,15 @@ static bool ShouldCalcAllMetrics(ui32 iter, const TMetricsData& metricsData, con
         !(iterWithOffset % SafeIntegerCast<ui32>(ctx.OutputOptions.GetMetricPeriod()));
 }
 
+static bool ShouldUseMetricsSubsample(ui32 iter, const TMetricsData& metricsData, const TLearnContext& ctx) {
+    return ShouldUseMetricsSubsample(
+        iter + metricsData.MetricPeriodOffset.GetOrElse(0),
+        ctx.Params.BoostingOptions->IterationCount,
+        ctx.OutputOptions.GetMetricSampleRate(),
+        SafeIntegerCast<ui32>(ctx.OutputOptions.GetFullMetricPeriod())
+    );
+}
+
 static bool ShouldCalcErrorTrackerMetric(ui32 iter, const TMetricsData& metricsData, const TLearnContext& ctx) {
     return ShouldCalcAllMetrics(iter, metricsData, ctx) || metricsData.CalcEvalMetricOnEveryIteration;
 }
@@ -332,7 +342,14 @@ static void CalcErrors(
     int iter,
     TLearnContext* ctx) {
 
-    CalcErrors(data, metricsData.Metrics, ShouldCalcAllMetrics(iter, metricsData, *ctx), ShouldCalcErrorTrackerMetric(iter, metricsData, *ctx), ctx);
+    CalcErrors(
+        data,
+        metricsData.Metrics,
+        ShouldCalcAllMetrics(iter, metricsData, *ctx),
+        ShouldCalcErrorTrackerMetric(iter, metricsData, *ctx),
+        ShouldUseMetricsSubsample(iter, metricsData, *ctx),
+        ctx
+    );
 }
 
 static void Train(
@@ -344,6 +361,13 @@ static void Train(
 ) {
     TProfileInfo& profile = ctx->Profile;
 
+    THolder<NChromiumTrace::TGlobalJsonFileSink> chromeTraceSink;
+    if (ctx->OutputOptions.AllowWriteFiles() && ctx->OutputOptions.NeedChromeTraceLog()) {
+        chromeTraceSink = MakeHolder<NChromiumTrace::TGlobalJsonFileSink>(
+            ctx->OutputOptions.CreateChromeTraceLogFullPath());
+        CHROMIUM_TRACE_THREAD_NAME("Train");
+    }
+
     TMetricsData metricsData;
     InitializeAndCheckMetricData(internalOptions, data, *ctx, &metricsData);
 
@@ -385,6 +409,10 @@ static void Train(
 
         profile.StartNextIteration();
 
+        NChromiumTrace::TEventArgs iterationTraceArgs;
+        iterationTraceArgs.Add("iteration", i64(iter));
+        CATBOOST_TRACE_SCOPE_W_ARGS("Iteration", &iterationTraceArgs);
+
         if (timer.Passed() > ctx->OutputOptions.GetSnapshotSaveInterval()) {
             profile.AddOperation("Save snapshot");
             ctx->SaveProgress(onSnapshotSavedCallback);
@@ -393,7 +421,10 @@ static void Train(
 
         TrainOneIteration(data, ctx);
 
-        CalcErrors(data, metricsData, iter, ctx);
+        {
+            CATBOOST_TRACE_SCOPE("Calc errors");
+            CalcErrors(data, metricsData, iter, ctx);
+        }
 
         profile.AddOperation("Calc errors");
 
@@ -417,6 +448,11 @@ static void Train(
             }
         }
 
+        if (errorTracker && errorTracker->GetIsNeedStop()) {
+            // training stops at this iteration, so its metrics must not be left calculated on a subsample
+            RecalcSubsampledErrors(data, metrics, ctx);
+        }
+
         profile.FinishIteration();
 
         TProfileResults profileResults = profile.GetProfileResults();
@@ -709,7 +745,6 @@ namespace {
             const auto& systemOptions = ctx.Params.SystemOptions;
             if (!systemOptions->IsSingleHost()) { // send target, weights, baseline (if present), binarized features to workers and ask them to create plain folds
                 CB_ENSURE(IsPlainMode(ctx.Params.BoostingOptions->BoostingType), "Distributed training requires plain boosting");
-                CB_ENSURE(!ctx.Layout->GetCatFeatureCount(), "Distributed training doesn't support categorical features");
                 MapBuildPlainFold(&ctx);
             }
             TVector<TVector<double>> oneRawValues(ctx.LearnProgress->ApproxDimension);
@@ -879,6 +914,14 @@ static void TrainModel(
     if (catBoostOptions.SystemOptions->IsMaster()) {
         InitializeMaster(catBoostOptions.SystemOptions);
         if (isQuantizedLearn && IsSharedFs(poolLoadOptions->LearnSetPath)) {
+            // final ctr tables are calculated on master, so it needs learn features
+            CB_ENSURE(
+                quantizedFeaturesInfo->CalcMaxCategoricalFeaturesUniqueValuesCountOnLearn()
+                <= catBoostOptions.CatFeatureParams->OneHotMaxSize.Get(),
+                "Distributed training with learn pool on shared file system doesn't support categorical features"
+                " with more than one_hot_max_size (" << catBoostOptions.CatFeatureParams->OneHotMaxSize.Get()
+                << ") unique values"
+            );
             SetTrainDataFromQuantizedPool(
                 *poolLoadOptions,
                 catBoostOptions,
@@ -110,6 +110,34 @@ namespace {
     };
 }
 
+static TVector<TVector<double>> PrepareApproxesFromFlat(
+    const TFullModel& model,
+    int docCount,
+    const EPredictionType predictionType,
+    TVector<double>* approxesFlat,
+    TLocalExecutor* executor)
+{
+    const int approxesDimension = model.GetDimensionsCount();
+    TVector<TVector<double>> approxes(approxesDimension);
+    if (approxesDimension == 1) { //shortcut
+        approxes[0].swap(*approxesFlat);
+    } else {
+        for (int dim = 0; dim < approxesDimension; ++dim) {
+            approxes[dim].yresize(docCount);
+            for (int doc = 0; doc < docCount; ++doc) {
+                approxes[dim][doc] = (*approxesFlat)[approxesDimension * doc + dim];
+            };
+        }
+    }
+
+    if (predictionType == EPredictionType::InternalRawFormulaVal) {
+        //shortcut
+        return approxes;
+    } else {
+        return PrepareEvalForInternalApprox(predictionType, model, approxes, executor);
+    }
+}
+
 TVector<TVector<double>> ApplyModelMulti(
     const TFullModel& model,
     const TObjectsDataProvider& objectsData,
@@ -143,24 +171,7 @@ TVector<TVector<double>> ApplyModelMulti(
         }
     }
 
-    TVector<TVector<double>> approxes(approxesDimension);
-    if (approxesDimension == 1) { //shortcut
-        approxes[0].swap(approxesFlat);
-    } else {
-        for (int dim = 0; dim < approxesDimension; ++dim) {
-            approxes[dim].yresize(docCount);
-            for (int doc = 0; doc < docCount; ++doc) {
-                approxes[dim][doc] = approxesFlat[approxesDimension * doc + dim];
-            };
-        }
-    }
-
-    if (predictionType == EPredictionType::InternalRawFormulaVal) {
-        //shortcut
-        return approxes;
-    } else {
-        return PrepareEvalForInternalApprox(predictionType, model, approxes, executor);
-    }
+    return PrepareApproxesFromFlat(model, docCount, predictionType, &approxesFlat, executor);
 }
 
 TVector<TVector<double>> ApplyModelMulti(
@@ -200,6 +211,62 @@ TVector<TVector<double>> ApplyModelMulti(
     return approxes;
 }
 
+TVector<TVector<double>> ApplyModelMultiSparse(
+    const TFullModel& model,
+    const NModelEvaluation::TSparseFloatFeatures& features,
+    const EPredictionType predictionType,
+    int begin,
+    int end,
+    TLocalExecutor* executor)
+{
+    const int docCount = SafeIntegerCast<int>(features.ObjectCount);
+    const int approxesDimension = model.GetDimensionsCount();
+    TVector<double> approxesFlat(docCount * approxesDimension);
+    if (docCount > 0) {
+        end = end == 0 ? model.GetTreeCount() : Min<int>(end, model.GetTreeCount());
+        const auto modelEvaluator = model.GetCurrentEvaluator();
+        if (features.ColumnMajor || !executor) {
+            // columns can't be split by objects without a search in each of them
+            modelEvaluator->CalcFlatSparse(features, begin, end, approxesFlat);
+        } else {
+            auto blockParams = GetBlockParams(executor->GetThreadCount(), docCount, begin, end);
+            executor->ExecRangeWithThrow(
+                [&] (int blockId) {
+                    const int blockFirstIdx = blockParams.FirstId + blockId * blockParams.GetBlockSize();
+                    const int blockLastIdx = Min(blockParams.LastId, blockFirstIdx + blockParams.GetBlockSize());
+                    // offsets are absolute, so the rows of the block share indices and values with the whole matrix
+                    auto blockFeatures = features;
+                    blockFeatures.ObjectCount = blockLastIdx - blockFirstIdx;
+                    blockFeatures.Offsets = features.Offsets.Slice(blockFirstIdx, blockFeatures.ObjectCount + 1);
+                    modelEvaluator->CalcFlatSparse(
+                        blockFeatures,
+                        begin,
+                        end,
+                        MakeArrayRef(
+                            approxesFlat.data() + blockFirstIdx * approxesDimension,
+                            blockFeatures.ObjectCount * approxesDimension));
+                },
+                0,
+                blockParams.GetBlockCount(),
+                TLocalExecutor::WAIT_COMPLETE);
+        }
+    }
+    return PrepareApproxesFromFlat(model, docCount, predictionType, &approxesFlat, executor);
+}
+
+TVector<TVector<double>> ApplyModelMultiSparse(
+    const TFullModel& model,
+    const NModelEvaluation::TSparseFloatFeatures& features,
+    const EPredictionType predictionType,
+    int begin,
+    int end,
+    int threadCount)
+{
+    NPar::TLocalExecutor executor;
+    executor.RunAdditionalThreads(threadCount - 1);
+    return ApplyModelMultiSparse(model, features, predictionType, begin, end, &executor);
+}
+
 void TModelCalcerOnPool::ApplyModelMulti(
     const EPredictionType predictionType,
     int begin,
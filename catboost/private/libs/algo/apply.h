@@ -46,6 +46,26 @@ TVector<TVector<double>> ApplyModelMulti(
     int end = 0,
     int threadCount = 1);
 
+/*
+ * Model application on float features in CSR or CSC format, see TFullModel::CalcFlatSparse.
+ * CSR input is split between threads by objects, CSC input is evaluated in one thread.
+ */
+TVector<TVector<double>> ApplyModelMultiSparse(
+    const TFullModel& model,
+    const NCB::NModelEvaluation::TSparseFloatFeatures& features,
+    const EPredictionType predictionType,
+    int begin,
+    int end,
+    NPar::TLocalExecutor* executor);
+
+TVector<TVector<double>> ApplyModelMultiSparse(
+    const TFullModel& model,
+    const NCB::NModelEvaluation::TSparseFloatFeatures& features,
+    const EPredictionType predictionType = EPredictionType::RawFormulaVal,
+    int begin = 0,
+    int end = 0,
+    int threadCount = 1);
+
 /*
  * Tradeoff memory for speed
  * Don't use if you need to compute model only once and on all features
@@ -152,6 +152,21 @@ static void CalcLeafDersImpl(
     }
 }
 
+template <bool StoreExpApprox>
+static void ApplyLeafDeltas(
+    TConstArrayRef<double> leafDeltas,
+    const TIndexType* indices,
+    int count,
+    double* approxes) {
+    for (int idx = 0; idx < count; ++idx) {
+        approxes[idx] = UpdateApprox<StoreExpApprox>(approxes[idx], leafDeltas[indices[idx]]);
+    }
+}
+
+/* If pendingLeafDeltas are not empty they are applied to approxesToUpdate (which must be the same
+ * array as approxes) block by block right before derivatives of the block are calculated, so that
+ * updating approxes with the previous leaf estimation step doesn't require a separate pass.
+ */
 static void CalcLeafDers(
     TConstArrayRef<TIndexType> indices,
     TConstArrayRef<float> targets,
@@ -162,9 +177,13 @@ static void CalcLeafDers(
     int sampleCount,
     bool recalcLeafWeights,
     ELeavesEstimation estimationMethod,
+    TConstArrayRef<double> pendingLeafDeltas,
+    TArrayRef<double> approxesToUpdate,
     NPar::TLocalExecutor* localExecutor,
     TArrayRef<TSum> leafDers,
     TArrayRef<TDers> weightedDers) {
+    Y_ASSERT(pendingLeafDeltas.empty() || approxesToUpdate.data() == approxes.data());
+    const bool storeExpApprox = error.GetIsExpApprox();
     NPar::TLocalExecutor::TExecRangeParams blockParams(0, sampleCount);
     blockParams.SetBlockCount(CB_THREAD_LIMIT);
 
@@ -196,6 +215,21 @@ static void CalcLeafDers(
                  innerBlockStart < nextBlockStart;
                  innerBlockStart += innerBlockSize) {
                 const int innerCount = Min(nextBlockStart - innerBlockStart, innerBlockSize);
+                if (!pendingLeafDeltas.empty()) {
+                    if (storeExpApprox) {
+                        ApplyLeafDeltas</*StoreExpApprox*/true>(
+                            pendingLeafDeltas,
+                            indices.data() + innerBlockStart,
+                            innerCount,
+                            approxesToUpdate.data() + innerBlockStart);
+                    } else {
+                        ApplyLeafDeltas</*StoreExpApprox*/false>(
+                            pendingLeafDeltas,
+                            indices.data() + innerBlockStart,
+                            innerCount,
+                            approxesToUpdate.data() + innerBlockStart);
+                    }
+                }
                 error.CalcDersRange(
                     0,
                     innerCount,
@@ -289,6 +323,8 @@ void CalcLeafDersSimple(
             sampleCount,
             recalcLeafWeights,
             estimationMethod,
+            /*pendingLeafDeltas*/ {},
+            /*approxesToUpdate*/ {},
             localExecutor,
             *leafDers,
             *scratchDers);
@@ -776,6 +812,68 @@ static void CalcLeafValuesSimple(
     CopyApprox(bt.Approx, &approxes, ctx->LocalExecutor);
     TVector<TSum> leafDers(leafCount, TSum()); // iteration scratch space
     TArray2D<double> pairwiseBuckets;          // iteration scratch space
+    const auto calcLeafDeltasFromDers = [&](TVector<double>* leafDeltas) {
+        if (treeHasMonotonicConstraints) {
+            const double scaledL2Regularizer = (ctx->Params.ObliviousTreeOptions->L2Reg * (fold.GetSumWeight() / fold.GetLearnSampleCount()));
+            CalcMonotonicLeafDeltasSimple(
+                leafDers,
+                estimationMethod,
+                scaledL2Regularizer,
+                (*sumLeafDeltas)[0],
+                leafMonotonicLinearOrders,
+                leafDeltas);
+        } else {
+            CalcLeafDeltasSimple(
+                leafDers,
+                pairwiseBuckets,
+                ctx->Params,
+                fold.GetSumWeight(),
+                fold.GetLearnSampleCount(),
+                leafDeltas);
+        }
+    };
+
+    bool haveBacktrackingObjective;
+    double minimizationSign;
+    TVector<THolder<IMetric>> lossFunction;
+    CreateBacktrackingObjective(*ctx, &haveBacktrackingObjective, &minimizationSign, &lossFunction);
+
+    // Without backtracking each step is applied unconditionally, so the approx update of a step is fused
+    // with the derivatives calculation of the next one, and the update after the last step is skipped
+    // as only leaf values are needed here.
+    if (error.GetErrorType() == EErrorType::PerObjectError
+        && estimationMethod != ELeavesEstimation::Exact
+        && !haveBacktrackingObjective)
+    {
+        TVector<double> leafDeltas(leafCount);
+        TVector<double> pendingLeafDeltas;
+        for (int iterationIdx = 0; iterationIdx < gradientIterations; ++iterationIdx) {
+            for (auto& leafDer : leafDers) {
+                leafDer.SetZeroDers();
+            }
+            CalcLeafDers(
+                indices,
+                fold.LearnTarget,
+                fold.GetLearnWeights(),
+                approxes[0],
+                /*approxesDelta*/ {},
+                error,
+                fold.GetLearnSampleCount(),
+                /*recalcLeafWeights*/ iterationIdx == 0,
+                estimationMethod,
+                pendingLeafDeltas,
+                approxes[0],
+                &localExecutor,
+                leafDers,
+                weightedDers);
+            calcLeafDeltasFromDers(&leafDeltas);
+            AddElementwise(leafDeltas, &(*sumLeafDeltas)[0]);
+            pendingLeafDeltas = leafDeltas;
+            ExpApproxIf(error.GetIsExpApprox(), pendingLeafDeltas);
+        }
+        return;
+    }
+
     const auto leafUpdaterFunc = [&](
                                      bool recalcLeafWeights,
                                      const TVector<TVector<double>>& approxes,
@@ -824,24 +922,7 @@ static void CalcLeafValuesSimple(
             &pairwiseBuckets,
             &weightedDers);
 
-        if (treeHasMonotonicConstraints) {
-            const double scaledL2Regularizer = (ctx->Params.ObliviousTreeOptions->L2Reg * (fold.GetSumWeight() / fold.GetLearnSampleCount()));
-            CalcMonotonicLeafDeltasSimple(
-                leafDers,
-                estimationMethod,
-                scaledL2Regularizer,
-                (*sumLeafDeltas)[0],
-                leafMonotonicLinearOrders,
-                &(*leafDeltas)[0]);
-        } else {
-            CalcLeafDeltasSimple(
-                leafDers,
-                pairwiseBuckets,
-                ctx->Params,
-                fold.GetSumWeight(),
-                fold.GetLearnSampleCount(),
-                &(*leafDeltas)[0]);
-        }
+        calcLeafDeltasFromDers(&(*leafDeltas)[0]);
     };
 
     const auto approxUpdaterFunc = [&](
@@ -857,11 +938,6 @@ static void CalcLeafValuesSimple(
             &(*approxes)[0]);
     };
 
-    bool haveBacktrackingObjective;
-    double minimizationSign;
-    TVector<THolder<IMetric>> lossFunction;
-    CreateBacktrackingObjective(*ctx, &haveBacktrackingObjective, &minimizationSign, &lossFunction);
-
     const auto lossCalcerFunc = [&](const TVector<TVector<double>>& approx) {
         const auto& additiveStats = EvalErrors(
             approx,
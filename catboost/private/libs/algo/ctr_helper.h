@@ -6,6 +6,8 @@
 #include <catboost/private/libs/algo_helpers/custom_objective_descriptor.h>
 #include <catboost/libs/data/util.h>
 
+#include <library/binsaver/bin_saver.h>
+
 #include <util/generic/array_ref.h>
 #include <util/generic/map.h>
 
@@ -29,6 +31,7 @@ struct TCtrInfo {
     TVector<float> Priors;
 
 public:
+    SAVELOAD(Type, BorderCount, TargetClassifierIdx, Priors);
     Y_SAVELOAD_DEFINE(Type, BorderCount, TargetClassifierIdx, Priors);
 };
 
@@ -67,6 +70,7 @@ public:
         return TargetClassifiers;
     }
 
+    SAVELOAD(TargetClassifiers, SimpleCtrs, PerFeatureCtrs, TreeCtrs);
     Y_SAVELOAD_DEFINE(TargetClassifiers, SimpleCtrs, PerFeatureCtrs, TreeCtrs)
 
 private:
@@ -10,7 +10,9 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
+#include <util/generic/hash_set.h>
 
 
 using namespace NCB;
@@ -302,6 +304,13 @@ void TFold::DropEmptyCTRs() {
     }
 }
 
+void TFold::DropCTRsExcept(TConstArrayRef<TProjection> keptProjections) {
+    const THashSet<TProjection> isKept(keptProjections.begin(), keptProjections.end());
+    const auto isDropped = [&] (const auto& projCtr) { return !isKept.contains(projCtr.first); };
+    EraseNodesIf(OnlineSingleCtrs, isDropped);
+    EraseNodesIf(OnlineCTR, isDropped);
+}
+
 void TFold::AssignTarget(
     TMaybeData<TConstArrayRef<float>> target,
     const TVector<TTargetClassifier>& targetClassifiers
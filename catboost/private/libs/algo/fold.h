@@ -83,6 +83,7 @@ public:
     }
 
     void DropEmptyCTRs();
+    void DropCTRsExcept(TConstArrayRef<TProjection> keptProjections);
 
     const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&> GetAllCtrs() const {
         return std::tie(OnlineSingleCtrs, OnlineCTR);
@@ -22,6 +22,7 @@
 #include <library/fast_log/fast_log.h>
 
 #include <util/generic/cast.h>
+#include <util/generic/is_in.h>
 #include <util/generic/xrange.h>
 #include <util/string/builder.h>
 #include <util/system/mem_info.h>
@@ -30,11 +31,9 @@
 using namespace NCB;
 
 
-constexpr size_t MAX_ONLINE_CTR_FEATURES = 50;
-
-void TrimOnlineCTRcache(const TVector<TFold*>& folds) {
+void TrimOnlineCTRcache(const TVector<TFold*>& folds, size_t maxOnlineCtrFeatures) {
     for (auto& fold : folds) {
-        fold->TrimOnlineCTR(MAX_ONLINE_CTR_FEATURES);
+        fold->TrimOnlineCTR(maxOnlineCtrFeatures);
     }
 }
 
@@ -576,6 +575,30 @@ static void SelectCtrsToDropAfterCalc(
     }
 }
 
+static TStringBuf GetFeatureKindName(const TSplitEnsemble& splitEnsemble) {
+    switch (splitEnsemble.Type) {
+        case ESplitEnsembleType::OneFeature:
+            switch (splitEnsemble.SplitCandidate.Type) {
+                case ESplitType::FloatFeature:
+                    return AsStringBuf("FloatFeature");
+                case ESplitType::EstimatedFeature:
+                    return AsStringBuf("EstimatedFeature");
+                case ESplitType::OneHotFeature:
+                    return AsStringBuf("OneHotFeature");
+                case ESplitType::OnlineCtr:
+                    return AsStringBuf("OnlineCtr");
+            }
+            Y_UNREACHABLE();
+        case ESplitEnsembleType::BinarySplits:
+            return AsStringBuf("BinarySplitsPack");
+        case ESplitEnsembleType::ExclusiveBundle:
+            return AsStringBuf("ExclusiveBundle");
+        case ESplitEnsembleType::FeaturesGroup:
+            return AsStringBuf("FeaturesGroup");
+    }
+    Y_UNREACHABLE();
+}
+
 static void CalcBestScore(
     const TTrainingForCPUDataProviders& data,
     const TSplitTree& currentTree,
@@ -599,6 +622,10 @@ static void CalcBestScore(
 
             const auto& splitEnsemble = candidate.Candidates[0].SplitEnsemble;
 
+            NChromiumTrace::TEventArgs traceArgs;
+            traceArgs.Add("depth", i64(currentTree.GetDepth())).Add("kind", GetFeatureKindName(splitEnsemble));
+            CATBOOST_TRACE_SCOPE_W_ARGS("Calc candidate scores", &traceArgs);
+
             if (splitEnsemble.IsSplitOfType(ESplitType::OnlineCtr)) {
                 const auto& proj = splitEnsemble.SplitCandidate.Ctr.Projection;
                 if (fold->GetCtrRef(proj).Feature.empty()) {
@@ -671,6 +698,7 @@ static void CalcBestScore(
 }
 
 static void DoBootstrap(const TVector<TIndexType>& indices, TFold* fold, TLearnContext* ctx, ui32 leavesCount = 0) {
+    CATBOOST_TRACE_SCOPE("Bootstrap");
     if (!ctx->Params.SystemOptions->IsSingleHost()) {
         MapBootstrap(ctx);
     } else {
@@ -727,6 +755,10 @@ static void CalcBestScoreLeafwise(
 
             const auto& splitEnsemble = candidate.Candidates[0].SplitEnsemble;
 
+            NChromiumTrace::TEventArgs traceArgs;
+            traceArgs.Add("kind", GetFeatureKindName(splitEnsemble));
+            CATBOOST_TRACE_SCOPE_W_ARGS("Calc candidate scores", &traceArgs);
+
             // Calc online ctr if needed
             if (splitEnsemble.IsSplitOfType(ESplitType::OnlineCtr)) {
                 const auto& proj = splitEnsemble.SplitCandidate.Ctr.Projection;
@@ -772,6 +804,17 @@ static void CalcScores(
         * CalcDerivativesStDevFromZero(*fold, ctx->Params.BoostingOptions->BoostingType, ctx->LocalExecutor)
         * CalcDerivativesStDevFromZeroMultiplier(learnSampleCount, modelLength);
     if (!ctx->Params.SystemOptions->IsSingleHost()) {
+        TVector<TProjection> missingCtrProjections;
+        for (const auto& candidate : candidatesContext->CandidateList) {
+            const auto& splitEnsemble = candidate.Candidates[0].SplitEnsemble;
+            if (splitEnsemble.IsSplitOfType(ESplitType::OnlineCtr)) {
+                const auto& proj = splitEnsemble.SplitCandidate.Ctr.Projection;
+                if (fold->GetCtrRef(proj).Feature.empty() && !IsIn(missingCtrProjections, proj)) {
+                    missingCtrProjections.push_back(proj);
+                }
+            }
+        }
+        MapCalcOnlineCtrs(data, missingCtrProjections, fold, ctx);
         if (IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction())) {
             MapRemotePairwiseCalcScore(scoreStDev, candidatesContext, ctx);
         } else {
@@ -843,7 +886,7 @@ void GreedyTensorSearch(
     TSplitTree* resSplitTree) {
 
     TSplitTree currentSplitTree;
-    TrimOnlineCTRcache({fold});
+    TrimOnlineCTRcache({fold}, ctx->MemoryPlan.MaxOnlineCtrFeatures);
 
     ui32 learnSampleCount = data.Learn->ObjectsData->GetObjectCount();
     ui32 testSampleCount = data.GetTestSampleCount();
@@ -853,7 +896,7 @@ void GreedyTensorSearch(
     const bool useLeafwiseScoring = IsLeafwiseScoringApplicable(ctx->Params);
 
     if (!ctx->Params.SystemOptions->IsSingleHost()) {
-        MapTensorSearchStart(ctx);
+        MapTensorSearchStart(*fold, ctx);
     }
 
     const bool isSamplingPerTree = IsSamplingPerTree(ctx->Params.ObliviousTreeOptions);
@@ -865,6 +908,10 @@ void GreedyTensorSearch(
     }
 
     for (ui32 curDepth = 0; curDepth < ctx->Params.ObliviousTreeOptions->MaxDepth; ++curDepth) {
+        NChromiumTrace::TEventArgs depthTraceArgs;
+        depthTraceArgs.Add("depth", i64(curDepth));
+        CATBOOST_TRACE_SCOPE_W_ARGS("Select split for depth", &depthTraceArgs);
+
         TCandidatesContext candidatesContext;
         candidatesContext.OneHotMaxSize = ctx->Params.CatFeatureParams->OneHotMaxSize;
         candidatesContext.BundlesMetaData = data.Learn->ObjectsData->GetExclusiveFeatureBundlesMetaData();
@@ -906,7 +953,10 @@ void GreedyTensorSearch(
         }
         profile.AddOperation(TStringBuilder() << "Bootstrap, depth " << curDepth);
 
-        CalcScores(data, currentSplitTree, modelLength, &candidatesContext, fold, ctx);
+        {
+            CATBOOST_TRACE_SCOPE_W_ARGS("Calc scores", &depthTraceArgs);
+            CalcScores(data, currentSplitTree, modelLength, &candidatesContext, fold, ctx);
+        }
 
         size_t maxFeatureValueCount = 1;
         for (const auto& candidate : candidatesContext.CandidateList) {
@@ -945,7 +995,11 @@ void GreedyTensorSearch(
         if (bestSplit.Type == ESplitType::OnlineCtr) {
             const auto& proj = bestSplit.Ctr.Projection;
             if (fold->GetCtrRef(proj).Feature.empty()) {
-                ComputeOnlineCTRs(data, *fold, proj, ctx, &fold->GetCtrRef(proj));
+                if (ctx->Params.SystemOptions->IsSingleHost()) {
+                    ComputeOnlineCTRs(data, *fold, proj, ctx, &fold->GetCtrRef(proj));
+                } else {
+                    MapCalcOnlineCtrs(data, {proj}, fold, ctx);
+                }
                 if (ctx->UseTreeLevelCaching()) {
                     DropStatsForProjection(*fold, *ctx, proj, &ctx->PrevTreeLevelStats);
                 }
@@ -974,7 +1028,6 @@ void GreedyTensorSearch(
                 }
             }
         } else {
-            Y_ASSERT(bestSplit.Type != ESplitType::OnlineCtr);
             MapSetIndices(bestSplit, ctx);
         }
         currentSplitTree.AddSplit(bestSplit);
@@ -11,7 +11,7 @@ class TProfileInfo;
 struct TSplitTree;
 
 
-void TrimOnlineCTRcache(const TVector<TFold*>& folds);
+void TrimOnlineCTRcache(const TVector<TFold*>& folds, size_t maxOnlineCtrFeatures);
 
 void GreedyTensorSearch(
     const NCB::TTrainingForCPUDataProviders& data,
@@ -164,38 +164,125 @@ static TVector<int> FilterTestPools(const TTrainingForCPUDataProviders& training
     return filtered;
 }
 
+static const TMetricsSubsample& GetOrCreateMetricsSubsample(
+    const TTargetDataProvider& targetData,
+    ui32 objectCount,
+    float sampleRate,
+    ui64 randomSeed,
+    TMaybe<TMetricsSubsample>* subsample
+) {
+    if (!*subsample) {
+        *subsample = CreateMetricsSubsample(
+            objectCount,
+            targetData.GetTarget(),
+            GetWeights(targetData),
+            targetData.GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>()),
+            sampleRate,
+            randomSeed
+        );
+    }
+    return **subsample;
+}
+
+static TVector<TMetricHolder> EvalErrorsOnSubsample(
+    const TVector<TVector<double>>& approx,
+    bool hasTarget,
+    const TMetricsSubsample& subsample,
+    TConstArrayRef<const IMetric*> metrics,
+    NPar::TLocalExecutor* localExecutor
+) {
+    if (metrics.empty()) {
+        return {};
+    }
+    TVector<TVector<double>> subsampleApprox;
+    subsample.GatherApprox(approx, localExecutor, &subsampleApprox);
+    return EvalErrorsWithCaching(
+        subsampleApprox,
+        /*approxDelta*/{},
+        /*isExpApprox*/false,
+        subsample.GetTarget(hasTarget),
+        subsample.Weights,
+        subsample.QueryInfo,
+        metrics,
+        localExecutor
+    );
+}
+
 void CalcErrors(
     const TTrainingForCPUDataProviders& trainingDataProviders,
     const TVector<THolder<IMetric>>& errors,
     bool calcAllMetrics,
     bool calcErrorTrackerMetric,
+    bool useMetricsSubsample,
     TLearnContext* ctx
 ) {
+    const float metricSampleRate = ctx->OutputOptions.GetMetricSampleRate();
+    const ui64 randomSeed = ctx->Params.RandomSeed.Get();
+    auto& metricsAndTimeHistory = ctx->LearnProgress->MetricsAndTimeHistory;
+    // only iterations with all metrics calculated have metrics to subsample
+    useMetricsSubsample = useMetricsSubsample && calcAllMetrics;
+
+    if (trainingDataProviders.Learn->GetObjectCount() > 0) {
+        metricsAndTimeHistory.LearnMetricsHistory.emplace_back();
+    }
+    if (trainingDataProviders.GetTestSampleCount() > 0) {
+        metricsAndTimeHistory.TestMetricsHistory.emplace_back();
+    }
+    const size_t historySize = Max(
+        metricsAndTimeHistory.LearnMetricsHistory.size(),
+        metricsAndTimeHistory.TestMetricsHistory.size()
+    );
+    if (useMetricsSubsample && historySize > 0) {
+        metricsAndTimeHistory.IsMetricsSubsampled.resize(historySize);
+        metricsAndTimeHistory.IsMetricsSubsampled.back() = true;
+    }
+
     if (trainingDataProviders.Learn->GetObjectCount() > 0) {
-        ctx->LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory.emplace_back();
         if (calcAllMetrics) {
             if (ctx->Params.SystemOptions->IsSingleHost()) {
                 auto trainMetrics = FilterTrainMetrics(errors);
 
                 const auto& targetData = trainingDataProviders.Learn->TargetData;
 
-                auto weights = GetWeights(*targetData);
-                auto queryInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
-
-                auto errors = EvalErrorsWithCaching(
-                    ctx->LearnProgress->AvrgApprox,
-                    /*approxDelta*/{},
-                    /*isExpApprox*/false,
-                    targetData->GetTarget(),
-                    weights,
-                    queryInfo,
-                    trainMetrics,
-                    ctx->LocalExecutor
-                );
+                TVector<TMetricHolder> errors;
+                if (useMetricsSubsample) {
+                    const auto& subsample = GetOrCreateMetricsSubsample(
+                        *targetData,
+                        trainingDataProviders.Learn->GetObjectCount(),
+                        metricSampleRate,
+                        randomSeed,
+                        &ctx->LearnMetricsSubsample
+                    );
+                    errors = EvalErrorsOnSubsample(
+                        ctx->LearnProgress->AvrgApprox,
+                        targetData->GetTarget().Defined(),
+                        subsample,
+                        trainMetrics,
+                        ctx->LocalExecutor
+                    );
+                } else {
+                    auto weights = GetWeights(*targetData);
+                    auto queryInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
+
+                    errors = EvalErrorsWithCaching(
+                        ctx->LearnProgress->AvrgApprox,
+                        /*approxDelta*/{},
+                        /*isExpApprox*/false,
+                        targetData->GetTarget(),
+                        weights,
+                        queryInfo,
+                        trainMetrics,
+                        ctx->LocalExecutor
+                    );
+                }
 
                 for (auto i : xrange(trainMetrics.size())) {
                     auto metric = trainMetrics[i];
-                    ctx->LearnProgress->MetricsAndTimeHistory.AddLearnError(*metric, metric->GetFinalError(errors[i]));
+                    metricsAndTimeHistory.AddLearnError(
+                        *metric,
+                        metric->GetFinalError(errors[i]),
+                        useMetricsSubsample
+                    );
                 }
             } else {
                 MapCalcErrors(ctx);
@@ -204,7 +291,9 @@ void CalcErrors(
     }
 
     if (trainingDataProviders.GetTestSampleCount() > 0) {
-        ctx->LearnProgress->MetricsAndTimeHistory.TestMetricsHistory.emplace_back();
+        if (useMetricsSubsample) {
+            ctx->TestMetricsSubsamples.resize(trainingDataProviders.Test.size());
+        }
         for (auto testIdx : FilterTestPools(trainingDataProviders, calcAllMetrics)) {
             const auto &targetData = trainingDataProviders.Test[testIdx]->TargetData;
 
@@ -216,29 +305,96 @@ void CalcErrors(
             TMaybe<int> filteredTrackerIdx;
             auto testMetrics = FilterTestMetrics(errors, calcAllMetrics, maybeTarget.Defined(), trackerIdx, &filteredTrackerIdx);
 
-            auto errors = EvalErrorsWithCaching(
-                ctx->LearnProgress->TestApprox[testIdx],
-                /*approxDelta*/{},
-                /*isExpApprox*/false,
-                maybeTarget,
-                weights,
-                queryInfo,
-                testMetrics,
-                ctx->LocalExecutor
-            );
+            // error tracker metric is always calculated on the full dataset, it drives use_best_model and early stopping
+            TVector<const IMetric*> fullSetMetrics;
+            TVector<const IMetric*> subsampleMetrics;
+            for (int i : xrange(testMetrics.size())) {
+                const bool isTracker = filteredTrackerIdx && (i == *filteredTrackerIdx);
+                (useMetricsSubsample && !isTracker ? subsampleMetrics : fullSetMetrics).push_back(testMetrics[i]);
+            }
+
+            const auto& testApprox = ctx->LearnProgress->TestApprox[testIdx];
+            TVector<TMetricHolder> fullSetErrors;
+            if (!fullSetMetrics.empty()) {
+                fullSetErrors = EvalErrorsWithCaching(
+                    testApprox,
+                    /*approxDelta*/{},
+                    /*isExpApprox*/false,
+                    maybeTarget,
+                    weights,
+                    queryInfo,
+                    fullSetMetrics,
+                    ctx->LocalExecutor
+                );
+            }
+            TVector<TMetricHolder> subsampleErrors;
+            if (!subsampleMetrics.empty()) {
+                const auto& subsample = GetOrCreateMetricsSubsample(
+                    *targetData,
+                    trainingDataProviders.Test[testIdx]->GetObjectCount(),
+                    metricSampleRate,
+                    randomSeed + testIdx + 1,
+                    &ctx->TestMetricsSubsamples[testIdx]
+                );
+                subsampleErrors = EvalErrorsOnSubsample(
+                    testApprox,
+                    maybeTarget.Defined(),
+                    subsample,
+                    subsampleMetrics,
+                    ctx->LocalExecutor
+                );
+            }
 
+            size_t fullSetMetricIdx = 0;
+            size_t subsampleMetricIdx = 0;
             for (int i : xrange(testMetrics.size())) {
                 auto metric = testMetrics[i];
-                const bool updateBestIteration = filteredTrackerIdx && (i == *filteredTrackerIdx)
+                const bool isTracker = filteredTrackerIdx && (i == *filteredTrackerIdx);
+                const TMetricHolder& error = (useMetricsSubsample && !isTracker)
+                    ? subsampleErrors[subsampleMetricIdx++]
+                    : fullSetErrors[fullSetMetricIdx++];
+                const bool updateBestIteration = isTracker
                     && (testIdx == SafeIntegerCast<int>(trainingDataProviders.Test.size() - 1));
 
-                ctx->LearnProgress->MetricsAndTimeHistory.AddTestError(
+                metricsAndTimeHistory.AddTestError(
                     testIdx,
                     *metric,
-                    metric->GetFinalError(errors[i]),
-                    updateBestIteration
+                    metric->GetFinalError(error),
+                    updateBestIteration,
+                    useMetricsSubsample && !isTracker
                 );
             }
         }
     }
 }
+
+void RecalcSubsampledErrors(
+    const TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
+    TLearnContext* ctx
+) {
+    auto& metricsAndTimeHistory = ctx->LearnProgress->MetricsAndTimeHistory;
+    const size_t historySize = Max(
+        metricsAndTimeHistory.LearnMetricsHistory.size(),
+        metricsAndTimeHistory.TestMetricsHistory.size()
+    );
+    if (historySize == 0 || !metricsAndTimeHistory.IsMetricsSubsampledAt(historySize - 1)) {
+        return;
+    }
+    // subsampled values haven't updated best errors, so the last iteration can be evaluated anew
+    metricsAndTimeHistory.IsMetricsSubsampled.resize(historySize - 1);
+    if (trainingDataProviders.Learn->GetObjectCount() > 0) {
+        metricsAndTimeHistory.LearnMetricsHistory.pop_back();
+    }
+    if (trainingDataProviders.GetTestSampleCount() > 0) {
+        metricsAndTimeHistory.TestMetricsHistory.pop_back();
+    }
+    CalcErrors(
+        trainingDataProviders,
+        errors,
+        /*calcAllMetrics*/ true,
+        /*calcErrorTrackerMetric*/ true,
+        /*useMetricsSubsample*/ false,
+        ctx
+    );
+}
@@ -39,5 +39,13 @@ void CalcErrors(
     const TVector<THolder<IMetric>>& errors,
     bool calcAllMetrics, // bool value for each error
     bool calcErrorTrackerMetric,
+    bool useMetricsSubsample, // calc non-tracker metrics on a fixed subsample (see metric_sample_rate)
+    TLearnContext* ctx
+);
+
+// Recalculate metrics of the last iteration on the full datasets if they were calculated on a subsample.
+void RecalcSubsampledErrors(
+    const NCB::TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
     TLearnContext* ctx
 );
@@ -359,7 +359,12 @@ TLearnContext::TLearnContext(
     }
 
     const ui32 maxBodyTailCount = Max(1, GetMaxBodyTailCount(LearnProgress->Folds));
-    UseTreeLevelCachingFlag = NeedToUseTreeLevelCaching(Params, maxBodyTailCount, LearnProgress->ApproxDimension);
+    MemoryPlan = PlanTrainingMemory(
+        EstimateTrainingMemory(Params, data, CtrsHelper, LearnProgress->Folds, LearnProgress->AveragingFold),
+        NeedToUseTreeLevelCaching(Params, maxBodyTailCount, LearnProgress->ApproxDimension),
+        ParseMemorySizeDescription(Params.SystemOptions->CpuUsedRamLimit.Get())
+    );
+    UseTreeLevelCachingFlag = MemoryPlan.UseTreeLevelCaching;
 }
 
 
@@ -436,6 +441,21 @@ bool TLearnContext::TryLoadProgress(std::function<void(IInputStream*)> onSnapsho
     }
 }
 
+// let the model evaluator store binary features that were exclusive on learn in one byte
+static void SetExclusiveBundleIds(
+    const TQuantizedForCPUObjectsDataProvider& learnObjectsData,
+    TVector<TFloatFeature>* floatFeatures
+) {
+    for (auto& floatFeature : *floatFeatures) {
+        const auto bundleIndex = learnObjectsData.GetFloatFeatureToExclusiveBundleIndex(
+            TFloatFeatureIdx((ui32)floatFeature.Position.Index)
+        );
+        if (bundleIndex) {
+            floatFeature.ExclusiveBundleId = SafeIntegerCast<int>(bundleIndex->BundleIdx);
+        }
+    }
+}
+
 TLearnProgress::TLearnProgress() : Rand(0) {
 }
 
@@ -469,6 +489,8 @@ TLearnProgress::TLearnProgress(
     , LearnAndTestQuantizedFeaturesCheckSum(featuresCheckSum)
     , Rand(randomSeed) {
 
+    SetExclusiveBundleIds(*data.Learn->ObjectsData, &FloatFeatures);
+
     if (ApproxDimension > 1) {
         LabelConverter = labelConverter;
     }
@@ -3,6 +3,8 @@
 #include "calc_score_cache.h"
 #include "ctr_helper.h"
 #include "fold.h"
+#include "memory_planner.h"
+#include "metrics_subsample.h"
 #include "online_ctr.h"
 #include "split.h"
 
@@ -207,6 +209,11 @@ public:
     TCalcScoreFold SampledDocs;
     TBucketStatsCache PrevTreeLevelStats;
     TProfileInfo Profile;
+    TTrainingMemoryPlan MemoryPlan;
+
+    // created on first use if metric_sample_rate < 1
+    TMaybe<TMetricsSubsample> LearnMetricsSubsample;
+    TVector<TMaybe<TMetricsSubsample>> TestMetricsSubsamples; // [testIdx]
 
     bool LearnAndTestDataPackingAreCompatible;
 
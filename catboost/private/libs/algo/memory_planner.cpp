@@ -0,0 +1,174 @@
+#include "memory_planner.h"
+
+#include "calc_score_cache.h"
+#include "projection.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/stream/format.h>
+
+
+using namespace NCB;
+
+
+static ui64 GetFoldApproxesSize(const TFold& fold) {
+    ui64 size = 0;
+    for (const auto& bodyTail : fold.BodyTailArr) {
+        for (const auto* dimensionVectors : {&bodyTail.Approx, &bodyTail.WeightedDerivatives, &bodyTail.SampleWeightedDerivatives}) {
+            for (const auto& dimensionVector : *dimensionVectors) {
+                size += sizeof(double) * dimensionVector.size();
+            }
+        }
+        size += sizeof(float) * (bodyTail.PairwiseWeights.size() + bodyTail.SamplePairwiseWeights.size());
+    }
+    return size;
+}
+
+// values count per object of online CTRs for one projection
+static ui64 GetOnlineCtrValueCount(const TVector<TCtrInfo>& ctrInfos, const TCtrHelper& ctrHelper) {
+    const auto& targetClassifiers = ctrHelper.GetTargetClassifiers();
+    ui64 valueCount = 0;
+    for (const auto& ctrInfo : ctrInfos) {
+        const ui32 targetClassesCount = (ctrInfo.TargetClassifierIdx < targetClassifiers.size()) ?
+            targetClassifiers[ctrInfo.TargetClassifierIdx].Borders.size() + 1
+            : 1;
+        valueCount += GetTargetBorderCount(ctrInfo, targetClassesCount) * ctrInfo.Priors.size();
+    }
+    return valueCount;
+}
+
+// bucket count of binarized online CTRs for one projection
+static ui64 GetOnlineCtrBucketCount(const TVector<TCtrInfo>& ctrInfos, const TCtrHelper& ctrHelper) {
+    ui64 bucketCount = 0;
+    for (const auto& ctrInfo : ctrInfos) {
+        bucketCount += GetOnlineCtrValueCount({ctrInfo}, ctrHelper) * (ctrInfo.BorderCount + 1);
+    }
+    return bucketCount;
+}
+
+TTrainingMemoryEstimate EstimateTrainingMemory(
+    const NCatboostOptions::TCatBoostOptions& params,
+    const TTrainingForCPUDataProviders& data,
+    const TCtrHelper& ctrHelper,
+    const TVector<TFold>& folds,
+    const TFold& averagingFold) {
+
+    TTrainingMemoryEstimate estimate;
+
+    const ui64 objectCount = data.Learn->GetObjectCount() + data.GetTestSampleCount();
+    const auto& quantizedFeaturesInfo = *data.Learn->ObjectsData->GetQuantizedFeaturesInfo();
+    const auto& featuresLayout = *data.Learn->ObjectsData->GetFeaturesLayout();
+    const ui32 oneHotMaxSize = params.CatFeatureParams->OneHotMaxSize;
+
+    ui64 quantizedBytesPerObject = 0;
+    ui64 bucketCount = 0;
+    featuresLayout.IterateOverAvailableFeatures<EFeatureType::Float>(
+        [&] (TFloatFeatureIdx floatFeatureIdx) {
+            const ui32 binCount = quantizedFeaturesInfo.GetBinCount(floatFeatureIdx);
+            quantizedBytesPerObject += (binCount <= 256) ? sizeof(ui8) : sizeof(ui16);
+            bucketCount += binCount;
+        }
+    );
+
+    ui64 singleCtrValueCount = 0;
+    featuresLayout.IterateOverAvailableFeatures<EFeatureType::Categorical>(
+        [&] (TCatFeatureIdx catFeatureIdx) {
+            quantizedBytesPerObject += sizeof(ui32);
+            const ui32 onLearnOnlyCount = quantizedFeaturesInfo.GetUniqueValuesCounts(catFeatureIdx).OnLearnOnly;
+            if (onLearnOnlyCount <= 1) {
+                return;
+            }
+            if (onLearnOnlyCount <= oneHotMaxSize) {
+                bucketCount += onLearnOnlyCount;
+                return;
+            }
+            TProjection projection;
+            projection.AddCatFeature(*catFeatureIdx);
+            const auto& ctrInfos = ctrHelper.GetCtrInfo(projection);
+            singleCtrValueCount += GetOnlineCtrValueCount(ctrInfos, ctrHelper);
+            bucketCount += GetOnlineCtrBucketCount(ctrInfos, ctrHelper);
+        }
+    );
+    estimate.QuantizedFeatures = quantizedBytesPerObject * objectCount;
+
+    const ui64 foldCount = folds.size() + 1;
+    estimate.FoldApproxes = GetFoldApproxesSize(averagingFold);
+    for (const auto& fold : folds) {
+        estimate.FoldApproxes += GetFoldApproxesSize(fold);
+    }
+
+    estimate.OnlineSingleCtrs = sizeof(ui8) * singleCtrValueCount * objectCount * foldCount;
+    if (singleCtrValueCount > 0) {
+        // tree CTRs are possible only if there are categorical features with CTRs
+        TProjection treeProjection;
+        const ui64 treeCtrValueCount = GetOnlineCtrValueCount(ctrHelper.GetCtrInfo(treeProjection), ctrHelper);
+        estimate.OnlineTreeCtrsPerProjection = sizeof(ui8) * treeCtrValueCount * objectCount * foldCount;
+        estimate.OnlineTreeCtrs = estimate.OnlineTreeCtrsPerProjection * DEFAULT_MAX_ONLINE_CTR_FEATURES;
+    }
+
+    if (!folds.empty()) {
+        const ui64 maxLeafCount = 1ULL << params.ObliviousTreeOptions->MaxDepth;
+        estimate.BucketStatsCache = sizeof(TBucketStats) * bucketCount * maxLeafCount
+            * folds[0].GetApproxDimension() * Max(1, GetMaxBodyTailCount(folds));
+    }
+
+    return estimate;
+}
+
+static void OutputTrainingMemoryPlan(const TTrainingMemoryPlan& plan, ui64 cpuRamLimit) {
+    const auto& estimate = plan.Estimate;
+    CATBOOST_DEBUG_LOG << "Estimated CPU RAM usage for training: "
+        << HumanReadableSize(estimate.GetTotal(), SF_BYTES)
+        << " (limit " << HumanReadableSize(cpuRamLimit, SF_BYTES) << ")\n"
+        << "  quantized features: " << HumanReadableSize(estimate.QuantizedFeatures, SF_BYTES) << '\n'
+        << "  fold approxes: " << HumanReadableSize(estimate.FoldApproxes, SF_BYTES) << '\n'
+        << "  online single CTRs: " << HumanReadableSize(estimate.OnlineSingleCtrs, SF_BYTES) << '\n'
+        << "  online tree CTRs (" << plan.MaxOnlineCtrFeatures << " projections per fold): "
+        << HumanReadableSize(estimate.OnlineTreeCtrs, SF_BYTES) << '\n'
+        << "  tree level bucket stats cache: " << HumanReadableSize(estimate.BucketStatsCache, SF_BYTES) << '\n';
+}
+
+TTrainingMemoryPlan PlanTrainingMemory(
+    const TTrainingMemoryEstimate& estimate,
+    bool needTreeLevelCaching,
+    ui64 cpuRamLimit) {
+
+    TTrainingMemoryPlan plan;
+    plan.Estimate = estimate;
+    plan.UseTreeLevelCaching = needTreeLevelCaching;
+    if (!needTreeLevelCaching) {
+        plan.Estimate.BucketStatsCache = 0;
+    }
+
+    if ((plan.Estimate.GetTotal() > cpuRamLimit) && plan.UseTreeLevelCaching) {
+        CATBOOST_WARNING_LOG << "Tree level statistics caching is disabled to fit into used_ram_limit\n";
+        plan.UseTreeLevelCaching = false;
+        plan.Estimate.BucketStatsCache = 0;
+    }
+
+    if ((plan.Estimate.GetTotal() > cpuRamLimit) && (plan.Estimate.OnlineTreeCtrsPerProjection > 0)) {
+        const ui64 otherUsage = plan.Estimate.GetTotal() - plan.Estimate.OnlineTreeCtrs;
+        const ui64 availableForTreeCtrs = (cpuRamLimit > otherUsage) ? cpuRamLimit - otherUsage : 0;
+        const size_t maxOnlineCtrFeatures = Max<size_t>(
+            1,
+            availableForTreeCtrs / plan.Estimate.OnlineTreeCtrsPerProjection);
+        if (maxOnlineCtrFeatures < plan.MaxOnlineCtrFeatures) {
+            CATBOOST_WARNING_LOG << "Online CTRs cache is limited to " << maxOnlineCtrFeatures
+                << " projections per fold to fit into used_ram_limit\n";
+            plan.MaxOnlineCtrFeatures = maxOnlineCtrFeatures;
+            plan.Estimate.OnlineTreeCtrs = plan.Estimate.OnlineTreeCtrsPerProjection * maxOnlineCtrFeatures;
+        }
+    }
+
+    OutputTrainingMemoryPlan(plan, cpuRamLimit);
+    CB_ENSURE(
+        plan.Estimate.GetTotal() <= cpuRamLimit,
+        "Estimated CPU RAM usage for training (" << HumanReadableSize(plan.Estimate.GetTotal(), SF_BYTES)
+        << ") exceeds used_ram_limit (" << HumanReadableSize(cpuRamLimit, SF_BYTES)
+        << ") even with tree level caching disabled and online CTRs cache limited to "
+        << plan.MaxOnlineCtrFeatures << " projections per fold"
+    );
+
+    return plan;
+}
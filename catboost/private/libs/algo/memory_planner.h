@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ctr_helper.h"
+#include "fold.h"
+
+#include <catboost/libs/data/data_provider.h>
+#include <catboost/private/libs/options/catboost_options.h>
+
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+constexpr size_t DEFAULT_MAX_ONLINE_CTR_FEATURES = 50;
+
+
+/* Up-front estimates (in bytes) of the largest CPU RAM consumers during CPU training.
+ * Online CTR values are accounted for all folds including the averaging fold.
+ */
+struct TTrainingMemoryEstimate {
+    ui64 QuantizedFeatures = 0;
+    ui64 FoldApproxes = 0;
+    ui64 OnlineSingleCtrs = 0;
+    ui64 OnlineTreeCtrs = 0; // cache of tree CTRs limited by MaxOnlineCtrFeatures projections per fold
+    ui64 OnlineTreeCtrsPerProjection = 0;
+    ui64 BucketStatsCache = 0; // used only if tree level caching is enabled
+
+public:
+    ui64 GetTotal() const {
+        return QuantizedFeatures + FoldApproxes + OnlineSingleCtrs + OnlineTreeCtrs + BucketStatsCache;
+    }
+};
+
+
+struct TTrainingMemoryPlan {
+    TTrainingMemoryEstimate Estimate;
+    bool UseTreeLevelCaching = false;
+    size_t MaxOnlineCtrFeatures = DEFAULT_MAX_ONLINE_CTR_FEATURES;
+};
+
+
+// folds must be already created, averagingFold is accounted as well
+TTrainingMemoryEstimate EstimateTrainingMemory(
+    const NCatboostOptions::TCatBoostOptions& params,
+    const NCB::TTrainingForCPUDataProviders& data,
+    const TCtrHelper& ctrHelper,
+    const TVector<TFold>& folds,
+    const TFold& averagingFold);
+
+/* Fits the estimated usage into cpuRamLimit by degrading optional caches:
+ * tree level bucket stats cache is dropped first, then online tree CTRs cache is shrunk.
+ * Throws if the estimate is still over the limit.
+ */
+TTrainingMemoryPlan PlanTrainingMemory(
+    const TTrainingMemoryEstimate& estimate,
+    bool needTreeLevelCaching,
+    ui64 cpuRamLimit);
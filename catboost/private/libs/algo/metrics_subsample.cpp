@@ -0,0 +1,115 @@
+#include "metrics_subsample.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <cmath>
+
+
+// positions i in [0, count) such that [offset + i * sampleRate, offset + (i + 1) * sampleRate) contains an integer
+static TVector<ui32> SelectSystematically(ui32 count, float sampleRate, TFastRng64* rand) {
+    const double offset = rand->GenRandReal1();
+    TVector<ui32> selected;
+    selected.reserve(static_cast<size_t>(std::ceil(count * (double)sampleRate)) + 1);
+    for (auto i : xrange(count)) {
+        if (std::floor(offset + (i + 1) * (double)sampleRate) > std::floor(offset + i * (double)sampleRate)) {
+            selected.push_back(i);
+        }
+    }
+    if (selected.empty() && count > 0) {
+        selected.push_back(rand->Uniform(count));
+    }
+    return selected;
+}
+
+
+void TMetricsSubsample::GatherApprox(
+    const TVector<TVector<double>>& approx,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TVector<double>>* subsampleApprox
+) const {
+    subsampleApprox->resize(approx.size());
+    const auto indicesRef = MakeArrayRef(ObjectIndices);
+    for (auto dim : xrange(approx.size())) {
+        (*subsampleApprox)[dim].yresize(ObjectIndices.size());
+        const auto srcRef = MakeArrayRef(approx[dim]);
+        auto dstRef = MakeArrayRef((*subsampleApprox)[dim]);
+        NPar::ParallelFor(
+            *localExecutor,
+            /*from*/0,
+            /*to*/SafeIntegerCast<int>(ObjectIndices.size()),
+            /*body*/[=] (int i) {
+                dstRef[i] = srcRef[indicesRef[i]];
+            }
+        );
+    }
+}
+
+
+TMetricsSubsample CreateMetricsSubsample(
+    ui32 objectCount,
+    NCB::TMaybeData<TConstArrayRef<float>> target,
+    TConstArrayRef<float> weights,
+    TConstArrayRef<TQueryInfo> queryInfo,
+    float sampleRate,
+    ui64 randomSeed
+) {
+    CB_ENSURE_INTERNAL(sampleRate > 0.0f && sampleRate <= 1.0f, "Unexpected metric sample rate " << sampleRate);
+    CB_ENSURE_INTERNAL(!target || target->size() == objectCount, "Target size does not match object count");
+
+    TFastRng64 rand(randomSeed);
+    TMetricsSubsample subsample;
+
+    if (!queryInfo.empty()) {
+        const auto selectedGroups = SelectSystematically(SafeIntegerCast<ui32>(queryInfo.size()), sampleRate, &rand);
+        for (auto groupIdx : selectedGroups) {
+            TQueryInfo group = queryInfo[groupIdx];
+            const ui32 begin = subsample.ObjectIndices.size();
+            for (auto objectIdx : xrange(group.Begin, group.End)) {
+                subsample.ObjectIndices.push_back(objectIdx);
+            }
+            group.End = begin + group.GetSize();
+            group.Begin = begin;
+            subsample.QueryInfo.push_back(std::move(group));
+        }
+    } else {
+        TVector<ui32> order(objectCount);
+        Iota(order.begin(), order.end(), 0);
+        if (target) {
+            const auto targetRef = *target;
+            StableSortBy(order, [=] (ui32 objectIdx) { return targetRef[objectIdx]; });
+        }
+        for (auto position : SelectSystematically(objectCount, sampleRate, &rand)) {
+            subsample.ObjectIndices.push_back(order[position]);
+        }
+        Sort(subsample.ObjectIndices);
+    }
+
+    if (target) {
+        subsample.Target.yresize(subsample.ObjectIndices.size());
+        for (auto i : xrange(subsample.ObjectIndices.size())) {
+            subsample.Target[i] = (*target)[subsample.ObjectIndices[i]];
+        }
+    }
+    if (!weights.empty()) {
+        subsample.Weights.yresize(subsample.ObjectIndices.size());
+        for (auto i : xrange(subsample.ObjectIndices.size())) {
+            subsample.Weights[i] = weights[subsample.ObjectIndices[i]];
+        }
+    }
+    return subsample;
+}
+
+bool ShouldUseMetricsSubsample(ui32 iterWithOffset, ui32 iterationCount, float metricSampleRate, ui32 fullMetricPeriod) {
+    if (metricSampleRate == 1.0f) {
+        return false;
+    }
+    if ((iterWithOffset + 1) == iterationCount) {
+        return false;
+    }
+    return (fullMetricPeriod == 0) || (iterWithOffset % fullMetricPeriod);
+}
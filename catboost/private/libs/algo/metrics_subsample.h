@@ -0,0 +1,51 @@
+#pragma once
+
+#include <catboost/libs/helpers/maybe_data.h>
+#include <catboost/private/libs/data_types/query.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+/* Fixed subset of a dataset that non-tracker metrics are calculated on between full metric evaluations
+ * (see metric_sample_rate). It is selected once per dataset so that metric values are comparable across iterations.
+ */
+struct TMetricsSubsample {
+    TVector<ui32> ObjectIndices; // sorted, indices in the original dataset
+    TVector<float> Target; // empty if dataset has no target
+    TVector<float> Weights; // empty if weights are trivial
+    TVector<TQueryInfo> QueryInfo; // bounds are relative to the subsample
+
+public:
+    NCB::TMaybeData<TConstArrayRef<float>> GetTarget(bool hasTarget) const {
+        return hasTarget ? NCB::TMaybeData<TConstArrayRef<float>>(Target) : Nothing();
+    }
+
+    // approx is [dimension][objectIdx] for the full dataset
+    void GatherApprox(
+        const TVector<TVector<double>>& approx,
+        NPar::TLocalExecutor* localExecutor,
+        TVector<TVector<double>>* subsampleApprox
+    ) const;
+};
+
+/* Groups are sampled as a whole if queryInfo is not empty, otherwise objects are stratified by target value
+ * (systematic sampling with a random offset over objects ordered by target).
+ */
+TMetricsSubsample CreateMetricsSubsample(
+    ui32 objectCount,
+    NCB::TMaybeData<TConstArrayRef<float>> target,
+    TConstArrayRef<float> weights,
+    TConstArrayRef<TQueryInfo> queryInfo,
+    float sampleRate,
+    ui64 randomSeed
+);
+
+/* Whether non-tracker metrics are calculated on a subsample at iteration iterWithOffset.
+ * Full evaluations are done every fullMetricPeriod iterations (never if it is 0) and at the last iteration.
+ * The iteration where the overfitting detector stops training is recalculated separately (see RecalcSubsampledErrors).
+ */
+bool ShouldUseMetricsSubsample(ui32 iterWithOffset, ui32 iterationCount, float metricSampleRate, ui32 fullMetricPeriod);
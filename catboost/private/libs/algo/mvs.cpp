@@ -78,6 +78,21 @@ double TMvsSampler::GetLambda(
     return mean * mean;
 }
 
+// Median of evenly spaced candidates, so that every partition step drops a constant share of candidates
+// on average even if candidates are (partially) sorted.
+static double SelectThresholdPivot(TVector<double>::iterator candidatesBegin, TVector<double>::iterator candidatesEnd) {
+    constexpr size_t MaxSampleSize = 15;
+    const size_t candidatesCount = candidatesEnd - candidatesBegin;
+    const size_t sampleSize = Min(MaxSampleSize, candidatesCount);
+    const size_t step = candidatesCount / sampleSize;
+    double sample[MaxSampleSize];
+    for (size_t i = 0; i < sampleSize; ++i) {
+        sample[i] = candidatesBegin[i * step];
+    }
+    NthElement(sample, sample + sampleSize / 2, sample + sampleSize);
+    return sample[sampleSize / 2];
+}
+
 double TMvsSampler::CalculateThreshold(
     TVector<double>::iterator candidatesBegin,
     TVector<double>::iterator candidatesEnd,
@@ -85,34 +100,36 @@ double TMvsSampler::CalculateThreshold(
     ui32 numberOfLargeCurrent,
     double sampleSize) const {
 
-    double threshold = *candidatesBegin;
-    auto middleBegin = std::partition(candidatesBegin, candidatesEnd, [threshold](double candidate) {
-        return candidate < threshold;
-    });
-    auto middleEnd = std::partition(middleBegin, candidatesEnd, [threshold](double candidate) {
-        return candidate <= threshold;
-    });
-
-    double sumOfSmallUpdate = Accumulate(candidatesBegin, middleBegin, 0.0);
-    ui32 numberOfLargeUpdate = candidatesEnd - middleEnd;
-    ui32 numberOfMiddle = middleEnd - middleBegin;
-    double sumOfMiddle = numberOfMiddle * threshold;
-
-    double estimatedSampleSize =
-        (sumOfSmallCurrent + sumOfSmallUpdate) / threshold + numberOfLargeCurrent + numberOfLargeUpdate + numberOfMiddle;
-    if (estimatedSampleSize > sampleSize) {
-        if (middleEnd != candidatesEnd) {
-            sumOfSmallCurrent += sumOfMiddle + sumOfSmallUpdate;
-            return CalculateThreshold(middleEnd, candidatesEnd, sumOfSmallCurrent, numberOfLargeCurrent, sampleSize);
-        } else {
-            return (sumOfSmallCurrent + sumOfSmallUpdate + sumOfMiddle) / (sampleSize - numberOfLargeCurrent);
-        }
-    } else {
-        if (middleBegin != candidatesBegin) {
-            numberOfLargeCurrent += numberOfLargeUpdate + numberOfMiddle;
-            return CalculateThreshold(candidatesBegin, middleBegin, sumOfSmallCurrent, numberOfLargeCurrent, sampleSize);
+    while (true) {
+        const double threshold = SelectThresholdPivot(candidatesBegin, candidatesEnd);
+        auto middleBegin = std::partition(candidatesBegin, candidatesEnd, [threshold](double candidate) {
+            return candidate < threshold;
+        });
+        auto middleEnd = std::partition(middleBegin, candidatesEnd, [threshold](double candidate) {
+            return candidate <= threshold;
+        });
+
+        double sumOfSmallUpdate = Accumulate(candidatesBegin, middleBegin, 0.0);
+        ui32 numberOfLargeUpdate = candidatesEnd - middleEnd;
+        ui32 numberOfMiddle = middleEnd - middleBegin;
+        double sumOfMiddle = numberOfMiddle * threshold;
+
+        double estimatedSampleSize =
+            (sumOfSmallCurrent + sumOfSmallUpdate) / threshold + numberOfLargeCurrent + numberOfLargeUpdate + numberOfMiddle;
+        if (estimatedSampleSize > sampleSize) {
+            if (middleEnd != candidatesEnd) {
+                sumOfSmallCurrent += sumOfMiddle + sumOfSmallUpdate;
+                candidatesBegin = middleEnd;
+            } else {
+                return (sumOfSmallCurrent + sumOfSmallUpdate + sumOfMiddle) / (sampleSize - numberOfLargeCurrent);
+            }
         } else {
-            return sumOfSmallCurrent / (sampleSize - numberOfLargeCurrent - numberOfMiddle - numberOfLargeUpdate);
+            if (middleBegin != candidatesBegin) {
+                numberOfLargeCurrent += numberOfLargeUpdate + numberOfMiddle;
+                candidatesEnd = middleBegin;
+            } else {
+                return sumOfSmallCurrent / (sampleSize - numberOfLargeCurrent - numberOfMiddle - numberOfLargeUpdate);
+            }
         }
     }
 }
@@ -1,5 +1,6 @@
 #include "online_ctr.h"
 
+#include "ctr_helper.h"
 #include "fold.h"
 #include "index_hash_calcer.h"
 #include "learn_context.h"
@@ -10,13 +11,18 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/mem_usage.h>
 #include <catboost/libs/helpers/resource_constrained_executor.h>
+#include <catboost/libs/logging/profile_info.h>
 #include <catboost/libs/model/ctr_value_table.h>
 #include <catboost/libs/model/model.h>
+#include <catboost/private/libs/options/cat_feature_options.h>
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/bitops.h>
+#include <util/generic/hash.h>
 #include <util/generic/utility.h>
+#include <util/generic/xrange.h>
 #include <util/system/mem_info.h>
 #include <util/thread/singleton.h>
 
@@ -547,6 +553,90 @@ static void CopyCatColumnToHash(
 }
 
 
+// Hashes of projection values of objects taken in order of featuresSubsetIndexing,
+// hashArr is expected to be filled with zeros
+static void CalcProjectionHashes(
+    const TProjection& proj,
+    const TQuantizedForCPUObjectsDataProvider& objectsData,
+    const TFeaturesArraySubsetIndexing& featuresSubsetIndexing,
+    bool processBundledAndBinaryFeaturesInPacks,
+    NPar::TLocalExecutor* localExecutor,
+    TArrayRef<ui64> hashArr
+) {
+    if (hashArr.empty()) {
+        return;
+    }
+    if (!proj.IsSingleCatFeature()) {
+        CalcHashes(
+            proj,
+            objectsData,
+            featuresSubsetIndexing,
+            nullptr,
+            processBundledAndBinaryFeaturesInPacks,
+            hashArr.begin(),
+            hashArr.end(),
+            localExecutor);
+        return;
+    }
+
+    // Shortcut for simple ctrs
+    auto catFeatureIdx = TCatFeatureIdx((ui32)proj.CatFeatures[0]);
+    const auto canUpdateHashOnce
+        = objectsData.GetExclusiveFeatureBundlesSize() + objectsData.GetBinaryFeaturesPacksSize() == 0;
+    if (!canUpdateHashOnce) {
+        ProcessFeatureForCalcHashes<ui32, EFeatureValuesType::PerfectHashedCategorical>(
+            objectsData.GetCatFeatureToExclusiveBundleIndex(catFeatureIdx),
+            objectsData.GetCatFeatureToPackedBinaryIndex(catFeatureIdx),
+            objectsData.GetCatFeatureToFeaturesGroupIndex(catFeatureIdx),
+            featuresSubsetIndexing,
+            /*processBundledAndBinaryFeaturesInPacks*/ false,
+            /*isBinaryFeatureEquals1*/ false, // unused
+            TArrayRef<TVector<TCalcHashInBundleContext>>(), // unused
+            TArrayRef<TBinaryFeaturesPack>(), // unused
+            TArrayRef<TBinaryFeaturesPack>(), // unused
+            TArrayRef<TVector<TCalcHashInGroupContext>>(), // unused
+            [&]() { return *objectsData.GetCatFeature(*catFeatureIdx); },
+            [&](ui32 bundleIdx) { return objectsData.GetExclusiveFeatureBundlesMetaData()[bundleIdx]; },
+            [&](ui32 bundleIdx) { return &objectsData.GetExclusiveFeaturesBundle(bundleIdx); },
+            [&](ui32 packIdx) { return &objectsData.GetBinaryFeaturesPack(packIdx); },
+            [&](ui32 groupIdx) { return &objectsData.GetFeaturesGroup(groupIdx); },
+            [hashArr] (ui32 i, ui32 featureValue) {
+                hashArr[i] = (ui64)featureValue + 1;
+            },
+            localExecutor
+        );
+    } else {
+        CopyCatColumnToHash(
+            **objectsData.GetCatFeature(*catFeatureIdx),
+            featuresSubsetIndexing,
+            localExecutor,
+            hashArr.data()
+        );
+    }
+}
+
+// Hashes of projection values of all test objects one test set after another
+static void CalcTestProjectionHashes(
+    const TTrainingForCPUDataProviders& data,
+    const TProjection& proj,
+    bool processBundledAndBinaryFeaturesInPacks,
+    NPar::TLocalExecutor* localExecutor,
+    TArrayRef<ui64> hashArr
+) {
+    size_t docOffset = 0;
+    for (const auto& testData : data.Test) {
+        const size_t testSampleCount = testData->GetObjectCount();
+        CalcProjectionHashes(
+            proj,
+            *testData->ObjectsData,
+            testData->ObjectsData->GetFeaturesArraySubsetIndexing(),
+            processBundledAndBinaryFeaturesInPacks,
+            localExecutor,
+            MakeArrayRef(hashArr.data() + docOffset, testSampleCount));
+        docOffset += testSampleCount;
+    }
+}
+
 void ComputeOnlineCTRs(
     const TTrainingForCPUDataProviders& data,
     const TFold& fold,
@@ -554,6 +644,8 @@ void ComputeOnlineCTRs(
     const TLearnContext* ctx,
     TOnlineCTR* dst) {
 
+    CATBOOST_TRACE_SCOPE("Compute online CTRs");
+
     const TCtrHelper& ctrHelper = ctx->CtrsHelper;
     const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
     dst->Feature.resize(ctrInfo.size());
@@ -570,120 +662,24 @@ void ComputeOnlineCTRs(
     TVector<ui64>& hashArr = tlsHashArr.Get();
     hashArr.yresize(totalSampleCount);
     ParallelFill<ui64>(/*fillValue*/0, /*blockSize*/Nothing(), ctx->LocalExecutor, MakeArrayRef(hashArr));
+    CalcProjectionHashes(
+        proj,
+        *data.Learn->ObjectsData,
+        fold.LearnPermutationFeaturesSubset,
+        ctx->LearnAndTestDataPackingAreCompatible,
+        ctx->LocalExecutor,
+        MakeArrayRef(hashArr.data(), learnSampleCount));
+    CalcTestProjectionHashes(
+        data,
+        proj,
+        ctx->LearnAndTestDataPackingAreCompatible,
+        ctx->LocalExecutor,
+        MakeArrayRef(hashArr.data() + learnSampleCount, totalSampleCount - learnSampleCount));
     if (proj.IsSingleCatFeature()) {
-        // Shortcut for simple ctrs
-
-        auto catFeatureIdx = TCatFeatureIdx((ui32)proj.CatFeatures[0]);
-        const auto canUpdateHashOnce = data.Learn->ObjectsData->GetExclusiveFeatureBundlesSize() + data.Learn->ObjectsData->GetBinaryFeaturesPacksSize() == 0;
-
-        TArrayRef<ui64> hashArrView(hashArr);
-        if (learnSampleCount > 0) {
-            if (!canUpdateHashOnce) {
-                ProcessFeatureForCalcHashes<ui32, EFeatureValuesType::PerfectHashedCategorical>(
-                    data.Learn->ObjectsData->GetCatFeatureToExclusiveBundleIndex(catFeatureIdx),
-                    data.Learn->ObjectsData->GetCatFeatureToPackedBinaryIndex(catFeatureIdx),
-                    data.Learn->ObjectsData->GetCatFeatureToFeaturesGroupIndex(catFeatureIdx),
-                    fold.LearnPermutationFeaturesSubset,
-                    /*processBundledAndBinaryFeaturesInPacks*/ false,
-                    /*isBinaryFeatureEquals1*/ false, // unused
-                    TArrayRef<TVector<TCalcHashInBundleContext>>(), // unused
-                    TArrayRef<TBinaryFeaturesPack>(), // unused
-                    TArrayRef<TBinaryFeaturesPack>(), // unused
-                    TArrayRef<TVector<TCalcHashInGroupContext>>(), // unused
-                    [&]() { return *data.Learn->ObjectsData->GetCatFeature(*catFeatureIdx); },
-                    [&](ui32 bundleIdx) {
-                        return data.Learn->ObjectsData->GetExclusiveFeatureBundlesMetaData()[bundleIdx];
-                    },
-                    [&](ui32 bundleIdx) { return &data.Learn->ObjectsData->GetExclusiveFeaturesBundle(bundleIdx); },
-                    [&](ui32 packIdx) { return &data.Learn->ObjectsData->GetBinaryFeaturesPack(packIdx); },
-                    [&](ui32 groupIdx) { return &data.Learn->ObjectsData->GetFeaturesGroup(groupIdx); },
-                    [hashArrView] (ui32 i, ui32 featureValue) {
-                        hashArrView[i] = (ui64)featureValue + 1;
-                    },
-                    ctx->LocalExecutor
-                );
-            } else {
-                CopyCatColumnToHash(
-                    **data.Learn->ObjectsData->GetCatFeature(*catFeatureIdx),
-                    fold.LearnPermutationFeaturesSubset,
-                    ctx->LocalExecutor,
-                    hashArrView.data()
-                );
-            }
-        }
-        for (size_t docOffset = learnSampleCount, testIdx = 0;
-             docOffset < totalSampleCount && testIdx < data.Test.size();
-             ++testIdx)
-        {
-            const size_t testSampleCount = data.Test[testIdx]->GetObjectCount();
-            const auto canUpdateHashOnce = data.Test[testIdx]->ObjectsData->GetExclusiveFeatureBundlesSize() + data.Test[testIdx]->ObjectsData->GetBinaryFeaturesPacksSize() == 0;
-
-            if (!canUpdateHashOnce) {
-                ProcessFeatureForCalcHashes<ui32, EFeatureValuesType::PerfectHashedCategorical>(
-                    data.Test[testIdx]->ObjectsData->GetCatFeatureToExclusiveBundleIndex(catFeatureIdx),
-                    data.Test[testIdx]->ObjectsData->GetCatFeatureToPackedBinaryIndex(catFeatureIdx),
-                    data.Test[testIdx]->ObjectsData->GetCatFeatureToFeaturesGroupIndex(catFeatureIdx),
-                    data.Test[testIdx]->ObjectsData->GetFeaturesArraySubsetIndexing(),
-                    /*processBundledAndBinaryFeaturesInPacks*/ false,
-                    /*isBinaryFeatureEquals1*/ false, // unused
-                    TArrayRef<TVector<TCalcHashInBundleContext>>(), // unused
-                    TArrayRef<TBinaryFeaturesPack>(), // unused
-                    TArrayRef<TBinaryFeaturesPack>(), // unused
-                    TArrayRef<TVector<TCalcHashInGroupContext>>(), // unused
-                    [&]() { return *data.Test[testIdx]->ObjectsData->GetCatFeature(*catFeatureIdx); },
-                    [&](ui32 bundleIdx) {
-                        return data.Test[testIdx]->ObjectsData->GetExclusiveFeatureBundlesMetaData()[bundleIdx];
-                    },
-                    [&](ui32 bundleIdx) {
-                        return &data.Test[testIdx]->ObjectsData->GetExclusiveFeaturesBundle(bundleIdx);
-                    },
-                    [&](ui32 packIdx) { return &data.Test[testIdx]->ObjectsData->GetBinaryFeaturesPack(packIdx); },
-                    [&](ui32 groupIdx) { return &data.Learn->ObjectsData->GetFeaturesGroup(groupIdx); },
-                    [hashArrView, docOffset] (ui32 i, ui32 featureValue) {
-                        hashArrView[docOffset + i] = (ui64)featureValue + 1;
-                    },
-                    ctx->LocalExecutor
-                );
-            } else {
-                CopyCatColumnToHash(
-                    **data.Test[testIdx]->ObjectsData->GetCatFeature(*catFeatureIdx),
-                    data.Test[testIdx]->ObjectsData->GetFeaturesArraySubsetIndexing(),
-                    ctx->LocalExecutor,
-                    hashArrView.data() + docOffset
-                );
-            }
-
-            docOffset += testSampleCount;
-        }
         rehashHashTlsVal.Get().MakeEmpty(
             quantizedFeaturesInfo.GetUniqueValuesCounts(TCatFeatureIdx(proj.CatFeatures[0])).OnLearnOnly
         );
     } else {
-        CalcHashes(
-            proj,
-            *data.Learn->ObjectsData,
-            fold.LearnPermutationFeaturesSubset,
-            nullptr,
-            /*processBundledAndBinaryFeaturesInPacks*/ ctx->LearnAndTestDataPackingAreCompatible,
-            hashArr.begin(),
-            hashArr.begin() + learnSampleCount,
-            ctx->LocalExecutor);
-        for (size_t docOffset = learnSampleCount, testIdx = 0;
-             docOffset < totalSampleCount && testIdx < data.Test.size();
-             ++testIdx)
-        {
-            const size_t testSampleCount = data.Test[testIdx]->GetObjectCount();
-            CalcHashes(
-                proj,
-                *data.Test[testIdx]->ObjectsData,
-                data.Test[testIdx]->ObjectsData->GetFeaturesArraySubsetIndexing(),
-                nullptr,
-                /*processBundledAndBinaryFeaturesInPacks*/ ctx->LearnAndTestDataPackingAreCompatible,
-                hashArr.begin() + docOffset,
-                hashArr.begin() + docOffset + testSampleCount,
-                ctx->LocalExecutor);
-            docOffset += testSampleCount;
-        }
         size_t approxBucketsCount = 1;
         for (auto cf : proj.CatFeatures) {
             approxBucketsCount *= quantizedFeaturesInfo.GetUniqueValuesCounts(TCatFeatureIdx(cf)).OnLearnOnly;
@@ -802,6 +798,381 @@ void ComputeOnlineCTRs(
         NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
+// Indices of projection values of learn objects in fold permutation order,
+// values are enumerated in order of their first appearance
+static TVector<ui64> CalcValueIndices(
+    const TTrainingForCPUDataProvider& learnData,
+    const TFold& fold,
+    const TProjection& proj,
+    bool learnAndTestDataPackingAreCompatible,
+    NPar::TLocalExecutor* localExecutor,
+    TDenseHash<ui64, ui32>* valueIndices
+) {
+    TVector<ui64> hashArr(learnData.GetObjectCount(), 0);
+    CalcProjectionHashes(
+        proj,
+        *learnData.ObjectsData,
+        fold.LearnPermutationFeaturesSubset,
+        learnAndTestDataPackingAreCompatible,
+        localExecutor,
+        hashArr);
+    ComputeReindexHash(Max<ui64>(), valueIndices, hashArr.data(), hashArr.data() + hashArr.size());
+    return hashArr;
+}
+
+// Values of a ctr calculated from counters of object buckets. If targetClass is not empty, objects are
+// learn ones in fold permutation order and classCounts are updated after the value of each object is calculated
+static void CalcCtrValuesFromCounters(
+    const TCtrInfo& ctrInfo,
+    int targetClassesCount,
+    TConstArrayRef<ui32> objectBuckets,
+    TConstArrayRef<int> targetClass,
+    TArrayRef<int> classCounts, // [bucketIdx * targetClassesCount + classIdx], unused for counter ctrs
+    TConstArrayRef<int> counterTotals, // [bucketIdx], used for counter ctrs only
+    int counterDenominator,
+    TArray2D<TVector<ui8>>* feature
+) {
+    TVector<float> shift;
+    TVector<float> norm;
+    CalcNormalization(ctrInfo.Priors, &shift, &norm);
+
+    const auto& priors = ctrInfo.Priors;
+    const int ctrBorderCount = ctrInfo.BorderCount;
+    const int targetBorderCount = GetTargetBorderCount(ctrInfo, targetClassesCount);
+    auto setCtrValues = [&] (int border, size_t objectIdx, float countInClass, int totalCount) {
+        for (int prior = 0; prior < priors.ysize(); ++prior) {
+            (*feature)[border][prior][objectIdx] = CalcCTR(
+                countInClass,
+                totalCount,
+                priors[prior],
+                shift[prior],
+                norm[prior],
+                ctrBorderCount);
+        }
+    };
+
+    for (size_t objectIdx : xrange(objectBuckets.size())) {
+        const ui32 bucket = objectBuckets[objectIdx];
+        if (ctrInfo.Type == ECtrType::Counter) {
+            setCtrValues(0, objectIdx, counterTotals[bucket], counterDenominator);
+            continue;
+        }
+        TArrayRef<int> counts(classCounts.data() + (size_t)bucket * targetClassesCount, targetClassesCount);
+        const int totalCount = Accumulate(counts.begin(), counts.end(), 0);
+        if (ctrInfo.Type == ECtrType::BinarizedTargetMeanValue) {
+            float sum = 0;
+            for (int classIdx : xrange(targetClassesCount)) {
+                sum += counts[classIdx] * (static_cast<float>(classIdx) / (targetClassesCount - 1));
+            }
+            setCtrValues(0, objectIdx, sum, totalCount);
+        } else {
+            int goodCount = totalCount;
+            for (int border = 0; border < targetBorderCount; ++border) {
+                UpdateGoodCount(counts[border], ctrInfo.Type, &goodCount);
+                setCtrValues(border, objectIdx, goodCount, totalCount);
+            }
+        }
+        if (!targetClass.empty()) {
+            ++counts[targetClass[objectIdx]];
+        }
+    }
+}
+
+static void AllocateCtrValues(const TCtrInfo& ctrInfo, int targetClassesCount, size_t objectCount, TArray2D<TVector<ui8>>* feature) {
+    const int targetBorderCount = GetTargetBorderCount(ctrInfo, targetClassesCount);
+    feature->SetSizes(ctrInfo.Priors.size(), targetBorderCount);
+    for (int border = 0; border < targetBorderCount; ++border) {
+        for (int prior = 0; prior < ctrInfo.Priors.ysize(); ++prior) {
+            (*feature)[border][prior].yresize(objectCount);
+        }
+    }
+}
+
+void CalcOnlineCtrPartStats(
+    const TTrainingForCPUDataProvider& learnData,
+    const TFold& fold,
+    const TProjection& proj,
+    const TCtrHelper& ctrHelper,
+    bool learnAndTestDataPackingAreCompatible,
+    NPar::TLocalExecutor* localExecutor,
+    TOnlineCtrPartStats* stats
+) {
+    CATBOOST_TRACE_SCOPE("Calc online CTR part stats");
+
+    TDenseHash<ui64, ui32> valueIndices;
+    const TVector<ui64> valueIdxArr = CalcValueIndices(
+        learnData,
+        fold,
+        proj,
+        learnAndTestDataPackingAreCompatible,
+        localExecutor,
+        &valueIndices);
+    const size_t valueCount = valueIndices.Size();
+
+    stats->Hashes.yresize(valueCount);
+    for (const auto& it : valueIndices) {
+        stats->Hashes[it.second] = it.first;
+    }
+    stats->TotalCounts.assign(valueCount, 0);
+    for (auto valueIdx : valueIdxArr) {
+        ++stats->TotalCounts[valueIdx];
+    }
+
+    stats->ClassCounts.assign(ctrHelper.GetTargetClassifiers().size(), {});
+    for (const auto& info : ctrHelper.GetCtrInfo(proj)) {
+        auto& classCounts = stats->ClassCounts[info.TargetClassifierIdx];
+        if ((info.Type == ECtrType::Counter) || !classCounts.empty()) {
+            continue;
+        }
+        const int targetClassesCount = fold.TargetClassesCount[info.TargetClassifierIdx];
+        const auto& targetClass = fold.LearnTargetClass[info.TargetClassifierIdx];
+        classCounts.assign(valueCount * targetClassesCount, 0);
+        for (auto objectIdx : xrange(valueIdxArr.size())) {
+            ++classCounts[valueIdxArr[objectIdx] * targetClassesCount + targetClass[objectIdx]];
+        }
+    }
+}
+
+void MergeOnlineCtrPartStats(
+    const TTrainingForCPUDataProviders& data,
+    TConstArrayRef<TOnlineCtrPartStats> partStats,
+    const TProjection& proj,
+    const TCtrHelper& ctrHelper,
+    TConstArrayRef<int> targetClassesCount,
+    const NCatboostOptions::TCatFeatureParams& catFeatureParams,
+    bool learnAndTestDataPackingAreCompatible,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TOnlineCtrPartStart>* partStarts,
+    TOnlineCTR* testCtr
+) {
+    CATBOOST_TRACE_SCOPE("Merge online CTR part stats");
+
+    // enumerate values of all parts in order of their first appearance
+    THashMap<ui64, ui32> valueIndices;
+    TVector<ui64> hashes;
+    TVector<int> totalCounts;
+    size_t learnSampleCount = 0;
+    for (const auto& stats : partStats) {
+        for (auto partValueIdx : xrange(stats.Hashes.size())) {
+            const auto [it, inserted] = valueIndices.emplace(stats.Hashes[partValueIdx], hashes.size());
+            if (inserted) {
+                hashes.push_back(stats.Hashes[partValueIdx]);
+                totalCounts.push_back(0);
+            }
+            totalCounts[it->second] += stats.TotalCounts[partValueIdx];
+            learnSampleCount += stats.TotalCounts[partValueIdx];
+        }
+    }
+    const size_t valueCount = hashes.size();
+
+    // buckets are assigned the same way as ComputeReindexHash does on the whole learn data
+    ui64 topSize = catFeatureParams.CtrLeafCountLimit;
+    if (proj.IsSingleCatFeature() && catFeatureParams.StoreAllSimpleCtrs) {
+        topSize = Max<ui64>();
+    }
+    TVector<ui32> bucketByValue(valueCount);
+    THashMap<ui64, ui32> bucketByHash; // values with buckets of their own
+    size_t leafCount = valueCount;
+    if ((topSize > learnSampleCount) || (valueCount <= topSize)) {
+        Iota(bucketByValue.begin(), bucketByValue.end(), 0u);
+        for (auto valueIdx : xrange(valueCount)) {
+            bucketByHash.emplace(hashes[valueIdx], valueIdx);
+        }
+    } else {
+        TVector<ui32> valuesByFrequency(valueCount);
+        Iota(valuesByFrequency.begin(), valuesByFrequency.end(), 0u);
+        std::nth_element(
+            valuesByFrequency.begin(),
+            valuesByFrequency.begin() + topSize,
+            valuesByFrequency.end(),
+            [&] (ui32 lhs, ui32 rhs) { return totalCounts[lhs] > totalCounts[rhs]; });
+        // rare values share the bucket of the last frequent one
+        Fill(bucketByValue.begin(), bucketByValue.end(), (ui32)(topSize - 1));
+        for (ui32 bucket : xrange(topSize)) {
+            bucketByValue[valuesByFrequency[bucket]] = bucket;
+            bucketByHash.emplace(hashes[valuesByFrequency[bucket]], bucket);
+        }
+        leafCount = topSize;
+    }
+
+    // unseen test values get new buckets as in UpdateReindexHash
+    const size_t testSampleCount = data.GetTestSampleCount();
+    TVector<ui64> testHashes(testSampleCount, 0);
+    CalcTestProjectionHashes(data, proj, learnAndTestDataPackingAreCompatible, localExecutor, testHashes);
+    TVector<ui32> testBuckets;
+    testBuckets.yresize(testSampleCount);
+    for (auto objectIdx : xrange(testSampleCount)) {
+        testBuckets[objectIdx] = bucketByHash.emplace(testHashes[objectIdx], bucketByHash.size()).first->second;
+    }
+    const size_t bucketCount = bucketByHash.size();
+    testCtr->CounterUniqueValuesCount = testCtr->UniqueValuesCount = leafCount;
+
+    const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
+    TVector<int> counterTotals;
+    int counterDenominator = 0;
+    if (AnyOf(ctrInfo, [] (const auto& info) { return info.Type == ECtrType::Counter; })) {
+        counterTotals.assign(bucketCount, 0);
+        for (auto valueIdx : xrange(valueCount)) {
+            counterTotals[bucketByValue[valueIdx]] += totalCounts[valueIdx];
+        }
+        if (catFeatureParams.CounterCalcMethod == ECounterCalc::Full) {
+            testCtr->CounterUniqueValuesCount = bucketCount;
+            for (auto bucket : testBuckets) {
+                ++counterTotals[bucket];
+            }
+        }
+        counterDenominator = *MaxElement(counterTotals.begin(), counterTotals.end());
+    }
+
+    TVector<TVector<int>> classCounts(targetClassesCount.size()); // accumulated over the preceding parts
+    for (const auto& info : ctrInfo) {
+        if (info.Type != ECtrType::Counter) {
+            classCounts[info.TargetClassifierIdx].assign(bucketCount * targetClassesCount[info.TargetClassifierIdx], 0);
+        }
+    }
+
+    partStarts->resize(partStats.size());
+    TVector<ui32> partBucketIndices(leafCount, Max<ui32>());
+    for (auto partIdx : xrange(partStats.size())) {
+        const auto& stats = partStats[partIdx];
+        auto& partStart = (*partStarts)[partIdx];
+
+        // enumerate buckets used by the part to send only their counters
+        TVector<ui32> valueBuckets;
+        valueBuckets.yresize(stats.Hashes.size());
+        TVector<ui32> partBuckets;
+        partStart.BucketByValue.yresize(stats.Hashes.size());
+        for (auto partValueIdx : xrange(stats.Hashes.size())) {
+            const ui32 bucket = bucketByValue[valueIndices.at(stats.Hashes[partValueIdx])];
+            if (partBucketIndices[bucket] == Max<ui32>()) {
+                partBucketIndices[bucket] = partBuckets.size();
+                partBuckets.push_back(bucket);
+            }
+            valueBuckets[partValueIdx] = bucket;
+            partStart.BucketByValue[partValueIdx] = partBucketIndices[bucket];
+        }
+
+        partStart.ClassCountsBefore.assign(classCounts.size(), {});
+        for (auto classifierIdx : xrange(classCounts.size())) {
+            if (classCounts[classifierIdx].empty()) {
+                continue;
+            }
+            const int classCount = targetClassesCount[classifierIdx];
+            auto& partClassCounts = partStart.ClassCountsBefore[classifierIdx];
+            partClassCounts.yresize(partBuckets.size() * classCount);
+            for (auto partBucket : xrange(partBuckets.size())) {
+                std::copy_n(
+                    classCounts[classifierIdx].begin() + (size_t)partBuckets[partBucket] * classCount,
+                    classCount,
+                    partClassCounts.begin() + partBucket * classCount);
+            }
+            for (auto partValueIdx : xrange(stats.Hashes.size())) {
+                for (int classIdx : xrange(classCount)) {
+                    classCounts[classifierIdx][(size_t)valueBuckets[partValueIdx] * classCount + classIdx]
+                        += stats.ClassCounts[classifierIdx][partValueIdx * classCount + classIdx];
+                }
+            }
+        }
+
+        partStart.CounterTotals.clear();
+        if (!counterTotals.empty()) {
+            partStart.CounterTotals.yresize(partBuckets.size());
+            for (auto partBucket : xrange(partBuckets.size())) {
+                partStart.CounterTotals[partBucket] = counterTotals[partBuckets[partBucket]];
+            }
+        }
+        partStart.CounterDenominator = counterDenominator;
+        partStart.UniqueValuesCount = testCtr->UniqueValuesCount;
+        partStart.CounterUniqueValuesCount = testCtr->CounterUniqueValuesCount;
+
+        for (auto bucket : partBuckets) {
+            partBucketIndices[bucket] = Max<ui32>();
+        }
+    }
+
+    // test values are calculated from counters of the whole learn data
+    testCtr->Feature.resize(ctrInfo.size());
+    localExecutor->ExecRange(
+        [&] (int ctrIdx) {
+            const auto& info = ctrInfo[ctrIdx];
+            const int classCount = targetClassesCount[info.TargetClassifierIdx];
+            AllocateCtrValues(info, classCount, testSampleCount, &testCtr->Feature[ctrIdx]);
+            CalcCtrValuesFromCounters(
+                info,
+                classCount,
+                testBuckets,
+                /*targetClass*/ {},
+                classCounts[info.TargetClassifierIdx],
+                counterTotals,
+                counterDenominator,
+                &testCtr->Feature[ctrIdx]);
+        },
+        0,
+        ctrInfo.ysize(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+void ComputeOnlineCTRsOnPart(
+    const TTrainingForCPUDataProvider& learnData,
+    const TFold& fold,
+    const TProjection& proj,
+    const TCtrHelper& ctrHelper,
+    const TOnlineCtrPartStart& partStart,
+    bool learnAndTestDataPackingAreCompatible,
+    NPar::TLocalExecutor* localExecutor,
+    TOnlineCTR* dst
+) {
+    CATBOOST_TRACE_SCOPE("Compute online CTRs on part");
+
+    TDenseHash<ui64, ui32> valueIndices;
+    const TVector<ui64> valueIdxArr = CalcValueIndices(
+        learnData,
+        fold,
+        proj,
+        learnAndTestDataPackingAreCompatible,
+        localExecutor,
+        &valueIndices);
+    CB_ENSURE_INTERNAL(
+        valueIndices.Size() == partStart.BucketByValue.size(),
+        "Online CTR part start does not match learn data of the part");
+    TVector<ui32> objectBuckets;
+    objectBuckets.yresize(valueIdxArr.size());
+    for (auto objectIdx : xrange(valueIdxArr.size())) {
+        objectBuckets[objectIdx] = partStart.BucketByValue[valueIdxArr[objectIdx]];
+    }
+    dst->UniqueValuesCount = partStart.UniqueValuesCount;
+    dst->CounterUniqueValuesCount = partStart.CounterUniqueValuesCount;
+
+    const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
+    dst->Feature.resize(ctrInfo.size());
+    localExecutor->ExecRange(
+        [&] (int ctrIdx) {
+            const auto& info = ctrInfo[ctrIdx];
+            const ui32 classifierIdx = info.TargetClassifierIdx;
+            const int classCount = fold.TargetClassesCount[classifierIdx];
+            AllocateCtrValues(info, classCount, objectBuckets.size(), &dst->Feature[ctrIdx]);
+            TVector<int> classCounts;
+            TConstArrayRef<int> targetClass;
+            if (info.Type != ECtrType::Counter) {
+                classCounts = partStart.ClassCountsBefore[classifierIdx];
+                targetClass = fold.LearnTargetClass[classifierIdx];
+            }
+            CalcCtrValuesFromCounters(
+                info,
+                classCount,
+                objectBuckets,
+                targetClass,
+                classCounts,
+                partStart.CounterTotals,
+                partStart.CounterDenominator,
+                &dst->Feature[ctrIdx]);
+        },
+        0,
+        ctrInfo.ysize(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+
 void CalcFinalCtrsImpl(
     const ECtrType ctrType,
     const ui64 ctrLeafCountLimit,
@@ -6,16 +6,24 @@
 #include <catboost/libs/data/quantized_features_info.h>
 #include <catboost/libs/model/online_ctr.h>
 
+#include <library/binsaver/bin_saver.h>
+
+#include <util/generic/array_ref.h>
 #include <util/generic/maybe.h>
 #include <util/system/types.h>
 
 #include <functional>
 
 
+class TCtrHelper;
 class TCtrValueTable;
 class TFold;
 class TLearnContext;
 
+namespace NCatboostOptions {
+    class TCatFeatureParams;
+}
+
 namespace NCB {
     template <class TSize>
     class TArraySubsetIndexing;
@@ -68,6 +76,81 @@ void ComputeOnlineCTRs(
 );
 
 
+/* Online ctrs in distributed training: each worker collects counters of projection values on its part
+ * of learn data, the master merges them and sends back to each worker the counters accumulated on
+ * the preceding parts, so that the workers compute the same online ctr values as a single host would
+ * on the concatenation of the parts.
+ */
+
+// Counters of projection values on a part of learn data,
+// values are enumerated in order of their first appearance in the fold permutation
+struct TOnlineCtrPartStats {
+    TVector<ui64> Hashes; // [valueIdx]
+    TVector<int> TotalCounts; // [valueIdx]
+    // [targetClassifierIdx][valueIdx * targetClassesCount + classIdx], empty if classifier is not used
+    TVector<TVector<int>> ClassCounts;
+
+public:
+    SAVELOAD(Hashes, TotalCounts, ClassCounts);
+};
+
+// Starting counters for online ctrs of a part of learn data
+struct TOnlineCtrPartStart {
+    TVector<ui32> BucketByValue; // [valueIdx of TOnlineCtrPartStats]
+    // counted on the preceding parts, [targetClassifierIdx][bucketIdx * targetClassesCount + classIdx]
+    TVector<TVector<int>> ClassCountsBefore;
+    TVector<int> CounterTotals; // [bucketIdx], empty if there're no counter ctrs
+    int CounterDenominator = 0;
+    size_t UniqueValuesCount = 0;
+    size_t CounterUniqueValuesCount = 0;
+
+public:
+    SAVELOAD(
+        BucketByValue,
+        ClassCountsBefore,
+        CounterTotals,
+        CounterDenominator,
+        UniqueValuesCount,
+        CounterUniqueValuesCount);
+};
+
+void CalcOnlineCtrPartStats(
+    const NCB::TTrainingForCPUDataProvider& learnData,
+    const TFold& fold,
+    const TProjection& proj,
+    const TCtrHelper& ctrHelper,
+    bool learnAndTestDataPackingAreCompatible,
+    NPar::TLocalExecutor* localExecutor,
+    TOnlineCtrPartStats* stats
+);
+
+// data.Learn is not used, partStats are in order of learn data parts
+void MergeOnlineCtrPartStats(
+    const NCB::TTrainingForCPUDataProviders& data,
+    TConstArrayRef<TOnlineCtrPartStats> partStats,
+    const TProjection& proj,
+    const TCtrHelper& ctrHelper,
+    TConstArrayRef<int> targetClassesCount, // [targetClassifierIdx]
+    const NCatboostOptions::TCatFeatureParams& catFeatureParams,
+    bool learnAndTestDataPackingAreCompatible,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TOnlineCtrPartStart>* partStarts,
+    TOnlineCTR* testCtr // values for test data only
+);
+
+// computes values for learn data of the part only
+void ComputeOnlineCTRsOnPart(
+    const NCB::TTrainingForCPUDataProvider& learnData,
+    const TFold& fold,
+    const TProjection& proj,
+    const TCtrHelper& ctrHelper,
+    const TOnlineCtrPartStart& partStart,
+    bool learnAndTestDataPackingAreCompatible,
+    NPar::TLocalExecutor* localExecutor,
+    TOnlineCTR* dst
+);
+
+
 struct TDatasetDataForFinalCtrs {
     NCB::TTrainingForCPUDataProviders Data;
 
@@ -11,6 +11,16 @@
 using namespace NCB;
 
 
+void TPairWeightStatisticsArena::Add(const TPairWeightStatisticsArena& rhs) {
+    Y_ASSERT(LeafCount == rhs.LeafCount);
+    Y_ASSERT(StatsCount == rhs.StatsCount);
+
+    for (auto idx : xrange(Data.size())) {
+        Data[idx].Add(rhs.Data[idx]);
+    }
+}
+
+
 void TPairwiseStats::Add(const TPairwiseStats& rhs) {
     Y_ASSERT(SplitEnsembleSpec == rhs.SplitEnsembleSpec);
 
@@ -27,24 +37,7 @@ void TPairwiseStats::Add(const TPairwiseStats& rhs) {
         }
     }
 
-    Y_ASSERT(PairWeightStatistics.GetXSize() == rhs.PairWeightStatistics.GetXSize());
-    Y_ASSERT(PairWeightStatistics.GetYSize() == rhs.PairWeightStatistics.GetYSize());
-
-    for (auto leafIdx1 : xrange(PairWeightStatistics.GetYSize())) {
-        auto dst1 = PairWeightStatistics[leafIdx1];
-        const auto add1 = rhs.PairWeightStatistics[leafIdx1];
-
-        for (auto leafIdx2 : xrange(PairWeightStatistics.GetXSize())) {
-            auto& dst2 = dst1[leafIdx2];
-            const auto& add2 = add1[leafIdx2];
-
-            Y_ASSERT(dst2.size() == add2.size());
-
-            for (auto bucketIdx : xrange(dst2.size())) {
-                dst2[bucketIdx].Add(add2[bucketIdx]);
-            }
-        }
-    }
+    PairWeightStatistics.Add(rhs.PairWeightStatistics);
 }
 
 
@@ -152,8 +145,8 @@ void CalculatePairwiseScore(
 
                 for (int y = 0; y < leafCount; ++y) {
                     for (int x = y + 1; x < leafCount; ++x) {
-                        const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                        const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                        const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                        const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
                         auto totalXY0 = NSimdOps::MakeZeros();
                         auto totalXY2 = NSimdOps::MakeZeros();
                         auto totalYX0 = NSimdOps::MakeZeros();
@@ -207,16 +200,16 @@ void CalculatePairwiseScore(
                         derSum[2 * y] += derDelta;
                         derSum[2 * y + 1] -= derDelta;
 
-                        const double weightDelta = (pairWeightStatistics[y][y][splitId].SmallerBorderWeightSum
-                            - pairWeightStatistics[y][y][splitId].GreaterBorderRightWeightSum);
+                        const double weightDelta = (pairWeightStatistics(y, y)[splitId].SmallerBorderWeightSum
+                            - pairWeightStatistics(y, y)[splitId].GreaterBorderRightWeightSum);
                         weightSum[2 * y][2 * y + 1] += weightDelta;
                         weightSum[2 * y + 1][2 * y] += weightDelta;
                         weightSum[2 * y][2 * y] -= weightDelta;
                         weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
 
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics& xy = pairWeightStatistics[x][y][splitId];
-                            const TBucketPairWeightStatistics& yx = pairWeightStatistics[y][x][splitId];
+                            const TBucketPairWeightStatistics& xy = pairWeightStatistics(x, y)[splitId];
+                            const TBucketPairWeightStatistics& yx = pairWeightStatistics(y, x)[splitId];
 
                             UpdateWeightSumFromNonDiagStats(y, x, xy, yx, &weightSum);
                         }
@@ -253,16 +246,16 @@ void CalculatePairwiseScore(
 
                     for (int y = 0; y < leafCount; ++y) {
                         const double weightDelta =
-                            (pairWeightStatistics[y][y][2 * binFeatureIdx].SmallerBorderWeightSum
-                             - pairWeightStatistics[y][y][2 * binFeatureIdx].GreaterBorderRightWeightSum);
+                            (pairWeightStatistics(y, y)[2 * binFeatureIdx].SmallerBorderWeightSum
+                             - pairWeightStatistics(y, y)[2 * binFeatureIdx].GreaterBorderRightWeightSum);
                         weightSum[2 * y][2 * y + 1] += weightDelta;
                         weightSum[2 * y + 1][2 * y] += weightDelta;
                         weightSum[2 * y][2 * y] -= weightDelta;
                         weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
 
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
 
                             double total =
                                 xyData[2 * binFeatureIdx].SmallerBorderWeightSum
@@ -341,8 +334,8 @@ void CalculatePairwiseScore(
 
                     for (int y = 0; y < leafCount; ++y) {
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
                             auto totalXY0 = NSimdOps::MakeZeros();
                             auto totalXY2 = NSimdOps::MakeZeros();
                             auto totalYX0 = NSimdOps::MakeZeros();
@@ -397,16 +390,16 @@ void CalculatePairwiseScore(
                             }
 
                             const double weightDelta =
-                                (pairWeightStatistics[y][y][bucketId].SmallerBorderWeightSum
-                                 - pairWeightStatistics[y][y][bucketId].GreaterBorderRightWeightSum);
+                                (pairWeightStatistics(y, y)[bucketId].SmallerBorderWeightSum
+                                 - pairWeightStatistics(y, y)[bucketId].GreaterBorderRightWeightSum);
                             weightSum[2 * y][2 * y + 1] += weightDelta;
                             weightSum[2 * y + 1][2 * y] += weightDelta;
                             weightSum[2 * y][2 * y] -= weightDelta;
                             weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
 
                             for (int x = y + 1; x < leafCount; ++x) {
-                                const TBucketPairWeightStatistics& xy = pairWeightStatistics[x][y][bucketId];
-                                const TBucketPairWeightStatistics& yx = pairWeightStatistics[y][x][bucketId];
+                                const TBucketPairWeightStatistics& xy = pairWeightStatistics(x, y)[bucketId];
+                                const TBucketPairWeightStatistics& yx = pairWeightStatistics(y, x)[bucketId];
 
                                 UpdateWeightSumFromNonDiagStats(y, x, xy, yx, &weightSum);
                             }
@@ -448,8 +441,8 @@ void CalculatePairwiseScore(
                     }
                     for (int y = 0; y < leafCount; ++y) {
                         for (int x = y + 1; x < leafCount; ++x) {
-                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics[x][y].data();
-                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics[y][x].data();
+                            const TBucketPairWeightStatistics* xyData = pairWeightStatistics(x, y).data();
+                            const TBucketPairWeightStatistics* yxData = pairWeightStatistics(y, x).data();
                             auto totalXY0 = NSimdOps::MakeZeros();
                             auto totalXY2 = NSimdOps::MakeZeros();
                             auto totalYX0 = NSimdOps::MakeZeros();
@@ -496,15 +489,15 @@ void CalculatePairwiseScore(
                             derSum[2 * y] += derDelta;
                             derSum[2 * y + 1] -= derDelta;
                             const double weightDelta = (
-                                pairWeightStatistics[y][y][bucketId].SmallerBorderWeightSum
-                                - pairWeightStatistics[y][y][bucketId].GreaterBorderRightWeightSum);
+                                pairWeightStatistics(y, y)[bucketId].SmallerBorderWeightSum
+                                - pairWeightStatistics(y, y)[bucketId].GreaterBorderRightWeightSum);
                             weightSum[2 * y][2 * y + 1] += weightDelta;
                             weightSum[2 * y + 1][2 * y] += weightDelta;
                             weightSum[2 * y][2 * y] -= weightDelta;
                             weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
                             for (int x = y + 1; x < leafCount; ++x) {
-                                const TBucketPairWeightStatistics& xy = pairWeightStatistics[x][y][bucketId];
-                                const TBucketPairWeightStatistics& yx = pairWeightStatistics[y][x][bucketId];
+                                const TBucketPairWeightStatistics& xy = pairWeightStatistics(x, y)[bucketId];
+                                const TBucketPairWeightStatistics& yx = pairWeightStatistics(y, x)[bucketId];
                                 UpdateWeightSumFromNonDiagStats(y, x, xy, yx, &weightSum);
                             }
                         }
@@ -11,6 +11,9 @@
 
 #include <library/binsaver/bin_saver.h>
 
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+
 
 struct TBucketPairWeightStatistics {
     double SmallerBorderWeightSum = 0.0; // The weight sum of pair elements with smaller border.
@@ -26,6 +29,54 @@ public:
 };
 
 
+/* Pair weight statistics for all (leafIdx1, leafIdx2) cells in one contiguous buffer
+ *  with layout [leafIdx1][leafIdx2][statsIdx]
+ */
+class TPairWeightStatisticsArena {
+public:
+    TPairWeightStatisticsArena() = default;
+
+    TPairWeightStatisticsArena(int leafCount, int statsCount)
+        : LeafCount(leafCount)
+        , StatsCount(statsCount)
+        , Data((size_t)leafCount * leafCount * statsCount)
+    {}
+
+    SAVELOAD(LeafCount, StatsCount, Data);
+
+    int GetLeafCount() const {
+        return LeafCount;
+    }
+
+    int GetStatsCount() const {
+        return StatsCount;
+    }
+
+    TArrayRef<TBucketPairWeightStatistics> operator()(int leafIdx1, int leafIdx2) {
+        return TArrayRef<TBucketPairWeightStatistics>(Data.data() + GetCellOffset(leafIdx1, leafIdx2), StatsCount);
+    }
+
+    TConstArrayRef<TBucketPairWeightStatistics> operator()(int leafIdx1, int leafIdx2) const {
+        return TConstArrayRef<TBucketPairWeightStatistics>(
+            Data.data() + GetCellOffset(leafIdx1, leafIdx2),
+            StatsCount
+        );
+    }
+
+    void Add(const TPairWeightStatisticsArena& rhs);
+
+private:
+    size_t GetCellOffset(int leafIdx1, int leafIdx2) const {
+        return ((size_t)leafIdx1 * LeafCount + leafIdx2) * StatsCount;
+    }
+
+private:
+    int LeafCount = 0;
+    int StatsCount = 0;
+    TVector<TBucketPairWeightStatistics> Data;
+};
+
+
 struct TPairwiseStats {
     TVector<TVector<double>> DerSums; // [leafCount][bucketCount]
 
@@ -35,7 +86,7 @@ struct TPairwiseStats {
      *  For ExclusiveFeaturesBundle: bucketCount for all used features
      *  For FeaturesGroup:           bucketCount for all grouped features
      */
-    TArray2D<TVector<TBucketPairWeightStatistics>> PairWeightStatistics; // [leafCount][leafCount][statsCount]
+    TPairWeightStatisticsArena PairWeightStatistics; // [leafCount][leafCount][statsCount]
 
     TSplitEnsembleSpec SplitEnsembleSpec;
 
@@ -68,7 +119,7 @@ inline TVector<TVector<double>> ComputeDerSums(
 
 // TGetBucketFunc is of type ui32(ui32 docId)
 template <class TGetBucketFunc>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistics(
+inline TPairWeightStatisticsArena ComputePairWeightStatistics(
     const TFlatPairsInfo& pairs,
     int leafCount,
     int bucketCount,
@@ -76,8 +127,7 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
     TGetBucketFunc getBucketFunc,
     NCB::TIndexRange<int> pairIndexRange
 ) {
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(bucketCount));
+    TPairWeightStatisticsArena weightSums(leafCount, bucketCount);
     for (size_t pairIdx : pairIndexRange.Iter()) {
         const auto winnerIdx = pairs[pairIdx].WinnerId;
         const auto loserIdx = pairs[pairIdx].LoserId;
@@ -90,11 +140,11 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
         const auto loserLeafId = leafIndices[loserIdx];
         const float weight = pairs[pairIdx].Weight;
         if (winnerBucketId > loserBucketId) {
-            weightSums[loserLeafId][winnerLeafId][loserBucketId].SmallerBorderWeightSum -= weight;
-            weightSums[loserLeafId][winnerLeafId][winnerBucketId].GreaterBorderRightWeightSum -= weight;
+            weightSums(loserLeafId, winnerLeafId)[loserBucketId].SmallerBorderWeightSum -= weight;
+            weightSums(loserLeafId, winnerLeafId)[winnerBucketId].GreaterBorderRightWeightSum -= weight;
         } else {
-            weightSums[winnerLeafId][loserLeafId][winnerBucketId].SmallerBorderWeightSum -= weight;
-            weightSums[winnerLeafId][loserLeafId][loserBucketId].GreaterBorderRightWeightSum -= weight;
+            weightSums(winnerLeafId, loserLeafId)[winnerBucketId].SmallerBorderWeightSum -= weight;
+            weightSums(winnerLeafId, loserLeafId)[loserBucketId].GreaterBorderRightWeightSum -= weight;
         }
     }
 
@@ -103,7 +153,7 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
 
 // TGetBinaryFeaturesPack is of type TBinaryFeaturesPack(ui32 docId)
 template <class TGetBinaryFeaturesPack>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatisticsForBinaryFeaturesPacks(
+inline TPairWeightStatisticsArena ComputePairWeightStatisticsForBinaryFeaturesPacks(
     const TFlatPairsInfo& pairs,
     int leafCount,
     int bucketCount,
@@ -113,8 +163,7 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
 ) {
     const int binaryFeaturesCount = (int)GetValueBitCount(bucketCount - 1);
 
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(2 * binaryFeaturesCount));
+    TPairWeightStatisticsArena weightSums(leafCount, 2 * binaryFeaturesCount);
     for (size_t pairIdx : pairIndexRange.Iter()) {
         const auto winnerIdx = pairs[pairIdx].WinnerId;
         const auto loserIdx = pairs[pairIdx].LoserId;
@@ -132,13 +181,13 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
             auto loserBit = (loserFeaturesPack >> bitIndex) & 1;
 
             if (winnerBit > loserBit) {
-                weightSums[loserLeafId][winnerLeafId][2 * bitIndex].SmallerBorderWeightSum -= weight;
-                weightSums[loserLeafId][winnerLeafId][2 * bitIndex + 1].GreaterBorderRightWeightSum -= weight;
+                weightSums(loserLeafId, winnerLeafId)[2 * bitIndex].SmallerBorderWeightSum -= weight;
+                weightSums(loserLeafId, winnerLeafId)[2 * bitIndex + 1].GreaterBorderRightWeightSum -= weight;
             } else {
                 auto winnerBucketId = 2 * bitIndex + winnerBit;
-                weightSums[winnerLeafId][loserLeafId][winnerBucketId].SmallerBorderWeightSum -= weight;
+                weightSums(winnerLeafId, loserLeafId)[winnerBucketId].SmallerBorderWeightSum -= weight;
                 auto loserBucketId = 2 * bitIndex + loserBit;
-                weightSums[winnerLeafId][loserLeafId][loserBucketId].GreaterBorderRightWeightSum -= weight;
+                weightSums(winnerLeafId, loserLeafId)[loserBucketId].GreaterBorderRightWeightSum -= weight;
             }
         }
     }
@@ -149,7 +198,7 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
 
 // TGetExclusiveFeaturesBundleValue is of type TBundle(ui32 docId)
 template <class TGetExclusiveFeaturesBundleValue>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatisticsForExclusiveFeaturesBundle(
+inline TPairWeightStatisticsArena ComputePairWeightStatisticsForExclusiveFeaturesBundle(
     ui32 oneHotMaxSize,
     const TFlatPairsInfo& pairs,
     int leafCount,
@@ -172,8 +221,7 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
         }
     }
 
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(totalBucketCount));
+    TPairWeightStatisticsArena weightSums(leafCount, totalBucketCount);
     for (size_t pairIdx : pairIndexRange.Iter()) {
         const auto winnerIdx = pairs[pairIdx].WinnerId;
         const auto loserIdx = pairs[pairIdx].LoserId;
@@ -198,14 +246,14 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
             auto loserBucketId = NCB::GetBinFromBundle<ui32>(loserBundleValue, boundsInBundle);
 
             if (winnerBucketId > loserBucketId) {
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + loserBucketId].SmallerBorderWeightSum
+                weightSums(loserLeafId, winnerLeafId)[bucketOffset + loserBucketId].SmallerBorderWeightSum
                     -= weight;
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + winnerBucketId].GreaterBorderRightWeightSum
+                weightSums(loserLeafId, winnerLeafId)[bucketOffset + winnerBucketId].GreaterBorderRightWeightSum
                     -= weight;
             } else {
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + winnerBucketId].SmallerBorderWeightSum
+                weightSums(winnerLeafId, loserLeafId)[bucketOffset + winnerBucketId].SmallerBorderWeightSum
                     -= weight;
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + loserBucketId].GreaterBorderRightWeightSum
+                weightSums(winnerLeafId, loserLeafId)[bucketOffset + loserBucketId].GreaterBorderRightWeightSum
                     -= weight;
             }
 
@@ -219,7 +267,7 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
 
 // TGetFeaturesGroupValue is of type TGroupValue(ui32 docId)
 template <class TGetFeaturesGroupValue>
-inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatisticsForFeaturesGroup(
+inline TPairWeightStatisticsArena ComputePairWeightStatisticsForFeaturesGroup(
     const TFlatPairsInfo& pairs,
     int leafCount,
     const TVector<TIndexType>& leafIndices,
@@ -227,8 +275,7 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
     TGetFeaturesGroupValue getFeaturesGroupValue,
     NCB::TIndexRange<int> pairIndexRange
 ) {
-    TArray2D<TVector<TBucketPairWeightStatistics>> weightSums(leafCount, leafCount);
-    weightSums.FillEvery(TVector<TBucketPairWeightStatistics>(featuresGroup.TotalBucketCount));
+    TPairWeightStatisticsArena weightSums(leafCount, featuresGroup.TotalBucketCount);
     for (size_t pairIdx : pairIndexRange.Iter()) {
         const auto winnerIdx = pairs[pairIdx].WinnerId;
         const auto loserIdx = pairs[pairIdx].LoserId;
@@ -247,14 +294,14 @@ inline TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistic
             auto loserBucketId = NCB::GetPartValueFromGroup(loserGroupValue, partIdx);
 
             if (winnerBucketId > loserBucketId) {
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + loserBucketId].SmallerBorderWeightSum
+                weightSums(loserLeafId, winnerLeafId)[bucketOffset + loserBucketId].SmallerBorderWeightSum
                     -= weight;
-                weightSums[loserLeafId][winnerLeafId][bucketOffset + winnerBucketId].GreaterBorderRightWeightSum
+                weightSums(loserLeafId, winnerLeafId)[bucketOffset + winnerBucketId].GreaterBorderRightWeightSum
                     -= weight;
             } else {
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + winnerBucketId].SmallerBorderWeightSum
+                weightSums(winnerLeafId, loserLeafId)[bucketOffset + winnerBucketId].SmallerBorderWeightSum
                     -= weight;
-                weightSums[winnerLeafId][loserLeafId][bucketOffset + loserBucketId].GreaterBorderRightWeightSum
+                weightSums(winnerLeafId, loserLeafId)[bucketOffset + loserBucketId].GreaterBorderRightWeightSum
                     -= weight;
             }
 
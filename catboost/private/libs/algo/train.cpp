@@ -16,6 +16,8 @@
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/logging/profile_info.h>
 
+#include <util/generic/is_in.h>
+
 
 TErrorTracker BuildErrorTracker(
     EMetricBestValue bestValueType,
@@ -164,8 +166,10 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
             ctx->LearnProgress->Rand.GenRand()
         );
         if (ctx->Params.SystemOptions->IsSingleHost()) {
+            CATBOOST_TRACE_SCOPE("Calc derivatives");
             ctx->LocalExecutor->ExecRangeWithThrow(
                 [&](int bodyTailId) {
+                    CATBOOST_TRACE_SCOPE("Calc body tail derivatives");
                     CalcWeightedDerivatives(
                         *error,
                         bodyTailId,
@@ -201,9 +205,10 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
             trainFolds.push_back(&ctx->LearnProgress->Folds[foldId]);
         }
 
-        TrimOnlineCTRcache(trainFolds);
-        TrimOnlineCTRcache({ &ctx->LearnProgress->AveragingFold });
-        {
+        TrimOnlineCTRcache(trainFolds, ctx->MemoryPlan.MaxOnlineCtrFeatures);
+        TrimOnlineCTRcache({ &ctx->LearnProgress->AveragingFold }, ctx->MemoryPlan.MaxOnlineCtrFeatures);
+        if (ctx->Params.SystemOptions->IsSingleHost()) {
+            CATBOOST_TRACE_SCOPE("Compute online CTRs for tree struct");
             TVector<TFold*> allFolds = trainFolds;
             allFolds.push_back(&ctx->LearnProgress->AveragingFold);
 
@@ -248,6 +253,24 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
                 parallelJobsData.size(),
                 NPar::TLocalExecutor::WAIT_COMPLETE
             );
+        } else {
+            // learn values are kept by workers, the plain fold gets values for test data
+            Y_ASSERT(foldCount == 1);
+            CATBOOST_TRACE_SCOPE("Compute online CTRs for tree struct");
+            TFold* plainFold = trainFolds[0];
+            TVector<TProjection> missingProjections;
+            for (const auto& split : bestSplitTree.Splits) {
+                if (split.Type != ESplitType::OnlineCtr) {
+                    continue;
+                }
+                const auto& proj = split.Ctr.Projection;
+                if (!IsIn(missingProjections, proj)
+                    && (!plainFold->GetCtrs(proj).contains(proj) || plainFold->GetCtr(proj).Feature.empty()))
+                {
+                    missingProjections.push_back(proj);
+                }
+            }
+            MapCalcOnlineCtrs(data, missingProjections, plainFold, ctx);
         }
         profile.AddOperation("ComputeOnlineCTRs for tree struct (train folds and test fold)");
         CheckInterrupted(); // check after long-lasting operation
@@ -256,9 +279,11 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
         TVector<double> sumLeafWeights; // [leafId]
 
         if (ctx->Params.SystemOptions->IsSingleHost()) {
+            CATBOOST_TRACE_SCOPE("Estimate leaves");
             const TVector<ui64> randomSeeds = GenRandUI64Vector(foldCount, ctx->LearnProgress->Rand.GenRand());
             ctx->LocalExecutor->ExecRangeWithThrow(
                 [&](int foldId) {
+                    CATBOOST_TRACE_SCOPE("Update learning fold");
                     UpdateLearningFold(
                         data,
                         *error,
@@ -277,15 +302,18 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
             CheckInterrupted(); // check after long-lasting operation
 
             TVector<TIndexType> indices;
-            CalcLeafValues(
-                data,
-                *error,
-                ctx->LearnProgress->AveragingFold,
-                bestSplitTree,
-                ctx,
-                &treeValues,
-                &indices
-            );
+            {
+                CATBOOST_TRACE_SCOPE("Calc leaf values");
+                CalcLeafValues(
+                    data,
+                    *error,
+                    ctx->LearnProgress->AveragingFold,
+                    bestSplitTree,
+                    ctx,
+                    &treeValues,
+                    &indices
+                );
+            }
 
             ctx->Profile.AddOperation("CalcApprox result leaves");
             CheckInterrupted(); // check after long-lasting operation
@@ -0,0 +1,51 @@
+#include <catboost/private/libs/algo/memory_planner.h>
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/unittest/registar.h>
+
+Y_UNIT_TEST_SUITE(MemoryPlanner) {
+    static TTrainingMemoryEstimate MakeEstimate() {
+        TTrainingMemoryEstimate estimate;
+        estimate.QuantizedFeatures = 1000;
+        estimate.FoldApproxes = 1000;
+        estimate.OnlineSingleCtrs = 500;
+        estimate.OnlineTreeCtrsPerProjection = 100;
+        estimate.OnlineTreeCtrs = 100 * DEFAULT_MAX_ONLINE_CTR_FEATURES;
+        estimate.BucketStatsCache = 2000;
+        return estimate;
+    }
+
+    Y_UNIT_TEST(FitsIntoLimit) {
+        const auto plan = PlanTrainingMemory(MakeEstimate(), /*needTreeLevelCaching*/ true, 100000);
+        UNIT_ASSERT(plan.UseTreeLevelCaching);
+        UNIT_ASSERT_VALUES_EQUAL(plan.MaxOnlineCtrFeatures, DEFAULT_MAX_ONLINE_CTR_FEATURES);
+        UNIT_ASSERT_VALUES_EQUAL(plan.Estimate.GetTotal(), 9500);
+    }
+
+    Y_UNIT_TEST(DropsTreeLevelCachingFirst) {
+        const auto plan = PlanTrainingMemory(MakeEstimate(), /*needTreeLevelCaching*/ true, 8000);
+        UNIT_ASSERT(!plan.UseTreeLevelCaching);
+        UNIT_ASSERT_VALUES_EQUAL(plan.MaxOnlineCtrFeatures, DEFAULT_MAX_ONLINE_CTR_FEATURES);
+        UNIT_ASSERT_VALUES_EQUAL(plan.Estimate.BucketStatsCache, 0);
+    }
+
+    Y_UNIT_TEST(ShrinksOnlineCtrsCache) {
+        const auto plan = PlanTrainingMemory(MakeEstimate(), /*needTreeLevelCaching*/ false, 4000);
+        UNIT_ASSERT(!plan.UseTreeLevelCaching);
+        UNIT_ASSERT_VALUES_EQUAL(plan.MaxOnlineCtrFeatures, 15);
+        UNIT_ASSERT_VALUES_EQUAL(plan.Estimate.GetTotal(), 4000);
+    }
+
+    Y_UNIT_TEST(KeepsAtLeastOneOnlineCtrProjection) {
+        const auto plan = PlanTrainingMemory(MakeEstimate(), /*needTreeLevelCaching*/ false, 2650);
+        UNIT_ASSERT_VALUES_EQUAL(plan.MaxOnlineCtrFeatures, 1);
+        UNIT_ASSERT_VALUES_EQUAL(plan.Estimate.GetTotal(), 2600);
+    }
+
+    Y_UNIT_TEST(FailsIfDoesNotFitAfterReductions) {
+        UNIT_ASSERT_EXCEPTION(
+            PlanTrainingMemory(MakeEstimate(), /*needTreeLevelCaching*/ true, 1000),
+            TCatBoostException);
+    }
+}
@@ -0,0 +1,217 @@
+#include <catboost/private/libs/algo/metrics_subsample.h>
+
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/loggers/catboost_logger_helpers.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+using namespace NCB;
+
+
+static TDataProviderPtr CreateRandomDataProvider(ui32 objectCount, bool hasSignal, TReallyFastRng32* rng) {
+    const ui32 featureCount = 3;
+    TVector<TVector<float>> features(featureCount); // [featureIdx][objectIdx]
+    TVector<float> target(objectCount);
+    for (auto objectIdx : xrange(objectCount)) {
+        for (auto featureIdx : xrange(featureCount)) {
+            features[featureIdx].push_back(rng->GenRandReal2());
+        }
+        target[objectIdx] = (hasSignal ? features[0][objectIdx] : 0.0f) + rng->GenRandReal2();
+    }
+
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.HasTarget = true;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                featureCount,
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<TString>{});
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+            for (auto featureIdx : xrange(featureCount)) {
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(features[featureIdx]))
+                );
+            }
+            visitor->AddTarget(target);
+            visitor->Finish();
+        }
+    );
+}
+
+static TMetricsAndTimeLeftHistory TrainWithMetricSampleRate(const TDataProviders& dataProviders, float metricSampleRate) {
+    NJson::TJsonValue plainFitParams;
+    plainFitParams.InsertValue("random_seed", 0);
+    plainFitParams.InsertValue("iterations", 200);
+    plainFitParams.InsertValue("learning_rate", 0.3);
+    plainFitParams.InsertValue("depth", 4);
+    plainFitParams.InsertValue("loss_function", "RMSE");
+    plainFitParams.InsertValue("custom_metric", "MAE");
+    plainFitParams.InsertValue("od_type", "Iter");
+    plainFitParams.InsertValue("od_wait", 5);
+    plainFitParams.InsertValue("use_best_model", false);
+    plainFitParams.InsertValue("metric_sample_rate", metricSampleRate);
+    // full evaluation is done at the last iteration only
+    plainFitParams.InsertValue("full_metric_period", 0);
+    plainFitParams.InsertValue("train_dir", ".");
+    plainFitParams.InsertValue("thread_count", 1);
+
+    TFullModel model;
+    TEvalResult evalResult;
+    TMetricsAndTimeLeftHistory metricsAndTimeHistory;
+    TrainModel(
+        plainFitParams,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        dataProviders,
+        /*initModel*/ Nothing(),
+        /*initLearnProgress*/ nullptr,
+        "",
+        &model,
+        {&evalResult},
+        &metricsAndTimeHistory
+    );
+    return metricsAndTimeHistory;
+}
+
+Y_UNIT_TEST_SUITE(MetricsSubsample) {
+    Y_UNIT_TEST(StratifiedByTarget) {
+        const ui32 objectCount = 1000;
+        TVector<float> target(objectCount);
+        TVector<float> weights(objectCount);
+        for (auto i : xrange(objectCount)) {
+            target[i] = (i % 10 == 0) ? 1.0f : 0.0f;
+            weights[i] = i;
+        }
+
+        const auto subsample = CreateMetricsSubsample(objectCount, target, weights, {}, 0.25f, 0);
+
+        UNIT_ASSERT_VALUES_EQUAL(subsample.ObjectIndices.size(), 250);
+        UNIT_ASSERT(IsSorted(subsample.ObjectIndices.begin(), subsample.ObjectIndices.end()));
+        ui32 positiveCount = 0;
+        for (auto i : xrange(subsample.ObjectIndices.size())) {
+            const ui32 objectIdx = subsample.ObjectIndices[i];
+            UNIT_ASSERT_VALUES_EQUAL(subsample.Target[i], target[objectIdx]);
+            UNIT_ASSERT_VALUES_EQUAL(subsample.Weights[i], weights[objectIdx]);
+            positiveCount += subsample.Target[i] > 0.5f;
+        }
+        UNIT_ASSERT_VALUES_EQUAL(positiveCount, 25);
+
+        TVector<TVector<double>> approx(1, TVector<double>(objectCount));
+        for (auto i : xrange(objectCount)) {
+            approx[0][i] = 2.0 * i;
+        }
+        NPar::TLocalExecutor localExecutor;
+        TVector<TVector<double>> subsampleApprox;
+        subsample.GatherApprox(approx, &localExecutor, &subsampleApprox);
+        for (auto i : xrange(subsample.ObjectIndices.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(subsampleApprox[0][i], 2.0 * subsample.ObjectIndices[i]);
+        }
+    }
+
+    Y_UNIT_TEST(WholeGroups) {
+        TVector<TQueryInfo> queryInfo;
+        ui32 objectCount = 0;
+        for (auto groupIdx : xrange(50)) {
+            const ui32 groupSize = 1 + groupIdx % 4;
+            queryInfo.emplace_back(objectCount, objectCount + groupSize);
+            objectCount += groupSize;
+        }
+        TVector<float> target(objectCount, 1.0f);
+
+        const auto subsample = CreateMetricsSubsample(objectCount, target, {}, queryInfo, 0.5f, 0);
+
+        UNIT_ASSERT_VALUES_EQUAL(subsample.QueryInfo.size(), 25);
+        UNIT_ASSERT(subsample.Weights.empty());
+        ui32 begin = 0;
+        for (const auto& group : subsample.QueryInfo) {
+            UNIT_ASSERT_VALUES_EQUAL(group.Begin, begin);
+            const ui32 srcBegin = subsample.ObjectIndices[group.Begin];
+            const auto srcGroup = FindIf(queryInfo, [=] (const TQueryInfo& info) { return info.Begin == srcBegin; });
+            UNIT_ASSERT(srcGroup != queryInfo.end());
+            UNIT_ASSERT_VALUES_EQUAL(group.GetSize(), srcGroup->GetSize());
+            begin = group.End;
+        }
+        UNIT_ASSERT_VALUES_EQUAL(begin, subsample.ObjectIndices.size());
+    }
+
+    Y_UNIT_TEST(SubsampledIterations) {
+        // disabled
+        for (auto iter : xrange(10)) {
+            UNIT_ASSERT(!ShouldUseMetricsSubsample(iter, 10, 1.0f, 0));
+            UNIT_ASSERT(!ShouldUseMetricsSubsample(iter, 10, 1.0f, 3));
+        }
+        // full evaluation at the last iteration only
+        for (auto iter : xrange(9)) {
+            UNIT_ASSERT(ShouldUseMetricsSubsample(iter, 10, 0.5f, 0));
+        }
+        UNIT_ASSERT(!ShouldUseMetricsSubsample(9, 10, 0.5f, 0));
+        // full evaluations every 3 iterations and at the last one
+        TVector<ui32> fullIterations;
+        for (auto iter : xrange(11)) {
+            if (!ShouldUseMetricsSubsample(iter, 11, 0.5f, 3)) {
+                fullIterations.push_back(iter);
+            }
+        }
+        UNIT_ASSERT_EQUAL(fullIterations, (TVector<ui32>{0, 3, 6, 9, 10}));
+    }
+
+    Y_UNIT_TEST(FullEvaluationAtStopIteration) {
+        TReallyFastRng32 rng(0);
+        TDataProviders dataProviders;
+        dataProviders.Learn = CreateRandomDataProvider(400, /*hasSignal*/ true, &rng);
+        // eval target is pure noise, so the overfitting detector stops training early
+        dataProviders.Test.push_back(CreateRandomDataProvider(200, /*hasSignal*/ false, &rng));
+
+        const auto history = TrainWithMetricSampleRate(dataProviders, 0.5f);
+        const auto fullHistory = TrainWithMetricSampleRate(dataProviders, 1.0f);
+
+        // metric subsampling doesn't change training and the eval metric
+        const size_t iterationCount = history.TestMetricsHistory.size();
+        UNIT_ASSERT_VALUES_EQUAL(iterationCount, fullHistory.TestMetricsHistory.size());
+        UNIT_ASSERT(iterationCount < 200);
+        UNIT_ASSERT_EQUAL(history.BestIteration, fullHistory.BestIteration);
+        for (auto iter : xrange(iterationCount)) {
+            UNIT_ASSERT_VALUES_EQUAL(
+                history.TestMetricsHistory[iter][0].at("RMSE"),
+                fullHistory.TestMetricsHistory[iter][0].at("RMSE")
+            );
+            UNIT_ASSERT(!fullHistory.IsMetricsSubsampledAt(iter));
+        }
+        UNIT_ASSERT_VALUES_EQUAL(
+            history.TestBestError[0].at("RMSE"),
+            fullHistory.TestBestError[0].at("RMSE")
+        );
+
+        // all iterations but the stop one are subsampled, the stop one is evaluated on the full datasets
+        for (auto iter : xrange(iterationCount - 1)) {
+            UNIT_ASSERT(history.IsMetricsSubsampledAt(iter));
+        }
+        const size_t lastIter = iterationCount - 1;
+        UNIT_ASSERT(!history.IsMetricsSubsampledAt(lastIter));
+        UNIT_ASSERT_VALUES_EQUAL(history.LearnMetricsHistory.size(), iterationCount);
+        for (const TString metric : {"RMSE", "MAE"}) {
+            UNIT_ASSERT_VALUES_EQUAL(
+                history.LearnMetricsHistory[lastIter].at(metric),
+                fullHistory.LearnMetricsHistory[lastIter].at(metric)
+            );
+            // best values are taken from full evaluations only
+            UNIT_ASSERT_VALUES_EQUAL(history.LearnBestError.at(metric), history.LearnMetricsHistory[lastIter].at(metric));
+        }
+        UNIT_ASSERT_VALUES_EQUAL(
+            history.TestMetricsHistory[lastIter][0].at("MAE"),
+            fullHistory.TestMetricsHistory[lastIter][0].at("MAE")
+        );
+        UNIT_ASSERT_VALUES_EQUAL(history.TestBestError[0].at("MAE"), history.TestMetricsHistory[lastIter][0].at("MAE"));
+    }
+}
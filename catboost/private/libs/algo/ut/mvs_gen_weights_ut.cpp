@@ -126,4 +126,47 @@ Y_UNIT_TEST_SUITE(mvs) {
             }
         }
     }
+
+    Y_UNIT_TEST(mvs_GenWeights_sorted_large) {
+        const ui32 BlockSize = 10000;
+        const ui32 SampleCount = CB_THREAD_LIMIT * BlockSize;
+        const float SampleRate = 0.3;
+        TFold ff;
+        ff.SampleWeights.resize(SampleCount, 1);
+
+        const int SampleCountAsInt = SafeIntegerCast<int>(SampleCount);
+
+        TFold::TBodyTail bt(0, 0, SampleCountAsInt, SampleCountAsInt, (double)SampleCountAsInt);
+
+        bt.WeightedDerivatives.resize(1, TVector<double>(SampleCount));
+        bt.Approx.resize(1, TVector<double>(SampleCount));
+
+        // sorted derivatives are the worst case for the first element pivot
+        for (ui32 j = 0; j < CB_THREAD_LIMIT; ++j) {
+            for (ui32 i = 0; i < BlockSize; ++i) {
+                bt.WeightedDerivatives[0][BlockSize * j + i] = (double)(i + 1);
+            }
+        }
+
+        ff.BodyTailArr.emplace_back(std::move(bt));
+
+        const EBoostingType boostingType = Plain;
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+
+        TMvsSampler sampler(SampleCount, SampleRate, 0.0f);
+
+        TRestorableFastRng64 rand(0);
+        sampler.GenSampleWeights(boostingType, {}, &rand, &executor, &ff);
+
+        ui32 sampledCount = 0;
+        for (ui32 i = 0; i < SampleCount; ++i) {
+            const double weight = ff.SampleWeights[i];
+            if (weight != 0) {
+                UNIT_ASSERT(weight > 1.0 - 1e-6);
+                ++sampledCount;
+            }
+        }
+        UNIT_ASSERT_DOUBLES_EQUAL((double)sampledCount / SampleCount, SampleRate, 0.01);
+    }
 }
@@ -0,0 +1,116 @@
+#include <catboost/private/libs/algo/yetirank_helpers.h>
+#include <catboost/private/libs/options/loss_description.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+
+#include <cmath>
+
+
+static TVector<TQueryInfo> GenerateYetiRankPairs(
+    TConstArrayRef<double> approxes,
+    TConstArrayRef<float> relevances,
+    TConstArrayRef<ui32> querySizes,
+    TStringBuf lossDescription,
+    int threadCount
+) {
+    TVector<TQueryInfo> queriesInfo;
+    ui32 begin = 0;
+    for (ui32 querySize : querySizes) {
+        queriesInfo.emplace_back(begin, begin + querySize);
+        begin += querySize;
+    }
+
+    NPar::TLocalExecutor executor;
+    executor.RunAdditionalThreads(threadCount - 1);
+    UpdatePairsForYetiRank(
+        approxes,
+        relevances,
+        NCatboostOptions::ParseLossDescription(lossDescription),
+        /*randomSeed*/ 42,
+        0,
+        queriesInfo.ysize(),
+        &queriesInfo,
+        &executor
+    );
+    return queriesInfo;
+}
+
+Y_UNIT_TEST_SUITE(YetiRankPairs) {
+    Y_UNIT_TEST(PairsForLargeQuery) {
+        const TVector<ui32> querySizes = {1, 3, 5000, 7};
+        ui32 docCount = 0;
+        for (ui32 querySize : querySizes) {
+            docCount += querySize;
+        }
+
+        TFastRng64 rand(0);
+        TVector<double> approxes(docCount);
+        TVector<float> relevances(docCount);
+        for (ui32 docId = 0; docId < docCount; ++docId) {
+            approxes[docId] = std::exp(rand.GenRandReal1() - 0.5);
+            relevances[docId] = rand.Uniform(5);
+        }
+
+        const int permutationCount = 1;
+        const auto queriesInfo = GenerateYetiRankPairs(
+            approxes,
+            relevances,
+            querySizes,
+            "YetiRank:permutations=1;decay=1",
+            4
+        );
+
+        for (const auto& queryInfo : queriesInfo) {
+            const ui32 querySize = queryInfo.End - queryInfo.Begin;
+            UNIT_ASSERT_VALUES_EQUAL(queryInfo.Competitors.size(), querySize);
+
+            // Every pair comes from adjacent docs of a single permutation.
+            ui32 pairCount = 0;
+            for (ui32 winnerId = 0; winnerId < querySize; ++winnerId) {
+                const auto& competitors = queryInfo.Competitors[winnerId];
+                for (ui32 i = 0; i < competitors.size(); ++i) {
+                    const ui32 loserId = competitors[i].Id;
+                    UNIT_ASSERT(loserId < querySize);
+                    if (i > 0) {
+                        UNIT_ASSERT(competitors[i - 1].Id < loserId);
+                    }
+                    const float winnerRelevance = relevances[queryInfo.Begin + winnerId];
+                    const float loserRelevance = relevances[queryInfo.Begin + loserId];
+                    UNIT_ASSERT(winnerRelevance > loserRelevance);
+                    UNIT_ASSERT_DOUBLES_EQUAL(
+                        competitors[i].Weight,
+                        0.15 * (winnerRelevance - loserRelevance) / permutationCount,
+                        1e-6
+                    );
+                }
+                pairCount += competitors.size();
+            }
+            UNIT_ASSERT(pairCount + 1 <= Max<ui32>(querySize, 1));
+        }
+    }
+
+    Y_UNIT_TEST(PairsDoNotDependOnThreadCount) {
+        const TVector<ui32> querySizes = {10, 200, 1, 2000, 30};
+        ui32 docCount = 0;
+        for (ui32 querySize : querySizes) {
+            docCount += querySize;
+        }
+
+        TFastRng64 rand(1);
+        TVector<double> approxes(docCount);
+        TVector<float> relevances(docCount);
+        for (ui32 docId = 0; docId < docCount; ++docId) {
+            approxes[docId] = std::exp(rand.GenRandReal1() - 0.5);
+            relevances[docId] = rand.Uniform(3);
+        }
+
+        const auto singleThreadQueriesInfo = GenerateYetiRankPairs(approxes, relevances, querySizes, "YetiRank", 1);
+        const auto multiThreadQueriesInfo = GenerateYetiRankPairs(approxes, relevances, querySizes, "YetiRank", 8);
+        UNIT_ASSERT(singleThreadQueriesInfo == multiThreadQueriesInfo);
+    }
+}
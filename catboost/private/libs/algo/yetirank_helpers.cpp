@@ -8,8 +8,27 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/vector.h>
 
+#include <numeric>
+#include <tuple>
+
+
+namespace {
+    struct TYetiRankPair {
+        ui32 Winner;
+        ui32 Loser;
+        float Weight;
+    };
+
+    // Reused between queries processed by one thread.
+    struct TYetiRankPairsBuffers {
+        TVector<int> Indices; // [querySize]
+        TVector<double> BootstrappedApprox; // [querySize]
+        TVector<TYetiRankPair> Pairs; // [<= permutationCount * (querySize - 1)]
+    };
+}
 
 static void GenerateYetiRankPairsForQuery(
     const float* relevs,
@@ -19,6 +38,7 @@ static void GenerateYetiRankPairsForQuery(
     int permutationCount,
     double decaySpeed,
     ui64 randomSeed,
+    TYetiRankPairsBuffers* buffers,
     TVector<TVector<TCompetitor>>* competitors
 ) {
     TFastRng64 rand(randomSeed);
@@ -26,15 +46,19 @@ static void GenerateYetiRankPairsForQuery(
     competitorsRef.clear();
     competitorsRef.resize(querySize);
 
-    TVector<int> indices(querySize);
-    TVector<TVector<float>> competitorsWeights(querySize, TVector<float>(querySize));
+    TVector<int>& indices = buffers->Indices;
+    TVector<double>& bootstrappedApprox = buffers->BootstrappedApprox;
+    // Only adjacent docs of every permutation form pairs, so keep them sparse instead of querySize^2 matrix.
+    TVector<TYetiRankPair>& pairs = buffers->Pairs;
+    indices.yresize(querySize);
+    bootstrappedApprox.yresize(querySize);
+    pairs.clear();
     for (int permutationIndex = 0; permutationIndex < permutationCount; ++permutationIndex) {
         std::iota(indices.begin(), indices.end(), 0);
-        TVector<double> bootstrappedApprox(expApproxes, expApproxes + querySize);
         for (ui32 docId = 0; docId < querySize; ++docId) {
             const float uniformValue = rand.GenRandReal1();
             // TODO(nikitxskv): try to experiment with different bootstraps.
-            bootstrappedApprox[docId] *= uniformValue / (1.000001f - uniformValue);
+            bootstrappedApprox[docId] = expApproxes[docId] * (uniformValue / (1.000001f - uniformValue));
         }
 
         Sort(
@@ -53,22 +77,31 @@ static void GenerateYetiRankPairsForQuery(
             const float pairWeight = magicConst * decayCoefficient
                 * Abs(relevs[firstCandidate] - relevs[secondCandidate]);
             if (relevs[firstCandidate] > relevs[secondCandidate]) {
-                competitorsWeights[firstCandidate][secondCandidate] += pairWeight;
+                pairs.push_back({(ui32)firstCandidate, (ui32)secondCandidate, pairWeight});
             } else if (relevs[firstCandidate] < relevs[secondCandidate]) {
-                competitorsWeights[secondCandidate][firstCandidate] += pairWeight;
+                pairs.push_back({(ui32)secondCandidate, (ui32)firstCandidate, pairWeight});
             }
             decayCoefficient *= decaySpeed;
         }
     }
 
-    // TODO(nikitxskv): Can be optimized
-    for (ui32 winnerIndex = 0; winnerIndex < querySize; ++winnerIndex) {
-        for (ui32 loserIndex = 0; loserIndex < querySize; ++loserIndex) {
-            const float competitorsWeight
-                = queryWeight * competitorsWeights[winnerIndex][loserIndex] / permutationCount;
-            if (competitorsWeight != 0) {
-                competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
-            }
+    // Stable sort keeps permutation order of equal pairs, so weights are summed in the same order as before.
+    StableSort(
+        pairs,
+        [](const TYetiRankPair& lhs, const TYetiRankPair& rhs) {
+            return std::tie(lhs.Winner, lhs.Loser) < std::tie(rhs.Winner, rhs.Loser);
+        }
+    );
+    for (size_t pairIdx = 0; pairIdx < pairs.size();) {
+        const ui32 winnerIndex = pairs[pairIdx].Winner;
+        const ui32 loserIndex = pairs[pairIdx].Loser;
+        float competitorsWeightSum = 0;
+        for (; pairIdx < pairs.size() && pairs[pairIdx].Winner == winnerIndex && pairs[pairIdx].Loser == loserIndex; ++pairIdx) {
+            competitorsWeightSum += pairs[pairIdx].Weight;
+        }
+        const float competitorsWeight = queryWeight * competitorsWeightSum / permutationCount;
+        if (competitorsWeight != 0) {
+            competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
         }
     }
 }
@@ -97,6 +130,7 @@ void UpdatePairsForYetiRank(
         blockCount,
         [&](int blockId) {
             TFastRng64 rand(randomSeeds[blockId]);
+            TYetiRankPairsBuffers buffers;
             const int from = queryBegin + blockId * blockSize;
             const int to = Min<int>(queryBegin + (blockId + 1) * blockSize, queryEnd);
             for (int queryIndex = from; queryIndex < to; ++queryIndex) {
@@ -109,6 +143,7 @@ void UpdatePairsForYetiRank(
                     permutationCount,
                     decaySpeed,
                     rand.GenRand(),
+                    &buffers,
                     &queryInfoRef.Competitors
                 );
             }
@@ -78,6 +78,11 @@ void NCB::PrepareFstrModeParamsParser(
             CB_ENSURE(TryFromString<EFstrType>(fstrType, params.FstrType), fstrType + " fstr type is not supported");
         });
 
+    parser.AddLongOption("fstr-full-dataset", "Calculate LossFunctionChange on all documents of the dataset"
+                                              " (by default it is calculated on a dataset subset for big datasets)")
+        .NoArgument()
+        .StoreValue(&params.FstrUseFullDataset, true);
+
     parser.AddLongOption("verbose", "Log writing period")
         .DefaultValue("0")
         .Handler1T<TString>([&params](const TString& verbose) {
@@ -119,7 +124,8 @@ void NCB::ModeFstrSingleHost(const NCB::TAnalyticalModeCommonParams& params) {
                               localExecutor.Get(),
                               &params.OutputPath.Path,
                               nullptr,
-                              params.FstrType);
+                              params.FstrType,
+                              params.FstrUseFullDataset);
             break;
         case EFstrType::InternalFeatureImportance:
             CalcAndOutputFstr(model,
@@ -0,0 +1,243 @@
+#include "compressed_line_data_reader.h"
+
+#include <library/blockcodecs/codecs.h>
+#include <library/blockcodecs/stream.h>
+
+#include <util/generic/cast.h>
+#include <util/stream/buffered.h>
+#include <util/stream/zlib.h>
+#include <util/system/fs.h>
+
+#include <cstring>
+
+
+namespace NCB {
+
+    TParallelBlockCodecsDecodedInput::TParallelBlockCodecsDecodedInput(
+        IInputStream* input,
+        TStringBuf codecNamePrefix,
+        NPar::TLocalExecutor* localExecutor,
+        size_t batchSize
+    )
+        : Input(input)
+        , CodecNamePrefix(codecNamePrefix)
+        , LocalExecutor(localExecutor)
+        , BatchSize(batchSize)
+        , EndOfStream(false)
+        , BatchBlockCount(0)
+        , NextBlockIdx(0)
+    {
+        CB_ENSURE_INTERNAL(BatchSize, "TParallelBlockCodecsDecodedInput: batchSize == 0");
+        CompressedBlocks.resize(BatchSize);
+        BlockCodecs.resize(BatchSize);
+        DecodedBlocks.resize(BatchSize);
+    }
+
+    size_t TParallelBlockCodecsDecodedInput::DoUnboundedNext(const void** ptr) {
+        while (true) {
+            while (NextBlockIdx == BatchBlockCount) {
+                if (!DecodeNextBatch()) {
+                    return 0;
+                }
+            }
+            const TBuffer& block = DecodedBlocks[NextBlockIdx++];
+
+            // skip blocks that are empty after decoding
+            if (!block.Empty()) {
+                *ptr = block.Data();
+                return block.Size();
+            }
+        }
+    }
+
+    bool TParallelBlockCodecsDecodedInput::ReadCompressedBlock(
+        TBuffer* block,
+        const NBlockCodecs::ICodec** codec
+    ) {
+        if (EndOfStream) {
+            return false;
+        }
+        if (!NBlockCodecs::ReadCodedBlock(Input, codec, block)) {
+            EndOfStream = true;
+            return false;
+        }
+        CB_ENSURE(
+            (*codec)->Name().StartsWith(CodecNamePrefix),
+            "Compressed data: expected codec '" << CodecNamePrefix << "*', got '" << (*codec)->Name() << '\''
+        );
+        return true;
+    }
+
+    bool TParallelBlockCodecsDecodedInput::DecodeNextBatch() {
+        BatchBlockCount = 0;
+        NextBlockIdx = 0;
+        while ((BatchBlockCount < BatchSize)
+            && ReadCompressedBlock(&CompressedBlocks[BatchBlockCount], &BlockCodecs[BatchBlockCount]))
+        {
+            ++BatchBlockCount;
+        }
+        if (!BatchBlockCount) {
+            return false;
+        }
+
+        LocalExecutor->ExecRangeWithThrow(
+            [&] (int blockIdx) {
+                NBlockCodecs::DecodeCodedBlock(
+                    BlockCodecs[blockIdx],
+                    CompressedBlocks[blockIdx],
+                    &DecodedBlocks[blockIdx]
+                );
+            },
+            0,
+            SafeIntegerCast<int>(BatchBlockCount),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+        return true;
+    }
+
+
+    TCompressedFileLineDataReader::TDecodedFile::TDecodedFile(
+        const TPathWithScheme& pathWithScheme,
+        NPar::TLocalExecutor* localExecutor
+    )
+        : FileInput(pathWithScheme.Path)
+    {
+        // scheme can have a dataset format prefix like 'libsvm-zstd'
+        const TStringBuf compressionScheme = TStringBuf(pathWithScheme.Scheme).RAfter('-');
+        if (compressionScheme == "gz") {
+            DecodedInput = MakeHolder<TZLibDecompress>(&FileInput);
+            BufferedInput = MakeHolder<TBufferedInput>(DecodedInput.Get());
+        } else {
+            const TStringBuf codecNamePrefix
+                = (compressionScheme == "blockcodecs") ? TStringBuf() : compressionScheme;
+            DecodedInput = MakeHolder<TParallelBlockCodecsDecodedInput>(
+                &FileInput,
+                codecNamePrefix,
+                localExecutor,
+                /*batchSize*/ localExecutor->GetThreadCount() + 1
+            );
+        }
+    }
+
+
+    TCompressedFileLineDataReader::TCompressedFileLineDataReader(
+        const TLineDataReaderArgs& args,
+        size_t maxCachedDecodedSize
+    )
+        : Args(args)
+        , MaxCachedDecodedSize(maxCachedDecodedSize)
+        , LinesRead(0)
+        , HeaderProcessed(!Args.Format.HasHeader)
+    {
+        CB_ENSURE(
+            NFs::Exists(Args.PathWithScheme.Path),
+            "pool file '" << Args.PathWithScheme.Path << "' is not found"
+        );
+        if (Args.ThreadCount > 1) {
+            LocalExecutor.RunAdditionalThreads(Args.ThreadCount - 1);
+        }
+        DecodedFile = MakeHolder<TDecodedFile>(Args.PathWithScheme, &LocalExecutor);
+    }
+
+    ui64 TCompressedFileLineDataReader::GetDataLineCount() {
+        if (!LineCount) {
+            LineCount = LinesRead + CountRemainingLines();
+        }
+        ui64 nLines = *LineCount;
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(nLines, "TCompressedFileLineDataReader: no header in file");
+            --nLines;
+        }
+        return nLines;
+    }
+
+    ui64 TCompressedFileLineDataReader::CountRemainingLines() {
+        IInputStream* input = GetInput();
+
+        TBuffer decodedData;
+        bool fitsInCache = true;
+
+        TBuffer buffer(1 << 20);
+        ui64 nLines = 0;
+        bool lastLineNotFinished = false;
+        while (size_t readSize = input->Read(buffer.Data(), buffer.Capacity())) {
+            const char* const end = buffer.Data() + readSize;
+            for (const char* ptr = buffer.Data();
+                 (ptr = (const char*)memchr(ptr, '\n', end - ptr));
+                 ++ptr)
+            {
+                ++nLines;
+            }
+            lastLineNotFinished = (*(end - 1) != '\n');
+
+            if (fitsInCache) {
+                if (decodedData.Size() + readSize <= MaxCachedDecodedSize) {
+                    decodedData.Append(buffer.Data(), readSize);
+                } else {
+                    fitsInCache = false;
+                    decodedData.Reset();
+                }
+            }
+        }
+        if (lastLineNotFinished) {
+            ++nLines;
+        }
+
+        if (fitsInCache) {
+            CachedDecodedData = std::move(decodedData);
+            CachedDecodedInput = MakeHolder<TMemoryInput>(CachedDecodedData.Data(), CachedDecodedData.Size());
+            DecodedFile.Destroy();
+        } else {
+            // decode the file once more and skip the lines that have already been read
+            DecodedFile = MakeHolder<TDecodedFile>(Args.PathWithScheme, &LocalExecutor);
+            TString line;
+            for (ui64 lineIdx = 0; lineIdx < LinesRead; ++lineIdx) {
+                CB_ENSURE(
+                    DecodedFile->GetInput()->ReadLine(line),
+                    "TCompressedFileLineDataReader: file has changed during reading"
+                );
+            }
+        }
+        return nLines;
+    }
+
+    bool TCompressedFileLineDataReader::ReadLineImpl(TString* line) {
+        if (!GetInput()->ReadLine(*line)) {
+            return false;
+        }
+        ++LinesRead;
+        return true;
+    }
+
+    TMaybe<TString> TCompressedFileLineDataReader::GetHeader() {
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(!HeaderProcessed, "TCompressedFileLineDataReader: multiple calls to GetHeader");
+            TString header;
+            CB_ENSURE(ReadLineImpl(&header), "TCompressedFileLineDataReader: no header in file");
+            HeaderProcessed = true;
+            return header;
+        }
+
+        return {};
+    }
+
+    bool TCompressedFileLineDataReader::ReadLine(TString* line) {
+        // skip header if it hasn't been read
+        if (!HeaderProcessed) {
+            GetHeader();
+        }
+        return ReadLineImpl(line);
+    }
+
+
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> GZipLineDataReaderReg("gz");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> BlockCodecsLineDataReaderReg("blockcodecs");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> ZstdLineDataReaderReg("zstd");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> Lz4LineDataReaderReg("lz4");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> LibSvmGZipLineDataReaderReg("libsvm-gz");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> LibSvmBlockCodecsLineDataReaderReg(
+        "libsvm-blockcodecs"
+    );
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> LibSvmZstdLineDataReaderReg("libsvm-zstd");
+    TLineDataReaderFactory::TRegistrator<TCompressedFileLineDataReader> LibSvmLz4LineDataReaderReg("libsvm-lz4");
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "line_data_reader.h"
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/buffer.h>
+#include <util/generic/maybe.h>
+#include <util/generic/ptr.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+#include <util/stream/input.h>
+#include <util/stream/mem.h>
+#include <util/stream/walk.h>
+
+
+namespace NBlockCodecs {
+    struct ICodec;
+}
+
+
+namespace NCB {
+
+    /* Decodes a stream produced by NBlockCodecs::TCodedOutput (see library/blockcodecs).
+     * Unlike NBlockCodecs::TDecodedInput compressed blocks are read in batches and
+     * decompressed in parallel, decompressed data is returned in the original order.
+     */
+    class TParallelBlockCodecsDecodedInput : public IWalkInput {
+    public:
+        /* codecNamePrefix - if not empty, each block's codec name must start with it
+         * batchSize - number of compressed blocks decompressed in parallel
+         */
+        TParallelBlockCodecsDecodedInput(
+            IInputStream* input,
+            TStringBuf codecNamePrefix,
+            NPar::TLocalExecutor* localExecutor,
+            size_t batchSize
+        );
+
+    private:
+        size_t DoUnboundedNext(const void** ptr) override;
+
+        // returns false if there are no more blocks
+        bool ReadCompressedBlock(TBuffer* block, const NBlockCodecs::ICodec** codec);
+
+        // returns false if there are no more blocks
+        bool DecodeNextBatch();
+
+    private:
+        IInputStream* Input;
+        TString CodecNamePrefix;
+        NPar::TLocalExecutor* LocalExecutor;
+        size_t BatchSize;
+        bool EndOfStream;
+
+        TVector<TBuffer> CompressedBlocks;
+        TVector<const NBlockCodecs::ICodec*> BlockCodecs;
+        TVector<TBuffer> DecodedBlocks;
+        size_t BatchBlockCount;
+        size_t NextBlockIdx;
+    };
+
+
+    /* Reads lines from compressed files without decompressing them to disk first.
+     *  Supported schemes:
+     *  'gz://' - gzip or zlib compressed file,
+     *  'blockcodecs://' - file written by NBlockCodecs::TCodedOutput with any codec,
+     *  'zstd://', 'lz4://' - same as 'blockcodecs://' but the codec family is checked.
+     *  'libsvm-' prefixed variants of the schemes above select libsvm dataset format.
+     *  Blockcodecs streams are decompressed by blocks in parallel using args.ThreadCount threads.
+     */
+    class TCompressedFileLineDataReader : public ILineDataReader {
+    public:
+        static constexpr size_t DEFAULT_MAX_CACHED_DECODED_SIZE = 512 * 1024 * 1024;
+
+    public:
+        /* maxCachedDecodedSize - GetDataLineCount keeps the decoded rest of the file in memory
+         *  if it is not bigger than this size, so the file is decompressed only once.
+         *  Otherwise the file has to be decompressed once more for ReadLine.
+         */
+        TCompressedFileLineDataReader(
+            const TLineDataReaderArgs& args,
+            size_t maxCachedDecodedSize = DEFAULT_MAX_CACHED_DECODED_SIZE
+        );
+
+        // decodes the rest of the file to count lines
+        ui64 GetDataLineCount() override;
+
+        TMaybe<TString> GetHeader() override;
+
+        bool ReadLine(TString* line) override;
+
+    private:
+        struct TDecodedFile {
+            TIFStream FileInput;
+            THolder<IInputStream> DecodedInput;
+            THolder<IInputStream> BufferedInput; // can be empty if DecodedInput is zero-copy
+
+        public:
+            TDecodedFile(const TPathWithScheme& pathWithScheme, NPar::TLocalExecutor* localExecutor);
+
+            IInputStream* GetInput() {
+                return BufferedInput ? BufferedInput.Get() : DecodedInput.Get();
+            }
+        };
+
+    private:
+        IInputStream* GetInput() {
+            return CachedDecodedInput ? CachedDecodedInput.Get() : DecodedFile->GetInput();
+        }
+
+        bool ReadLineImpl(TString* line);
+
+        // also caches the decoded rest of the file if it fits into MaxCachedDecodedSize
+        ui64 CountRemainingLines();
+
+    private:
+        TLineDataReaderArgs Args;
+        size_t MaxCachedDecodedSize;
+        NPar::TLocalExecutor LocalExecutor;
+        THolder<TDecodedFile> DecodedFile;
+
+        TBuffer CachedDecodedData;
+        THolder<TMemoryInput> CachedDecodedInput;
+
+        ui64 LinesRead; // including header
+        TMaybe<ui64> LineCount; // including header, calculated in GetDataLineCount
+        bool HeaderProcessed;
+    };
+
+}
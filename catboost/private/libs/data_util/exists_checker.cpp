@@ -17,6 +17,11 @@ namespace NCB {
     TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSExistsCheckerReg("");
     TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSFileExistsCheckerReg("file");
     TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSDsvExistsCheckerReg("dsv");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSMappedFileExistsCheckerReg("mmap");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSGZipExistsCheckerReg("gz");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSBlockCodecsExistsCheckerReg("blockcodecs");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSZstdExistsCheckerReg("zstd");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSLz4ExistsCheckerReg("lz4");
 
     }
 }
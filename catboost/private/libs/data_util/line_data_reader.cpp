@@ -1,15 +1,19 @@
 #include "line_data_reader.h"
 
+#include <util/generic/strbuf.h>
 #include <util/system/fs.h>
 
+#include <cstring>
+
 
 namespace NCB {
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format)
+                                               const TDsvFormatOptions& format,
+                                               int threadCount)
     {
         return GetProcessor<ILineDataReader, TLineDataReaderArgs>(
-            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format}
+            pathWithScheme, TLineDataReaderArgs{pathWithScheme, format, threadCount}
         );
     }
 
@@ -24,7 +28,87 @@ namespace NCB {
         return count;
     }
 
+    TMappedFileLineDataReader::TMappedFileLineDataReader(const TLineDataReaderArgs& args)
+        : Args(args)
+        , Position(0)
+        , HeaderProcessed(!Args.Format.HasHeader)
+    {
+        CB_ENSURE(
+            NFs::Exists(Args.PathWithScheme.Path),
+            "pool file '" << Args.PathWithScheme.Path << "' is not found"
+        );
+        Data = TBlob::FromFile(Args.PathWithScheme.Path);
+    }
+
+    ui64 TMappedFileLineDataReader::GetDataLineCount() {
+        const char* const begin = Data.AsCharPtr();
+        const char* const end = begin + Data.Size();
+
+        ui64 nLines = 0;
+        for (const char* ptr = begin; ptr < end; ++nLines) {
+            const char* lineEnd = (const char*)memchr(ptr, '\n', end - ptr);
+            if (!lineEnd) {
+                ++nLines; // last line without trailing newline
+                break;
+            }
+            ptr = lineEnd + 1;
+        }
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(nLines, "TMappedFileLineDataReader: no header in file");
+            --nLines;
+        }
+        return nLines;
+    }
+
+    TMaybe<TString> TMappedFileLineDataReader::GetHeader() {
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(!HeaderProcessed, "TMappedFileLineDataReader: multiple calls to GetHeader");
+            TStringBuf header;
+            CB_ENSURE(NextLine(&header), "TMappedFileLineDataReader: no header in file");
+            HeaderProcessed = true;
+            return TString(header);
+        }
+
+        return {};
+    }
+
+    bool TMappedFileLineDataReader::ReadLine(TString* line) {
+        // skip header if it hasn't been read
+        if (!HeaderProcessed) {
+            GetHeader();
+        }
+        TStringBuf lineBuf;
+        if (!NextLine(&lineBuf)) {
+            return false;
+        }
+        line->assign(lineBuf.data(), lineBuf.size());
+        return true;
+    }
+
+    bool TMappedFileLineDataReader::NextLine(TStringBuf* line) {
+        const size_t size = Data.Size();
+        if (Position >= size) {
+            return false;
+        }
+        const char* const lineBegin = Data.AsCharPtr() + Position;
+        const char* lineEnd = (const char*)memchr(lineBegin, '\n', size - Position);
+        if (lineEnd) {
+            Position = lineEnd - Data.AsCharPtr() + 1;
+        } else {
+            lineEnd = Data.AsCharPtr() + size;
+            Position = size;
+        }
+        // same semantics as IInputStream::ReadLine: strip '\r' before '\n'
+        if ((lineEnd != lineBegin) && (*(lineEnd - 1) == '\r')) {
+            --lineEnd;
+        }
+        *line = TStringBuf(lineBegin, lineEnd);
+        return true;
+    }
+
+
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DefLineDataReaderReg("");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> FileLineDataReaderReg("file");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DsvLineDataReaderReg("dsv");
+    TLineDataReaderFactory::TRegistrator<TMappedFileLineDataReader> MappedFileLineDataReaderReg("mmap");
 }
@@ -8,6 +8,7 @@
 
 #include <util/generic/maybe.h>
 #include <util/generic/string.h>
+#include <util/memory/blob.h>
 
 #include <util/stream/file.h>
 
@@ -23,6 +24,7 @@ namespace NCB {
     struct TLineDataReaderArgs {
         TPathWithScheme PathWithScheme;
         TDsvFormatOptions Format;
+        int ThreadCount = 1; // can be used by readers that decode data in parallel
     };
 
 
@@ -49,7 +51,8 @@ namespace NCB {
         NObjectFactory::TParametrizedObjectFactory<ILineDataReader, TString, TLineDataReaderArgs>;
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format = {});
+                                               const TDsvFormatOptions& format = {},
+                                               int threadCount = 1);
 
 
     int CountLines(const TString& poolFile);
@@ -96,4 +99,31 @@ namespace NCB {
         bool HeaderProcessed;
     };
 
+
+    /* Reads lines directly from the memory-mapped file:
+     *  no per-line stream buffering, lines are located with memchr
+     *  and line count is obtained with a single pass over mapped memory.
+     *  Use 'mmap://' scheme to select it.
+     */
+    class TMappedFileLineDataReader : public ILineDataReader {
+    public:
+        TMappedFileLineDataReader(const TLineDataReaderArgs& args);
+
+        ui64 GetDataLineCount() override;
+
+        TMaybe<TString> GetHeader() override;
+
+        bool ReadLine(TString* line) override;
+
+    private:
+        // returns false if the end of data has been reached
+        bool NextLine(TStringBuf* line);
+
+    private:
+        TLineDataReaderArgs Args;
+        TBlob Data;
+        size_t Position;
+        bool HeaderProcessed;
+    };
+
 }
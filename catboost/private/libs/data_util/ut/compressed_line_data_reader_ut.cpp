@@ -0,0 +1,149 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/private/libs/data_util/compressed_line_data_reader.h>
+#include <catboost/private/libs/data_util/line_data_reader.h>
+
+#include <library/blockcodecs/codecs.h>
+#include <library/blockcodecs/stream.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+#include <util/stream/zlib.h>
+#include <util/string/builder.h>
+#include <util/string/split.h>
+#include <util/system/tempfile.h>
+
+
+using namespace NCB;
+
+
+static TString MakeTestData(size_t lineCount) {
+    TStringBuilder data;
+    data << "Label\tF0\tF1\n";
+    for (size_t i = 0; i < lineCount; ++i) {
+        data << (i % 2) << '\t' << i * 0.5 << '\t' << "cat" << (i % 7) << '\n';
+    }
+    return data;
+}
+
+static TVector<TString> ReadAllLines(ILineDataReader* reader) {
+    TVector<TString> lines;
+    TString line;
+    while (reader->ReadLine(&line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static void CheckReader(const TString& plainFileName, const TPathWithScheme& compressedPath) {
+    for (bool hasHeader : {false, true}) {
+        TDsvFormatOptions format;
+        format.HasHeader = hasHeader;
+
+        auto expectedReader = GetLineDataReader(TPathWithScheme(plainFileName), format);
+        auto reader = GetLineDataReader(compressedPath, format, /*threadCount*/ 4);
+
+        UNIT_ASSERT_VALUES_EQUAL(expectedReader->GetDataLineCount(), reader->GetDataLineCount());
+        UNIT_ASSERT_EQUAL(expectedReader->GetHeader(), reader->GetHeader());
+        UNIT_ASSERT_EQUAL(ReadAllLines(expectedReader.Get()), ReadAllLines(reader.Get()));
+    }
+}
+
+
+Y_UNIT_TEST_SUITE(TCompressedFileLineDataReaderTest) {
+    Y_UNIT_TEST(TestBlockCodecs) {
+        const TString data = MakeTestData(10000);
+
+        TTempFile plainFile(MakeTempName());
+        TOFStream(plainFile.Name()).Write(data);
+
+        for (auto codecName : {"zstd08_1", "lz4-fast14-safe"}) {
+            TTempFile compressedFile(MakeTempName());
+            {
+                TOFStream out(compressedFile.Name());
+                // small blocks to have lines split between several blocks
+                NBlockCodecs::TCodedOutput codedOutput(&out, NBlockCodecs::Codec(codecName), 1000);
+                codedOutput.Write(data);
+                codedOutput.Finish();
+            }
+            const TString scheme = TString(TStringBuf(codecName).Before('-').Before('0'));
+            CheckReader(plainFile.Name(), TPathWithScheme(scheme + "://" + compressedFile.Name()));
+            CheckReader(plainFile.Name(), TPathWithScheme("blockcodecs://" + compressedFile.Name()));
+        }
+    }
+
+    Y_UNIT_TEST(TestGZip) {
+        const TString data = MakeTestData(10000);
+
+        TTempFile plainFile(MakeTempName());
+        TOFStream(plainFile.Name()).Write(data);
+
+        TTempFile compressedFile(MakeTempName());
+        {
+            TOFStream out(compressedFile.Name());
+            TZLibCompress compressedOutput(&out, ZLib::GZip);
+            compressedOutput.Write(data);
+            compressedOutput.Finish();
+        }
+        CheckReader(plainFile.Name(), TPathWithScheme("gz://" + compressedFile.Name()));
+    }
+
+    Y_UNIT_TEST(TestLineCountAfterRead) {
+        const TString data = MakeTestData(10000);
+        const auto expectedLines = StringSplitter(data).Split('\n').SkipEmpty().ToList<TString>();
+
+        TTempFile compressedFile(MakeTempName());
+        {
+            TOFStream out(compressedFile.Name());
+            NBlockCodecs::TCodedOutput codedOutput(&out, NBlockCodecs::Codec("zstd08_1"), 1000);
+            codedOutput.Write(data);
+            codedOutput.Finish();
+        }
+
+        // decoded data is cached, not cached at all or doesn't fit into cache
+        for (size_t maxCachedDecodedSize : {TCompressedFileLineDataReader::DEFAULT_MAX_CACHED_DECODED_SIZE, size_t(0), size_t(5000)}) {
+            for (int threadCount : {1, 4}) {
+                TDsvFormatOptions format;
+                format.HasHeader = true;
+                TCompressedFileLineDataReader reader(
+                    TLineDataReaderArgs{TPathWithScheme("zstd://" + compressedFile.Name()), format, threadCount},
+                    maxCachedDecodedSize
+                );
+
+                UNIT_ASSERT_VALUES_EQUAL(*reader.GetHeader(), expectedLines[0]);
+
+                TVector<TString> lines;
+                TString line;
+                for (int i = 0; i < 3; ++i) {
+                    UNIT_ASSERT(reader.ReadLine(&line));
+                    lines.push_back(line);
+                }
+
+                UNIT_ASSERT_VALUES_EQUAL(reader.GetDataLineCount(), expectedLines.size() - 1);
+                UNIT_ASSERT_VALUES_EQUAL(reader.GetDataLineCount(), expectedLines.size() - 1);
+
+                while (reader.ReadLine(&line)) {
+                    lines.push_back(line);
+                }
+                UNIT_ASSERT_EQUAL(
+                    lines,
+                    TVector<TString>(expectedLines.begin() + 1, expectedLines.end())
+                );
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestCodecMismatch) {
+        TTempFile compressedFile(MakeTempName());
+        {
+            TOFStream out(compressedFile.Name());
+            NBlockCodecs::TCodedOutput codedOutput(&out, NBlockCodecs::Codec("lz4-fast14-safe"), 1000);
+            codedOutput.Write(MakeTestData(10));
+            codedOutput.Finish();
+        }
+        auto reader = GetLineDataReader(TPathWithScheme("zstd://" + compressedFile.Name()));
+        TString line;
+        UNIT_ASSERT_EXCEPTION(reader->ReadLine(&line), TCatBoostException);
+    }
+}
@@ -0,0 +1,50 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/private/libs/data_util/line_data_reader.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+#include <util/system/tempfile.h>
+
+
+using namespace NCB;
+
+
+static TVector<TString> ReadAllLines(ILineDataReader* reader) {
+    TVector<TString> lines;
+    TString line;
+    while (reader->ReadLine(&line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+
+Y_UNIT_TEST_SUITE(TLineDataReaderTest) {
+    Y_UNIT_TEST(TestMappedFileLineDataReader) {
+        const TVector<TString> fileContents = {
+            "a\tb\n0.1\t2\n0.3\t4\n",
+            "a\tb\r\n0.1\t2\r\n0.3\t4",
+            "a\tb\n\n0.3\t4\n",
+        };
+
+        for (const auto& fileContent : fileContents) {
+            TTempFile srcFile(MakeTempName());
+            TOFStream(srcFile.Name()).Write(fileContent);
+
+            for (bool hasHeader : {false, true}) {
+                TLineDataReaderArgs args;
+                args.PathWithScheme = TPathWithScheme("file://" + srcFile.Name());
+                args.Format.HasHeader = hasHeader;
+
+                TFileLineDataReader expectedReader(args);
+                auto reader = GetLineDataReader(TPathWithScheme("mmap://" + srcFile.Name()), args.Format);
+
+                UNIT_ASSERT_VALUES_EQUAL(expectedReader.GetDataLineCount(), reader->GetDataLineCount());
+                UNIT_ASSERT_EQUAL(expectedReader.GetHeader(), reader->GetHeader());
+                UNIT_ASSERT_EQUAL(ReadAllLines(&expectedReader), ReadAllLines(reader.Get()));
+            }
+        }
+    }
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <catboost/private/libs/algo/calc_score_cache.h>
+#include <catboost/private/libs/algo/ctr_helper.h>
 #include <catboost/private/libs/algo/fold.h>
 #include <catboost/private/libs/algo/learn_context.h>
+#include <catboost/private/libs/algo/online_ctr.h>
 #include <catboost/private/libs/algo/pairwise_scoring.h>
 #include <catboost/private/libs/algo/score_calcers.h>
 #include <catboost/private/libs/algo/target_classifier.h>
@@ -80,7 +82,8 @@ namespace NCatboostDistributed {
     };
 
     struct TPlainFoldBuilderParams {
-        TVector<TTargetClassifier> TargetClassifiers;
+        TCtrHelper CtrsHelper;
+        bool LearnAndTestDataPackingAreCompatible;
         ui64 RandomSeed;
         int ApproxDimension;
         TString TrainParams;
@@ -92,7 +95,8 @@ namespace NCatboostDistributed {
         TPlainFoldBuilderParams() = default;
 
         SAVELOAD(
-            TargetClassifiers,
+            CtrsHelper,
+            LearnAndTestDataPackingAreCompatible,
             RandomSeed,
             ApproxDimension,
             TrainParams,
@@ -101,6 +105,23 @@ namespace NCatboostDistributed {
             HessianType);
     };
 
+    // counters of projection values on the worker's part of learn data
+    struct TOnlineCtrWorkerStats {
+        int HostId = 0;
+        TVector<TOnlineCtrPartStats> Stats; // [projectionIdx]
+
+    public:
+        SAVELOAD(HostId, Stats);
+    };
+
+    struct TOnlineCtrStarts {
+        TVector<TProjection> Projections;
+        TVector<TVector<TOnlineCtrPartStart>> PartStarts; // [workerIdx][projectionIdx]
+
+    public:
+        SAVELOAD(Projections, PartStarts);
+    };
+
     struct TDatasetLoaderParams {
         NCatboostOptions::TPoolLoadParams PoolLoadOptions;
         TString TrainOptions;
@@ -146,6 +167,8 @@ namespace NCatboostDistributed {
         EHessianType HessianType = EHessianType::Symmetric;
 
         NCatboostOptions::TCatBoostOptions Params;
+        TCtrHelper CtrsHelper;
+        bool LearnAndTestDataPackingAreCompatible = true;
 
         NCB::TTrainingForCPUDataProviderPtr TrainData;
         TVector<TString> ClassNamesFromDataset;
@@ -175,7 +175,7 @@ namespace NCatboostDistributed {
             /*initRand*/ localData.Rand.Get(),
             foldsCreationParams,
             /*datasetsCanContainBaseline*/ true,
-            params->Data.TargetClassifiers,
+            params->Data.CtrsHelper.GetTargetClassifiers(),
             /*featuresCheckSum*/ 0, // unused in case of localData
             /*foldCreationParamsCheckSum*/ 0,
             ParseMemorySizeDescription(trainParams.SystemOptions->CpuUsedRamLimit.Get()),
@@ -185,6 +185,8 @@ namespace NCatboostDistributed {
         Y_ASSERT(localData.Progress->AveragingFold.BodyTailArr.ysize() == 1);
 
         localData.HessianType = params->Data.HessianType;
+        localData.CtrsHelper = params->Data.CtrsHelper;
+        localData.LearnAndTestDataPackingAreCompatible = params->Data.LearnAndTestDataPackingAreCompatible;
 
         localData.StoreExpApprox = foldsCreationParams.StoreExpApproxes;
 
@@ -228,7 +230,6 @@ namespace NCatboostDistributed {
         TOutput* /*unused*/
     ) const {
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
-        Y_ASSERT(!GetTrainData(trainData)->MetaInfo.FeaturesLayout->GetCatFeatureCount());
 
         auto& localData = TLocalTensorSearchData::GetRef();
         Y_ASSERT(IsPlainMode(localData.Params.BoostingOptions->BoostingType));
@@ -267,10 +268,11 @@ namespace NCatboostDistributed {
     void TTensorSearchStarter::DoMap(
         NPar::IUserContext* /*ctx*/,
         int /*hostId*/,
-        TInput* /*unused*/,
+        TInput* keptProjections,
         TOutput* /*unused*/
     ) const {
         auto& localData = TLocalTensorSearchData::GetRef();
+        localData.Progress->AveragingFold.DropCTRsExcept(*keptProjections);
         localData.Depth = 0;
         Fill(localData.Indices.begin(), localData.Indices.end(), 0);
         if (localData.UseTreeLevelCaching) {
@@ -511,13 +513,60 @@ namespace NCatboostDistributed {
         MapVector(getScores, *bucketStats, scores);
     }
 
+    void TOnlineCtrStatsCalcer::DoMap(
+        NPar::IUserContext* ctx,
+        int hostId,
+        TInput* projections,
+        TOutput* workerStats
+    ) const {
+        NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
+        const auto& localData = TLocalTensorSearchData::GetRef();
+        workerStats->HostId = hostId;
+        workerStats->Stats.resize(projections->size());
+        for (auto projectionIdx : xrange(projections->size())) {
+            CalcOnlineCtrPartStats(
+                *GetTrainData(trainData),
+                localData.Progress->AveragingFold,
+                (*projections)[projectionIdx],
+                localData.CtrsHelper,
+                localData.LearnAndTestDataPackingAreCompatible,
+                &NPar::LocalExecutor(),
+                &workerStats->Stats[projectionIdx]);
+        }
+    }
+
+    void TOnlineCtrCalcer::DoMap(
+        NPar::IUserContext* ctx,
+        int hostId,
+        TInput* ctrStarts,
+        TOutput* /*unused*/
+    ) const {
+        NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
+        auto& localData = TLocalTensorSearchData::GetRef();
+        auto& plainFold = localData.Progress->AveragingFold;
+        const auto& projections = ctrStarts->Projections;
+        const auto& partStarts = ctrStarts->PartStarts[hostId];
+        Y_ASSERT(partStarts.size() == projections.size());
+        for (auto projectionIdx : xrange(projections.size())) {
+            const auto& proj = projections[projectionIdx];
+            ComputeOnlineCTRsOnPart(
+                *GetTrainData(trainData),
+                plainFold,
+                proj,
+                localData.CtrsHelper,
+                partStarts[projectionIdx],
+                localData.LearnAndTestDataPackingAreCompatible,
+                &NPar::LocalExecutor(),
+                &plainFold.GetCtrRef(proj));
+        }
+    }
+
     void TLeafIndexSetter::DoMap(
         NPar::IUserContext* ctx,
         int hostId,
         TInput* bestSplit,
         TOutput* /*unused*/
     ) const {
-        Y_ASSERT(bestSplit->Data.Type != ESplitType::OnlineCtr);
         auto& localData = TLocalTensorSearchData::GetRef();
         NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
         SetPermutedIndices(
@@ -825,3 +874,5 @@ REGISTER_SAVELOAD_NM_CLASS(0xd66d4d6, NCatboostDistributed, TApproxReconstructor
 REGISTER_SAVELOAD_NM_CLASS(0xd66d4e0, NCatboostDistributed, TLeafWeightsGetter);
 
 REGISTER_SAVELOAD_NM_CLASS(0xd66d4e1, NCatboostDistributed, TDatasetLoader);
+REGISTER_SAVELOAD_NM_CLASS(0xd66d4e2, NCatboostDistributed, TOnlineCtrStatsCalcer);
+REGISTER_SAVELOAD_NM_CLASS(0xd66d4e3, NCatboostDistributed, TOnlineCtrCalcer);
@@ -28,12 +28,13 @@ namespace NCatboostDistributed {
         OBJECT_NOCOPY_METHODS(TApproxReconstructor);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* forest, TOutput* /*unused*/) const final;
     };
-    class TTensorSearchStarter: public NPar::TMapReduceCmd<TUnusedInitializedParam, TUnusedInitializedParam> {
+    // input is the list of online ctr projections kept by master, workers drop the others
+    class TTensorSearchStarter: public NPar::TMapReduceCmd<TVector<TProjection>, TUnusedInitializedParam> {
         OBJECT_NOCOPY_METHODS(TTensorSearchStarter);
         void DoMap(
             NPar::IUserContext* /*ctx*/,
             int /*hostId*/,
-            TInput* /*unused*/,
+            TInput* keptProjections,
             TOutput* /*unused*/) const final;
     };
     class TBootstrapMaker: public NPar::TMapReduceCmd<TUnusedInitializedParam, TUnusedInitializedParam> {
@@ -88,6 +89,14 @@ namespace NCatboostDistributed {
         OBJECT_NOCOPY_METHODS(TRemoteScoreCalcer);
         void DoMap(NPar::IUserContext* ctx, int hostId, TInput* bucketStats, TOutput* scores) const final;
     };
+    class TOnlineCtrStatsCalcer: public NPar::TMapReduceCmd<TVector<TProjection>, TOnlineCtrWorkerStats> {
+        OBJECT_NOCOPY_METHODS(TOnlineCtrStatsCalcer);
+        void DoMap(NPar::IUserContext* ctx, int hostId, TInput* projections, TOutput* workerStats) const final;
+    };
+    class TOnlineCtrCalcer: public NPar::TMapReduceCmd<TOnlineCtrStarts, TUnusedInitializedParam> {
+        OBJECT_NOCOPY_METHODS(TOnlineCtrCalcer);
+        void DoMap(NPar::IUserContext* ctx, int hostId, TInput* ctrStarts, TOutput* /*unused*/) const final;
+    };
     class TLeafIndexSetter: public NPar::TMapReduceCmd<TEnvelope<TSplit>, TUnusedInitializedParam> {
         OBJECT_NOCOPY_METHODS(TLeafIndexSetter);
         void DoMap(
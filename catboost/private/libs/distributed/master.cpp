@@ -127,7 +127,8 @@ void MapBuildPlainFold(TLearnContext* ctx) {
         workerCount,
         TMasterEnvironment::GetRef().SharedTrainData,
         MakeEnvelope(TPlainFoldBuilderParams({
-            ctx->CtrsHelper.GetTargetClassifiers(),
+            ctx->CtrsHelper,
+            ctx->LearnAndTestDataPackingAreCompatible,
             ctx->LearnProgress->Rand.GenRand(),
             ctx->LearnProgress->ApproxDimension,
             ToString(jsonParams),
@@ -146,9 +147,21 @@ void MapRestoreApproxFromTreeStruct(TLearnContext* ctx) {
         MakeEnvelope(std::make_pair(ctx->LearnProgress->TreeStruct, ctx->LearnProgress->LeafValues)));
 }
 
-void MapTensorSearchStart(TLearnContext* ctx) {
+void MapTensorSearchStart(const TFold& fold, TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
-    ApplyMapper<TTensorSearchStarter>(TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount(), TMasterEnvironment::GetRef().SharedTrainData);
+    TVector<TProjection> keptProjections;
+    const auto& [singleCtrs, ctrs] = fold.GetAllCtrs();
+    for (const auto* projCtrs : {&singleCtrs, &ctrs}) {
+        for (const auto& [proj, ctr] : *projCtrs) {
+            if (!ctr.Feature.empty()) {
+                keptProjections.push_back(proj);
+            }
+        }
+    }
+    ApplyMapper<TTensorSearchStarter>(
+        TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount(),
+        TMasterEnvironment::GetRef().SharedTrainData,
+        keptProjections);
 }
 
 void MapBootstrap(TLearnContext* ctx) {
@@ -282,6 +295,52 @@ void MapSetIndices(const TSplit& bestSplit, TLearnContext* ctx) {
     ApplyMapper<TLeafIndexSetter>(workerCount, TMasterEnvironment::GetRef().SharedTrainData, MakeEnvelope(bestSplit));
 }
 
+void MapCalcOnlineCtrs(
+    const NCB::TTrainingForCPUDataProviders& data,
+    const TVector<TProjection>& projections,
+    TFold* fold,
+    TLearnContext* ctx) {
+
+    Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    if (projections.empty()) {
+        return;
+    }
+    const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
+    auto statsFromAllWorkers = ApplyMapper<TOnlineCtrStatsCalcer>(
+        workerCount,
+        TMasterEnvironment::GetRef().SharedTrainData,
+        projections);
+    // online ctrs are calculated over learn parts of workers concatenated in order of host ids
+    SortBy(statsFromAllWorkers, [] (const auto& workerStats) { return workerStats.HostId; });
+
+    TOnlineCtrStarts ctrStarts;
+    ctrStarts.Projections = projections;
+    ctrStarts.PartStarts.resize(workerCount, TVector<TOnlineCtrPartStart>(projections.size()));
+    TVector<TOnlineCtrPartStats> partStats(workerCount);
+    TVector<TOnlineCtrPartStart> partStarts;
+    for (auto projectionIdx : xrange(projections.size())) {
+        for (auto workerIdx : xrange(workerCount)) {
+            partStats[workerIdx] = std::move(statsFromAllWorkers[workerIdx].Stats[projectionIdx]);
+        }
+        const auto& proj = projections[projectionIdx];
+        MergeOnlineCtrPartStats(
+            data,
+            partStats,
+            proj,
+            ctx->CtrsHelper,
+            fold->TargetClassesCount,
+            ctx->Params.CatFeatureParams.Get(),
+            ctx->LearnAndTestDataPackingAreCompatible,
+            ctx->LocalExecutor,
+            &partStarts,
+            &fold->GetCtrRef(proj));
+        for (auto workerIdx : xrange(workerCount)) {
+            ctrStarts.PartStarts[workerIdx][projectionIdx] = std::move(partStarts[workerIdx]);
+        }
+    }
+    ApplyMapper<TOnlineCtrCalcer>(workerCount, TMasterEnvironment::GetRef().SharedTrainData, ctrStarts);
+}
+
 int MapGetRedundantSplitIdx(TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     const int workerCount = TMasterEnvironment::GetRef().RootEnvironment->GetSlaveCount();
@@ -401,9 +460,9 @@ void MapSetApproxes(
 
     // update learn approx and average approx
     ApplyMapper<TApproxUpdater>(workerCount, TMasterEnvironment::GetRef().SharedTrainData, *averageLeafValues);
-    // update test
+    // update test, online ctr values for test data are kept by the plain fold
     const auto indices = BuildIndices(
-        /*unused fold*/{ },
+        ctx->LearnProgress->Folds[0],
         splitTree, /*learnData*/
         { },
         testData,
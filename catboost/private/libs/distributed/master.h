@@ -8,8 +8,13 @@
 #include <catboost/private/libs/algo/tensor_search_helpers.h>
 #include <catboost/libs/data/data_provider.h>
 #include <catboost/libs/data/loader.h>
+#include <catboost/libs/logging/profile_info.h>
 #include <catboost/private/libs/options/load_options.h>
 
+#include <util/system/demangle.h>
+
+#include <typeinfo>
+
 void InitializeMaster(const NCatboostOptions::TSystemOptions& systemOptions);
 void FinalizeMaster(TLearnContext* ctx);
 void SetTrainDataFromQuantizedPool(
@@ -25,7 +30,7 @@ void SetTrainDataFromMaster(
     NPar::TLocalExecutor* localExecutor);
 void MapBuildPlainFold(TLearnContext* ctx);
 void MapRestoreApproxFromTreeStruct(TLearnContext* ctx);
-void MapTensorSearchStart(TLearnContext* ctx);
+void MapTensorSearchStart(const TFold& fold, TLearnContext* ctx);
 void MapBootstrap(TLearnContext* ctx);
 void MapCalcScore(
     double scoreStDev,
@@ -41,6 +46,12 @@ void MapRemotePairwiseCalcScore(
     TCandidatesContext* candidatesContext,
     TLearnContext* ctx);
 void MapSetIndices(const TSplit& bestSplit, TLearnContext* ctx);
+// compute online ctrs of projections on workers, fold gets values for test data only
+void MapCalcOnlineCtrs(
+    const NCB::TTrainingForCPUDataProviders& data,
+    const TVector<TProjection>& projections,
+    TFold* fold,
+    TLearnContext* ctx);
 int MapGetRedundantSplitIdx(TLearnContext* ctx);
 void MapCalcErrors(TLearnContext* ctx);
 
@@ -50,6 +61,12 @@ TVector<typename TMapper::TOutput> ApplyMapper(
     TObj<NPar::IEnvironment> environment,
     const typename TMapper::TInput& value = typename TMapper::TInput()) {
 
+    // whole round trip to workers including (de)serialization of inputs and outputs
+    static const TString mapperName = CppDemangle(typeid(TMapper).name());
+    NChromiumTrace::TEventArgs traceArgs;
+    traceArgs.Add("workers", i64(workerCount));
+    CATBOOST_TRACE_SCOPE_W_ARGS(mapperName, &traceArgs);
+
     NPar::TJobDescription job;
     TVector<typename TMapper::TInput> mapperInput(1);
     mapperInput[0] = value;
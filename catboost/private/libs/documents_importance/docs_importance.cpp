@@ -163,6 +163,16 @@ TDStrResult GetDocumentImportances(
     ExecuteTasksInParallel(&tasks, localExecutor.Get());
 
     TDocumentImportancesEvaluator leafInfluenceEvaluator(model, *trainProcessedData, updateMethod, localExecutor, logPeriod);
+    if (dstrType != EDocumentStrengthType::Raw && topSize < SafeIntegerCast<int>(trainData.ObjectsData->GetObjectCount())) {
+        // only tops are needed, avoid keeping [trainDocCount][testDocCount] importances in memory
+        return leafInfluenceEvaluator.GetTopDocumentImportances(
+            *testProcessedData,
+            dstrType,
+            SafeIntegerCast<ui32>(topSize),
+            importanceValuesSign,
+            logPeriod
+        );
+    }
     const TVector<TVector<double>> documentImportances
         = leafInfluenceEvaluator.GetDocumentImportances(*testProcessedData, logPeriod);
     return GetFinalDocumentImportances(documentImportances, dstrType, topSize, importanceValuesSign);
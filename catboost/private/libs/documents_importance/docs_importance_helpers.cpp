@@ -1,6 +1,7 @@
 #include "docs_importance_helpers.h"
 #include "ders_helpers.h"
 
+#include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/loggers/logger.h>
 #include <catboost/libs/logging/profile_info.h>
 #include <catboost/private/libs/algo/index_calcer.h>
@@ -18,18 +19,131 @@
 using namespace NCB;
 
 
-TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
-    const TProcessedDataProvider& processedData, int logPeriod
+namespace {
+    struct TImportanceEntry {
+        double Score;
+        ui32 TrainDocId;
+    };
+}
+
+// Entries with larger absolute score go first, ties are resolved by train doc id.
+static bool IsMoreImportant(const TImportanceEntry& lhs, const TImportanceEntry& rhs) {
+    const double lhsAbs = Abs(lhs.Score);
+    const double rhsAbs = Abs(rhs.Score);
+    return lhsAbs > rhsAbs || (lhsAbs == rhsAbs && lhs.TrainDocId < rhs.TrainDocId);
+}
+
+// Keeps topSize most important entries, the least important one is at heap->front().
+static void PushToTopHeap(const TImportanceEntry& entry, ui32 topSize, TVector<TImportanceEntry>* heap) {
+    if (heap->size() < topSize) {
+        heap->push_back(entry);
+        PushHeap(heap->begin(), heap->end(), IsMoreImportant);
+    } else if (topSize != 0 && IsMoreImportant(entry, heap->front())) {
+        PopHeap(heap->begin(), heap->end(), IsMoreImportant);
+        heap->back() = entry;
+        PushHeap(heap->begin(), heap->end(), IsMoreImportant);
+    }
+}
+
+// Absolute score an entry has to reach to enter the top, negative while the top is not full.
+static double GetTopThreshold(const TVector<TImportanceEntry>& heap, ui32 topSize) {
+    return heap.size() < topSize ? -1.0 : Abs(heap.front().Score);
+}
+
+// Bounds are inflated a bit to be robust to rounding errors of summation in a different order.
+static bool CanEnterTop(double importanceBound, double topThreshold) {
+    const double boundSlack = 1 + 1e-9;
+    return importanceBound * boundSlack >= topThreshold;
+}
+
+static bool HasImportanceSign(double value, EImportanceValuesSign importanceValuesSign) {
+    switch (importanceValuesSign) {
+        case EImportanceValuesSign::Positive:
+            return value > 0;
+        case EImportanceValuesSign::Negative:
+            return value < 0;
+        case EImportanceValuesSign::All:
+            return true;
+    }
+    Y_UNREACHABLE();
+}
+
+// Top is selected by absolute values first and filtered by sign afterwards, as in dense evaluation.
+static void FinalizeTopHeap(
+    EImportanceValuesSign importanceValuesSign,
+    TVector<TImportanceEntry>* heap,
+    TVector<ui32>* indices,
+    TVector<double>* scores
 ) {
+    SortHeap(heap->begin(), heap->end(), IsMoreImportant);
+    for (const auto& entry : *heap) {
+        if (HasImportanceSign(entry.Score, importanceValuesSign)) {
+            indices->push_back(entry.TrainDocId);
+            scores->push_back(entry.Score);
+        }
+    }
+    TVector<TImportanceEntry>().swap(*heap);
+}
+
+TVector<TVector<ui32>> TDocumentImportancesEvaluator::CalcLeafIndices(const TProcessedDataProvider& processedData) {
     TVector<TVector<ui32>> leafIndices(TreeCount);
     auto binarizedFeatures = MakeQuantizedFeaturesForEvaluator(Model, *processedData.ObjectsData.Get());
     LocalExecutor->ExecRange([&] (int treeId) {
         leafIndices[treeId] = BuildIndicesForBinTree(Model, binarizedFeatures.Get(), treeId);
     }, NPar::TLocalExecutor::TExecRangeParams(0, TreeCount), NPar::TLocalExecutor::WAIT_COMPLETE);
+    return leafIndices;
+}
 
+TVector<TDocumentImportancesEvaluator::TLeavesDocs> TDocumentImportancesEvaluator::GroupDocsByLeaves(
+    const TVector<TVector<ui32>>& leafIndices
+) {
+    TVector<TLeavesDocs> leavesDocs(TreeCount);
+    LocalExecutor->ExecRange([&] (int treeId) {
+        const TVector<ui32>& leafIndicesRef = leafIndices[treeId];
+        TLeavesDocs& leavesDocsRef = leavesDocs[treeId];
+        const ui32 leafCount = TreesStatistics[treeId].LeafCount;
+
+        leavesDocsRef.LeafOffsets.assign(leafCount + 1, 0);
+        for (ui32 leafId : leafIndicesRef) {
+            ++leavesDocsRef.LeafOffsets[leafId + 1];
+        }
+        for (ui32 leafId = 0; leafId < leafCount; ++leafId) {
+            leavesDocsRef.LeafOffsets[leafId + 1] += leavesDocsRef.LeafOffsets[leafId];
+        }
+        TVector<ui32> leafPositions(leavesDocsRef.LeafOffsets.begin(), leavesDocsRef.LeafOffsets.end() - 1);
+        leavesDocsRef.DocIds.yresize(leafIndicesRef.size());
+        for (ui32 docId = 0; docId < leafIndicesRef.size(); ++docId) {
+            leavesDocsRef.DocIds[leafPositions[leafIndicesRef[docId]]++] = docId;
+        }
+    }, NPar::TLocalExecutor::TExecRangeParams(0, TreeCount), NPar::TLocalExecutor::WAIT_COMPLETE);
+    return leavesDocs;
+}
+
+TVector<TDocumentImportancesEvaluator::TTrainDocBuffers> TDocumentImportancesEvaluator::MakeTrainDocBuffers(
+    ui32 testDocCount
+) const {
+    TVector<TTrainDocBuffers> buffers(LocalExecutor->GetThreadCount() + 1);
+    for (auto& threadBuffers : buffers) {
+        threadBuffers.LeafDerivatives.yresize(LeafDerivativesOffsets.back());
+        threadBuffers.Jacobian.yresize(DocCount);
+        threadBuffers.PredictedDerivatives.yresize(testDocCount);
+        threadBuffers.TreeBounds.yresize(TreeCount);
+        threadBuffers.TreeOrder.reserve(TreeCount);
+        threadBuffers.RemainingBounds.reserve(TreeCount + 1);
+    }
+    return buffers;
+}
+
+TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
+    const TProcessedDataProvider& processedData, int logPeriod
+) {
+    const TVector<TVector<ui32>> leafIndices = CalcLeafIndices(processedData);
+    const TVector<TLeavesDocs> leavesDocs = GroupDocsByLeaves(leafIndices);
 
     UpdateFinalFirstDerivatives(leafIndices, *processedData.TargetData->GetTarget());
-    TVector<TVector<double>> documentImportances(DocCount, TVector<double>(processedData.GetObjectCount()));
+    const ui32 testDocCount = processedData.GetObjectCount();
+    TVector<TVector<double>> documentImportances(DocCount, TVector<double>(testDocCount));
+    TVector<TTrainDocBuffers> buffers = MakeTrainDocBuffers(testDocCount);
     const size_t docBlockSize = 1000;
     TImportanceLogger documentsLogger(DocCount, "documents processed", "Processing documents...", logPeriod);
     TProfileInfo processDocumentsProfile(DocCount);
@@ -39,19 +153,133 @@ TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
         processDocumentsProfile.StartIterationBlock();
 
         LocalExecutor->ExecRange([&] (int docId) {
-            // The derivative of leaf values with respect to train doc weight.
-            TVector<TVector<TVector<double>>> leafDerivatives(TreeCount, TVector<TVector<double>>(LeavesEstimationIterations)); // [treeCount][LeavesEstimationIterationsCount][leafCount]
-            UpdateLeavesDerivatives(docId, &leafDerivatives);
-            GetDocumentImportancesForOneTrainDoc(leafDerivatives, leafIndices, &documentImportances[docId]);
+            GetDocumentImportancesForOneTrainDoc(
+                docId,
+                leafIndices,
+                leavesDocs,
+                &buffers[LocalExecutor->GetWorkerThreadId()],
+                documentImportances[docId]
+            );
         }, NPar::TLocalExecutor::TExecRangeParams(start, end), NPar::TLocalExecutor::WAIT_COMPLETE);
 
         processDocumentsProfile.FinishIterationBlock(end - start);
         auto profileResults = processDocumentsProfile.GetProfileResults();
         documentsLogger.Log(profileResults);
-        }
+    }
     return documentImportances;
 }
 
+TDStrResult TDocumentImportancesEvaluator::GetTopDocumentImportances(
+    const TProcessedDataProvider& processedData,
+    EDocumentStrengthType dstrType,
+    ui32 topSize,
+    EImportanceValuesSign importanceValuesSign,
+    int logPeriod
+) {
+    CB_ENSURE_INTERNAL(
+        dstrType == EDocumentStrengthType::PerObject || dstrType == EDocumentStrengthType::Average,
+        "Top document importances are not supported for " << dstrType
+    );
+    const ui32 testDocCount = processedData.GetObjectCount();
+    const bool isPerObject = dstrType == EDocumentStrengthType::PerObject;
+    if (topSize == 0) {
+        return TDStrResult(isPerObject ? testDocCount : 1);
+    }
+
+    const TVector<TVector<ui32>> leafIndices = CalcLeafIndices(processedData);
+    const TVector<TLeavesDocs> leavesDocs = GroupDocsByLeaves(leafIndices);
+
+    UpdateFinalFirstDerivatives(leafIndices, *processedData.TargetData->GetTarget());
+    TVector<TTrainDocBuffers> buffers = MakeTrainDocBuffers(testDocCount);
+
+    // Importances of a block of train docs are kept in memory until they are merged to the tops.
+    const size_t maxBlockBufferSize = 1 << 24;
+    const size_t docBlockSize = isPerObject
+        ? Max<size_t>(1, Min<size_t>(1000, maxBlockBufferSize / Max<ui32>(testDocCount, 1)))
+        : 1000;
+    TVector<double> blockImportances; // [docBlockSize][testDocCount] for PerObject, [docBlockSize] for Average
+    blockImportances.yresize(isPerObject ? docBlockSize * testDocCount : docBlockSize);
+
+    TVector<TVector<TImportanceEntry>> tops(isPerObject ? testDocCount : 1); // [testDocCount][<= topSize]
+    // Train docs with importance bounds below these thresholds are not evaluated.
+    TVector<double> topThresholds(tops.size(), -1.0); // [testDocCount]
+    TVector<TVector<double>> threadImportances(isPerObject ? 0 : buffers.size()); // [threadCount][testDocCount]
+    for (auto& documentImportance : threadImportances) {
+        documentImportance.yresize(testDocCount);
+    }
+    double meanAbsFinalFirstDerivative = 0;
+    for (double derivative : FinalFirstDerivatives) {
+        meanAbsFinalFirstDerivative += Abs(derivative);
+    }
+    meanAbsFinalFirstDerivative /= Max<ui32>(testDocCount, 1);
+
+    TImportanceLogger documentsLogger(DocCount, "documents processed", "Processing documents...", logPeriod);
+    TProfileInfo processDocumentsProfile(DocCount);
+
+    for (size_t start = 0; start < DocCount; start += docBlockSize) {
+        const size_t end = Min<size_t>(start + docBlockSize, DocCount);
+        processDocumentsProfile.StartIterationBlock();
+
+        LocalExecutor->ExecRange([&] (int docId) {
+            TTrainDocBuffers& threadBuffers = buffers[LocalExecutor->GetWorkerThreadId()];
+            if (isPerObject) {
+                TArrayRef<double> documentImportance(
+                    blockImportances.data() + (docId - start) * testDocCount,
+                    testDocCount
+                );
+                GetTopCandidateImportancesForOneTrainDoc(
+                    docId,
+                    leafIndices,
+                    leavesDocs,
+                    topThresholds,
+                    &threadBuffers,
+                    documentImportance
+                );
+            } else {
+                UpdateLeavesDerivatives(docId, &threadBuffers);
+                const double predictedDerivativeBound = CalcTreeBounds(&threadBuffers);
+                if (!CanEnterTop(meanAbsFinalFirstDerivative * predictedDerivativeBound, topThresholds[0])) {
+                    blockImportances[docId - start] = 0;
+                    return;
+                }
+                TVector<double>& documentImportance = threadImportances[LocalExecutor->GetWorkerThreadId()];
+                CalcDocumentImportancesForOneTrainDoc(leafIndices, leavesDocs, &threadBuffers, documentImportance);
+                blockImportances[docId - start] = Accumulate(documentImportance, 0.0) / testDocCount;
+            }
+        }, NPar::TLocalExecutor::TExecRangeParams(start, end), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+        if (isPerObject) {
+            NPar::TLocalExecutor::TExecRangeParams blockParams(0, testDocCount);
+            blockParams.SetBlockCount(LocalExecutor->GetThreadCount() + 1);
+            LocalExecutor->ExecRange([&] (int testDocId) {
+                for (size_t docId = start; docId < end; ++docId) {
+                    PushToTopHeap(
+                        {blockImportances[(docId - start) * testDocCount + testDocId], SafeIntegerCast<ui32>(docId)},
+                        topSize,
+                        &tops[testDocId]
+                    );
+                }
+                topThresholds[testDocId] = GetTopThreshold(tops[testDocId], topSize);
+            }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+        } else {
+            for (size_t docId = start; docId < end; ++docId) {
+                PushToTopHeap({blockImportances[docId - start], SafeIntegerCast<ui32>(docId)}, topSize, &tops[0]);
+            }
+            topThresholds[0] = GetTopThreshold(tops[0], topSize);
+        }
+
+        processDocumentsProfile.FinishIterationBlock(end - start);
+        auto profileResults = processDocumentsProfile.GetProfileResults();
+        documentsLogger.Log(profileResults);
+    }
+
+    TDStrResult result(tops.size());
+    LocalExecutor->ExecRange([&] (int testDocId) {
+        FinalizeTopHeap(importanceValuesSign, &tops[testDocId], &result.Indices[testDocId], &result.Scores[testDocId]);
+    }, NPar::TLocalExecutor::TExecRangeParams(0, tops.size()), NPar::TLocalExecutor::WAIT_COMPLETE);
+    return result;
+}
+
 void TDocumentImportancesEvaluator::UpdateFinalFirstDerivatives(const TVector<TVector<ui32>>& leafIndices, TConstArrayRef<float> target) {
     const ui32 docCount = SafeIntegerCast<ui32>(target.size());
     TVector<double> finalApproxes(docCount);
@@ -70,7 +298,7 @@ void TDocumentImportancesEvaluator::UpdateFinalFirstDerivatives(const TVector<TV
     EvaluateDerivatives(LossFunction, LeafEstimationMethod, finalApproxes, target, &FinalFirstDerivatives, nullptr, nullptr);
 }
 
-TVector<ui32> TDocumentImportancesEvaluator::GetLeafIdToUpdate(ui32 treeId, const TVector<double>& jacobian) {
+TVector<ui32> TDocumentImportancesEvaluator::GetLeafIdToUpdate(ui32 treeId, TConstArrayRef<double> jacobian) {
     TVector<ui32> leafIdToUpdate;
     const ui32 leafCount = 1 << Model.ObliviousTrees->GetTreeSizes()[treeId];
 
@@ -99,13 +327,26 @@ TVector<ui32> TDocumentImportancesEvaluator::GetLeafIdToUpdate(ui32 treeId, cons
     return leafIdToUpdate;
 }
 
-void TDocumentImportancesEvaluator::UpdateLeavesDerivatives(ui32 removedDocId, TVector<TVector<TVector<double>>>* leafDerivatives) {
-    TVector<double> jacobian(DocCount);
+TArrayRef<double> TDocumentImportancesEvaluator::GetLeafDerivatives(
+    ui32 treeId,
+    ui32 leavesEstimationIteration,
+    TArrayRef<double> allLeafDerivatives
+) const {
+    const ui32 leafCount = TreesStatistics[treeId].LeafCount;
+    return TArrayRef<double>(
+        allLeafDerivatives.data() + LeafDerivativesOffsets[treeId] + leavesEstimationIteration * leafCount,
+        leafCount
+    );
+}
+
+void TDocumentImportancesEvaluator::UpdateLeavesDerivatives(ui32 removedDocId, TTrainDocBuffers* buffers) {
+    TArrayRef<double> jacobian = buffers->Jacobian;
+    Fill(jacobian.begin(), jacobian.end(), 0);
     for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
         auto& treeStatistics = TreesStatistics[treeId];
         for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
             const TVector<ui32> leafIdToUpdate = GetLeafIdToUpdate(treeId, jacobian);
-            TVector<double>& leafDerivativesRef = (*leafDerivatives)[treeId][it];
+            TArrayRef<double> leafDerivativesRef = GetLeafDerivatives(treeId, it, buffers->LeafDerivatives);
 
             // Updating Leaves Derivatives
             UpdateLeavesDerivativesForTree(
@@ -114,14 +355,17 @@ void TDocumentImportancesEvaluator::UpdateLeavesDerivatives(ui32 removedDocId, T
                 jacobian,
                 treeId,
                 it,
-                &leafDerivativesRef
+                leafDerivativesRef
             );
 
             // Updating Jacobian
             bool isRemovedDocUpdated = false;
             for (ui32 leafId : leafIdToUpdate) {
-                for (ui32 docId : treeStatistics.LeavesDocId[leafId]) {
-                    jacobian[docId] += leafDerivativesRef[leafId];
+                const double leafDerivative = leafDerivativesRef[leafId];
+                if (leafDerivative != 0) {
+                    for (ui32 docId : treeStatistics.LeavesDocId[leafId]) {
+                        jacobian[docId] += leafDerivative;
+                    }
                 }
                 isRemovedDocUpdated |= (treeStatistics.LeafIndices[removedDocId] == leafId);
             }
@@ -134,59 +378,166 @@ void TDocumentImportancesEvaluator::UpdateLeavesDerivatives(ui32 removedDocId, T
 }
 
 void TDocumentImportancesEvaluator::GetDocumentImportancesForOneTrainDoc(
-    const TVector<TVector<TVector<double>>>& leafDerivatives,
+    ui32 trainDocId,
+    const TVector<TVector<ui32>>& leafIndices,
+    const TVector<TLeavesDocs>& leavesDocs,
+    TTrainDocBuffers* buffers,
+    TArrayRef<double> documentImportance
+) {
+    // The derivative of leaf values with respect to train doc weight.
+    UpdateLeavesDerivatives(trainDocId, buffers);
+    CalcDocumentImportancesForOneTrainDoc(leafIndices, leavesDocs, buffers, documentImportance);
+}
+
+void TDocumentImportancesEvaluator::CalcDocumentImportancesForOneTrainDoc(
     const TVector<TVector<ui32>>& leafIndices,
-    TVector<double>* documentImportance
+    const TVector<TLeavesDocs>& leavesDocs,
+    TTrainDocBuffers* buffers,
+    TArrayRef<double> documentImportance
 ) {
-    const ui32 docCount = documentImportance->size();
-    TVector<double> predictedDerivatives(docCount);
+    const ui32 docCount = documentImportance.size();
+    TArrayRef<double> predictedDerivatives = buffers->PredictedDerivatives;
+    Fill(predictedDerivatives.begin(), predictedDerivatives.end(), 0);
 
     for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
         const TVector<ui32>& leafIndicesRef = leafIndices[treeId];
+        const TLeavesDocs& leavesDocsRef = leavesDocs[treeId];
         for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
-            const TVector<double>& leafDerivativesRef = leafDerivatives[treeId][it];
-            for (ui32 docId = 0; docId < docCount; ++docId) {
-                predictedDerivatives[docId] += leafDerivativesRef[leafIndicesRef[docId]];
+            const TConstArrayRef<double> leafDerivativesRef = GetLeafDerivatives(treeId, it, buffers->LeafDerivatives);
+            const ui32 leafCount = leafDerivativesRef.size();
+            const ui32 nonZeroLeafCount = CountIf(leafDerivativesRef, [] (double value) { return value != 0; });
+            if (nonZeroLeafCount == 0) {
+                // Removing the train doc doesn't change this tree at all.
+                continue;
+            }
+            if (2 * nonZeroLeafCount <= leafCount) {
+                // Usually only leaves close to the train doc are affected, visit only docs from them.
+                for (ui32 leafId = 0; leafId < leafCount; ++leafId) {
+                    const double leafDerivative = leafDerivativesRef[leafId];
+                    if (leafDerivative == 0) {
+                        continue;
+                    }
+                    for (ui32 i = leavesDocsRef.LeafOffsets[leafId]; i < leavesDocsRef.LeafOffsets[leafId + 1]; ++i) {
+                        predictedDerivatives[leavesDocsRef.DocIds[i]] += leafDerivative;
+                    }
+                }
+            } else {
+                for (ui32 docId = 0; docId < docCount; ++docId) {
+                    predictedDerivatives[docId] += leafDerivativesRef[leafIndicesRef[docId]];
+                }
             }
         }
     }
 
     for (ui32 docId = 0; docId < docCount; ++docId) {
-        (*documentImportance)[docId] = FinalFirstDerivatives[docId] * predictedDerivatives[docId];
+        documentImportance[docId] = FinalFirstDerivatives[docId] * predictedDerivatives[docId];
+    }
+}
+
+double TDocumentImportancesEvaluator::CalcTreeBounds(TTrainDocBuffers* buffers) const {
+    TVector<double>& treeBounds = buffers->TreeBounds;
+    TVector<ui32>& treeOrder = buffers->TreeOrder;
+    treeOrder.clear();
+    for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
+        treeBounds[treeId] = 0;
+        for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
+            double maxAbsLeafDerivative = 0;
+            for (double leafDerivative : GetLeafDerivatives(treeId, it, buffers->LeafDerivatives)) {
+                maxAbsLeafDerivative = Max(maxAbsLeafDerivative, Abs(leafDerivative));
+            }
+            treeBounds[treeId] += maxAbsLeafDerivative;
+        }
+        if (treeBounds[treeId] != 0) {
+            treeOrder.push_back(treeId);
+        }
+    }
+    StableSort(treeOrder.begin(), treeOrder.end(), [&] (ui32 lhs, ui32 rhs) {
+        return treeBounds[lhs] > treeBounds[rhs];
+    });
+
+    TVector<double>& remainingBounds = buffers->RemainingBounds;
+    remainingBounds.resize(treeOrder.size() + 1);
+    remainingBounds.back() = 0;
+    for (size_t i = treeOrder.size(); i > 0; --i) {
+        remainingBounds[i - 1] = remainingBounds[i] + treeBounds[treeOrder[i - 1]];
+    }
+    return remainingBounds[0];
+}
+
+void TDocumentImportancesEvaluator::GetTopCandidateImportancesForOneTrainDoc(
+    ui32 trainDocId,
+    const TVector<TVector<ui32>>& leafIndices,
+    const TVector<TLeavesDocs>& leavesDocs,
+    TConstArrayRef<double> topThresholds,
+    TTrainDocBuffers* buffers,
+    TArrayRef<double> documentImportance
+) {
+    UpdateLeavesDerivatives(trainDocId, buffers);
+    const double predictedDerivativeBound = CalcTreeBounds(buffers);
+
+    const ui32 docCount = documentImportance.size();
+    const auto canEnterTop = [&] (ui32 docId, double docPredictedDerivativeBound) {
+        return CanEnterTop(Abs(FinalFirstDerivatives[docId]) * docPredictedDerivativeBound, topThresholds[docId]);
+    };
+    ui32 candidateCount = 0;
+    for (ui32 docId = 0; docId < docCount; ++docId) {
+        candidateCount += canEnterTop(docId, predictedDerivativeBound);
+    }
+    if (2 * candidateCount > docCount) {
+        // Evaluating by leaves is cheaper than evaluating by objects, non-candidates just won't enter the tops.
+        CalcDocumentImportancesForOneTrainDoc(leafIndices, leavesDocs, buffers, documentImportance);
+        return;
+    }
+
+    const TVector<ui32>& treeOrder = buffers->TreeOrder;
+    const TVector<double>& remainingBounds = buffers->RemainingBounds;
+    for (ui32 docId = 0; docId < docCount; ++docId) {
+        double predictedDerivative = 0;
+        bool isPruned = false;
+        for (ui32 i = 0; i < treeOrder.size(); ++i) {
+            if (!canEnterTop(docId, Abs(predictedDerivative) + remainingBounds[i])) {
+                isPruned = true;
+                break;
+            }
+            const ui32 treeId = treeOrder[i];
+            const ui32 leafId = leafIndices[treeId][docId];
+            for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
+                predictedDerivative += GetLeafDerivatives(treeId, it, buffers->LeafDerivatives)[leafId];
+            }
+        }
+        documentImportance[docId] = isPruned ? 0 : FinalFirstDerivatives[docId] * predictedDerivative;
     }
 }
 
 void TDocumentImportancesEvaluator::UpdateLeavesDerivativesForTree(
     const TVector<ui32>& leafIdToUpdate,
     ui32 removedDocId,
-    const TVector<double>& jacobian,
+    TConstArrayRef<double> jacobian,
     ui32 treeId,
     ui32 leavesEstimationIteration,
-    TVector<double>* leafDerivatives
+    TArrayRef<double> leafDerivatives
 ) {
-    auto& leafDerivativesRef = *leafDerivatives;
     const auto& treeStatistics = TreesStatistics[treeId];
     const TVector<double>& formulaNumeratorMultiplier = treeStatistics.FormulaNumeratorMultiplier[leavesEstimationIteration];
     const TVector<double>& formulaNumeratorAdding = treeStatistics.FormulaNumeratorAdding[leavesEstimationIteration];
     const TVector<double>& formulaDenominators = treeStatistics.FormulaDenominators[leavesEstimationIteration];
     const ui32 removedDocLeafId = treeStatistics.LeafIndices[removedDocId];
 
-    leafDerivativesRef.resize(treeStatistics.LeafCount);
-    Fill(leafDerivativesRef.begin(), leafDerivativesRef.end(), 0);
+    Fill(leafDerivatives.begin(), leafDerivatives.end(), 0);
     bool isRemovedDocUpdated = false;
     for (ui32 leafId : leafIdToUpdate) {
         for (ui32 docId : treeStatistics.LeavesDocId[leafId]) {
-            leafDerivativesRef[leafId] += formulaNumeratorMultiplier[docId] * jacobian[docId];
+            leafDerivatives[leafId] += formulaNumeratorMultiplier[docId] * jacobian[docId];
         }
         if (leafId == removedDocLeafId) {
-            leafDerivativesRef[leafId] += formulaNumeratorAdding[removedDocId];
+            leafDerivatives[leafId] += formulaNumeratorAdding[removedDocId];
         }
-        leafDerivativesRef[leafId] *= -LearningRate / formulaDenominators[leafId];
+        leafDerivatives[leafId] *= -LearningRate / formulaDenominators[leafId];
         isRemovedDocUpdated |= (leafId == removedDocLeafId);
     }
     if (!isRemovedDocUpdated) {
-        leafDerivativesRef[removedDocLeafId] += jacobian[removedDocId] * formulaNumeratorMultiplier[removedDocId];
-        leafDerivativesRef[removedDocLeafId] += formulaNumeratorAdding[removedDocId];
-        leafDerivativesRef[removedDocLeafId] *= -LearningRate / formulaDenominators[removedDocLeafId];
+        leafDerivatives[removedDocLeafId] += jacobian[removedDocId] * formulaNumeratorMultiplier[removedDocId];
+        leafDerivatives[removedDocLeafId] += formulaNumeratorAdding[removedDocId];
+        leafDerivatives[removedDocLeafId] *= -LearningRate / formulaDenominators[removedDocLeafId];
     }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "docs_importance.h"
 #include "enums.h"
 #include "tree_statistics.h"
 
@@ -12,6 +13,7 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/fwd.h>
 #include <util/generic/ptr.h>
 #include <util/system/types.h>
@@ -77,38 +79,104 @@ public:
             treeStatisticsEvaluator = MakeHolder<TNewtonTreeStatisticsEvaluator>(DocCount);
         }
         TreesStatistics = treeStatisticsEvaluator->EvaluateTreeStatistics(model, processedData, startingApprox, logPeriod);
+
+        LeafDerivativesOffsets.yresize(TreeCount + 1);
+        LeafDerivativesOffsets[0] = 0;
+        for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
+            LeafDerivativesOffsets[treeId + 1]
+                = LeafDerivativesOffsets[treeId] + LeavesEstimationIterations * TreesStatistics[treeId].LeafCount;
+        }
     }
 
     // Getting the importance of all train objects for all objects from pool.
     TVector<TVector<double>> GetDocumentImportances(const NCB::TProcessedDataProvider& processedData, int logPeriod = 0);
 
+    /* Getting top (by absolute value) train objects importances for objects from pool
+     * without materializing [trainDocCount][testDocCount] importances matrix.
+     * Only PerObject and Average document strength types are supported.
+     */
+    TDStrResult GetTopDocumentImportances(
+        const NCB::TProcessedDataProvider& processedData,
+        EDocumentStrengthType dstrType,
+        ui32 topSize,
+        EImportanceValuesSign importanceValuesSign,
+        int logPeriod = 0
+    );
+
+private:
+    // Docs (from pool) of one tree grouped by leaves.
+    struct TLeavesDocs {
+        TVector<ui32> DocIds; // [docCount] ordered by leaf
+        TVector<ui32> LeafOffsets; // [leafCount + 1]
+    };
+
+    // Buffers used for processing one train object, allocated once per thread.
+    struct TTrainDocBuffers {
+        TVector<double> LeafDerivatives; // [treeCount][LeavesEstimationIterationsCount][leafCount] flattened.
+        TVector<double> Jacobian; // [DocCount]
+        TVector<double> PredictedDerivatives; // [testDocCount]
+        TVector<double> TreeBounds; // [treeCount] upper bound of |leaf derivative| sum over leaves estimation iterations.
+        TVector<double> RemainingBounds; // [treeCount + 1] suffix sums of TreeBounds in TreeOrder.
+        TVector<ui32> TreeOrder; // [treeCount] trees with nonzero bounds, ordered by decreasing bound.
+    };
+
 private:
+    // Leaf indices of objects from pool for every tree
+    TVector<TVector<ui32>> CalcLeafIndices(const NCB::TProcessedDataProvider& processedData);
+    TVector<TLeavesDocs> GroupDocsByLeaves(const TVector<TVector<ui32>>& leafIndices);
+    TVector<TTrainDocBuffers> MakeTrainDocBuffers(ui32 testDocCount) const;
     // Evaluate first derivatives at the final approxes
     void UpdateFinalFirstDerivatives(const TVector<TVector<ui32>>& leafIndices, TConstArrayRef<float> target);
     // Leaves derivatives will be updated based on objects from these leaves.
-    TVector<ui32> GetLeafIdToUpdate(ui32 treeId, const TVector<double>& jacobian);
+    TVector<ui32> GetLeafIdToUpdate(ui32 treeId, TConstArrayRef<double> jacobian);
+    TArrayRef<double> GetLeafDerivatives(ui32 treeId, ui32 leavesEstimationIteration, TArrayRef<double> allLeafDerivatives) const;
     // Algorithm 4 from paper.
-    void UpdateLeavesDerivatives(ui32 removedDocId, TVector<TVector<TVector<double>>>* leafDerivatives);
+    void UpdateLeavesDerivatives(ui32 removedDocId, TTrainDocBuffers* buffers);
     // Getting the importance of one train object for all objects from pool.
     void GetDocumentImportancesForOneTrainDoc(
-        const TVector<TVector<TVector<double>>>& leafDerivatives,
+        ui32 trainDocId,
+        const TVector<TVector<ui32>>& leafIndices,
+        const TVector<TLeavesDocs>& leavesDocs,
+        TTrainDocBuffers* buffers,
+        TArrayRef<double> documentImportance
+    );
+    // Importances of one train object for all objects from pool with already updated leaves derivatives.
+    void CalcDocumentImportancesForOneTrainDoc(
+        const TVector<TVector<ui32>>& leafIndices,
+        const TVector<TLeavesDocs>& leavesDocs,
+        TTrainDocBuffers* buffers,
+        TArrayRef<double> documentImportance
+    );
+    // Upper bound of |predicted derivative| of any object from pool, trees are ordered by their bounds.
+    double CalcTreeBounds(TTrainDocBuffers* buffers) const;
+    /* Same as GetDocumentImportancesForOneTrainDoc, but importances that can't reach topThresholds
+     * (absolute score of the least important entry in each full top) are set to 0 without evaluation.
+     * Trees are visited in the order of decreasing bounds and evaluation for an object stops
+     * as soon as the rest of the trees can't lift its importance up to the threshold.
+     */
+    void GetTopCandidateImportancesForOneTrainDoc(
+        ui32 trainDocId,
         const TVector<TVector<ui32>>& leafIndices,
-        TVector<double>* documentImportance
+        const TVector<TLeavesDocs>& leavesDocs,
+        TConstArrayRef<double> topThresholds,
+        TTrainDocBuffers* buffers,
+        TArrayRef<double> documentImportance
     );
     // Evaluate leaf derivatives at a given removedDocId weight (Equation (6) from paper).
     void UpdateLeavesDerivativesForTree(
         const TVector<ui32>& leafIdToUpdate,
         ui32 removedDocId,
-        const TVector<double>& jacobian,
+        TConstArrayRef<double> jacobian,
         ui32 treeId,
         ui32 leavesEstimationIteration,
-        TVector<double>* leafDerivatives
+        TArrayRef<double> leafDerivatives
     );
 
 private:
     TFullModel Model;
     TVector<TTreeStatistics> TreesStatistics; // [treeCount]
     TVector<double> FinalFirstDerivatives; // [docCount]
+    TVector<size_t> LeafDerivativesOffsets; // [treeCount + 1]
     TUpdateMethod UpdateMethod;
     ELossFunction LossFunction;
     ELeavesEstimation LeafEstimationMethod;
@@ -0,0 +1,150 @@
+#include <catboost/private/libs/documents_importance/docs_importance.h>
+
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/hash.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+
+
+using namespace NCB;
+
+
+Y_UNIT_TEST_SUITE(TDocumentImportances) {
+    constexpr ui32 FEATURE_COUNT = 4;
+
+    static TDataProviderPtr CreateRandomDataProvider(ui32 objectCount, TReallyFastRng32* rng) {
+        TVector<TVector<float>> features(FEATURE_COUNT); // [featureIdx][objectIdx]
+        TVector<float> target(objectCount);
+        for (auto objectIdx : xrange(objectCount)) {
+            for (auto featureIdx : xrange(FEATURE_COUNT)) {
+                features[featureIdx].push_back(rng->GenRandReal2());
+            }
+            target[objectIdx] = features[0][objectIdx] + 0.5f * features[1][objectIdx] + 0.1f * rng->GenRandReal2();
+        }
+
+        return CreateDataProvider(
+            [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                TDataMetaInfo metaInfo;
+                metaInfo.HasTarget = true;
+                metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                    FEATURE_COUNT,
+                    TVector<ui32>{},
+                    TVector<ui32>{},
+                    TVector<TString>{});
+
+                visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+                for (auto featureIdx : xrange(FEATURE_COUNT)) {
+                    visitor->AddFloatFeature(
+                        featureIdx,
+                        MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(features[featureIdx]))
+                    );
+                }
+                visitor->AddTarget(target);
+                visitor->Finish();
+            }
+        );
+    }
+
+    static TFullModel TrainTestModel(const TDataProviderPtr& trainData, const TString& leafEstimationMethod) {
+        NJson::TJsonValue plainFitParams;
+        plainFitParams.InsertValue("random_seed", 0);
+        plainFitParams.InsertValue("iterations", 20);
+        plainFitParams.InsertValue("depth", 3);
+        plainFitParams.InsertValue("leaf_estimation_method", leafEstimationMethod);
+        plainFitParams.InsertValue("train_dir", ".");
+        plainFitParams.InsertValue("thread_count", 1);
+
+        TDataProviders dataProviders;
+        dataProviders.Learn = trainData;
+
+        TFullModel model;
+        TEvalResult evalResult;
+        TrainModel(
+            plainFitParams,
+            nullptr,
+            Nothing(),
+            Nothing(),
+            dataProviders,
+            /*initModel*/ Nothing(),
+            /*initLearnProgress*/ nullptr,
+            "",
+            &model,
+            {&evalResult}
+        );
+        return model;
+    }
+
+    // Top of topSize entries should be the head of the full (unlimited top size) result.
+    static void CheckTopIsHeadOfFullResult(
+        const TDStrResult& fullResult,
+        const TDStrResult& topResult,
+        ui32 topSize,
+        bool positiveOnly
+    ) {
+        UNIT_ASSERT_VALUES_EQUAL(topResult.Scores.size(), fullResult.Scores.size());
+        for (auto testDocId : xrange(fullResult.Scores.size())) {
+            const auto& fullScores = fullResult.Scores[testDocId];
+            const auto& fullIndices = fullResult.Indices[testDocId];
+            THashMap<ui32, double> fullScoreByIndex;
+            TVector<double> expectedScores;
+            for (auto i : xrange(fullScores.size())) {
+                fullScoreByIndex[fullIndices[i]] = fullScores[i];
+                if (i < topSize && (!positiveOnly || fullScores[i] > 0)) {
+                    expectedScores.push_back(fullScores[i]);
+                }
+            }
+
+            const auto& scores = topResult.Scores[testDocId];
+            const auto& indices = topResult.Indices[testDocId];
+            UNIT_ASSERT_VALUES_EQUAL(scores.size(), expectedScores.size());
+            UNIT_ASSERT_VALUES_EQUAL(indices.size(), expectedScores.size());
+            for (auto i : xrange(scores.size())) {
+                // indices of entries with equal scores may differ, so compare scores of the same train docs
+                UNIT_ASSERT_DOUBLES_EQUAL(scores[i], expectedScores[i], 1e-9);
+                UNIT_ASSERT(fullScoreByIndex.contains(indices[i]));
+                UNIT_ASSERT_DOUBLES_EQUAL(scores[i], fullScoreByIndex.at(indices[i]), 1e-9);
+            }
+        }
+    }
+
+    static void CheckTopsAreEqualToDense(const TString& leafEstimationMethod, const TString& updateMethod) {
+        TReallyFastRng32 rng(0);
+        const auto trainData = CreateRandomDataProvider(/*objectCount*/ 300, &rng);
+        const auto testData = CreateRandomDataProvider(/*objectCount*/ 30, &rng);
+        const auto model = TrainTestModel(trainData, leafEstimationMethod);
+
+        for (const TString dstrType : {"PerObject", "Average"}) {
+            // unlimited top size is evaluated with the dense importances matrix
+            const auto fullResult = GetDocumentImportances(
+                model, *trainData, *testData, dstrType, /*topSize*/ -1, updateMethod, "All", /*threadCount*/ 4
+            );
+            for (int topSize : {0, 1, 7, 299}) {
+                for (const TString importanceValuesSign : {"All", "Positive"}) {
+                    const auto topResult = GetDocumentImportances(
+                        model, *trainData, *testData, dstrType, topSize, updateMethod, importanceValuesSign, 4
+                    );
+                    CheckTopIsHeadOfFullResult(
+                        fullResult,
+                        topResult,
+                        static_cast<ui32>(topSize),
+                        importanceValuesSign == "Positive"
+                    );
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TopIsEqualToDenseGradient) {
+        CheckTopsAreEqualToDense("Gradient", "SinglePoint");
+    }
+
+    Y_UNIT_TEST(TopIsEqualToDenseNewton) {
+        CheckTopsAreEqualToDense("Newton", "AllPoints");
+    }
+}
@@ -3,8 +3,13 @@
 #include "feature_estimator.h"
 #include <catboost/private/libs/text_processing/text_dataset.h>
 
+#include <util/generic/cast.h>
+
 namespace NCB {
-    //TODO(noxoomo): we could fuse estimation in one pass for naive bayes and bm25
+    /* Online learn pass is sequential: features of each object are computed on statistics of exactly
+     * the preceding objects of the permutation. Offline learn and test features are computed in parallel.
+     * See ComputeOnlineFeaturesConcurrently for running several estimators of the same text feature together.
+     */
     template <class TFeatureCalcer, class TCalcerVisitor>
     class TBaseEstimator : public IOnlineFeatureEstimator {
     public:
@@ -21,18 +26,18 @@ namespace NCB {
         void ComputeFeatures(
             TCalculatedFeatureVisitor learnVisitor,
             TConstArrayRef<TCalculatedFeatureVisitor> testVisitors,
-            NPar::TLocalExecutor*) const override {
+            NPar::TLocalExecutor* executor) const override {
 
             THolder<TFeatureCalcer> featureCalcer = EstimateFeatureCalcer();
 
             TVector<TTextDataSetPtr> learnDs{GetLearnDataSetPtr()};
             TVector<TCalculatedFeatureVisitor> learnVisitors{std::move(learnVisitor)};
-            Calc(*featureCalcer, learnDs, learnVisitors);
+            Calc(*featureCalcer, learnDs, learnVisitors, executor);
 
             if (!testVisitors.empty()) {
                 CB_ENSURE(testVisitors.size() == NumberOfTestDataSets(),
                           "If specified, testVisitors should be the same number as test sets");
-                Calc(*featureCalcer, GetTestDataSets(), testVisitors);
+                Calc(*featureCalcer, GetTestDataSets(), testVisitors, executor);
             }
         }
 
@@ -40,7 +45,7 @@ namespace NCB {
             TConstArrayRef<ui32> learnPermutation,
             TCalculatedFeatureVisitor learnVisitor,
             TConstArrayRef<TCalculatedFeatureVisitor> testVisitors,
-            NPar::TLocalExecutor*) const override {
+            NPar::TLocalExecutor* executor) const override {
 
             TFeatureCalcer featureCalcer = CreateFeatureCalcer();
             TCalcerVisitor calcerVisitor = CreateCalcerVisitor();
@@ -72,7 +77,7 @@ namespace NCB {
             if (!testVisitors.empty()) {
                 CB_ENSURE(testVisitors.size() == NumberOfTestDataSets(),
                           "If specified, testVisitors should be the same number as test sets");
-                Calc(featureCalcer, GetTestDataSets(), testVisitors);
+                Calc(featureCalcer, GetTestDataSets(), testVisitors, executor);
             }
         }
 
@@ -96,7 +101,8 @@ namespace NCB {
         void Calc(
             const TFeatureCalcer& featureCalcer,
             TConstArrayRef<TTextDataSetPtr> dataSets,
-            TConstArrayRef<TCalculatedFeatureVisitor> visitors) const {
+            TConstArrayRef<TCalculatedFeatureVisitor> visitors,
+            NPar::TLocalExecutor* executor) const {
 
             const ui32 featuresCount = featureCalcer.FeatureCount();
             for (ui32 id = 0; id < dataSets.size(); ++id) {
@@ -104,9 +110,15 @@ namespace NCB {
                 const ui64 samplesCount = ds.SamplesCount();
                 TVector<float> features(featuresCount * samplesCount);
 
-                for (ui64 line = 0; line < samplesCount; ++line) {
-                    Compute(featureCalcer, ds.GetText(line), line, samplesCount, features);
-                }
+                // feature calcers are not modified by Compute, so objects are independent
+                NPar::ParallelFor(
+                    *executor,
+                    0,
+                    SafeIntegerCast<ui32>(samplesCount),
+                    [&](ui32 line) {
+                        Compute(featureCalcer, ds.GetText(line), line, samplesCount, features);
+                    }
+                );
 
                 for (ui32 f = 0; f < featuresCount; ++f) {
                     visitors[id](
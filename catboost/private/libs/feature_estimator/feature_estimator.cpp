@@ -1 +1,70 @@
 #include "feature_estimator.h"
+
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+
+
+namespace {
+    struct TBufferedFeatures {
+        TVector<std::pair<ui32, TVector<float>>> LearnFeatures;
+        TVector<TVector<std::pair<ui32, TVector<float>>>> TestFeatures; // [testIdx]
+    };
+}
+
+static NCB::TCalculatedFeatureVisitor MakeBufferingVisitor(TVector<std::pair<ui32, TVector<float>>>* buffer) {
+    return [buffer] (ui32 featureId, TConstArrayRef<float> values) {
+        buffer->emplace_back(featureId, TVector<float>(values.begin(), values.end()));
+    };
+}
+
+void NCB::ComputeOnlineFeaturesConcurrently(
+    TConstArrayRef<const IOnlineFeatureEstimator*> estimators,
+    TConstArrayRef<ui32> learnPermutation,
+    TConstArrayRef<TCalculatedFeatureVisitor> learnVisitors,
+    TConstArrayRef<TVector<TCalculatedFeatureVisitor>> testVisitors,
+    NPar::TLocalExecutor* executor
+) {
+    CB_ENSURE(learnVisitors.size() == estimators.size(), "Each estimator should have a learn visitor");
+    CB_ENSURE(testVisitors.size() == estimators.size(), "Each estimator should have a (possibly empty) list of test visitors");
+
+    if (estimators.size() == 1) {
+        estimators[0]->ComputeOnlineFeatures(learnPermutation, learnVisitors[0], testVisitors[0], executor);
+        return;
+    }
+
+    TVector<TBufferedFeatures> buffers(estimators.size());
+    executor->ExecRangeWithThrow(
+        [&] (int estimatorIdx) {
+            auto& buffer = buffers[estimatorIdx];
+            buffer.TestFeatures.resize(testVisitors[estimatorIdx].size());
+
+            TVector<TCalculatedFeatureVisitor> bufferingTestVisitors;
+            for (auto& testFeatures : buffer.TestFeatures) {
+                bufferingTestVisitors.push_back(MakeBufferingVisitor(&testFeatures));
+            }
+            estimators[estimatorIdx]->ComputeOnlineFeatures(
+                learnPermutation,
+                MakeBufferingVisitor(&buffer.LearnFeatures),
+                bufferingTestVisitors,
+                executor
+            );
+        },
+        0,
+        SafeIntegerCast<int>(estimators.size()),
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+
+    for (auto estimatorIdx : xrange(estimators.size())) {
+        auto& buffer = buffers[estimatorIdx];
+        for (const auto& [featureId, values] : buffer.LearnFeatures) {
+            learnVisitors[estimatorIdx](featureId, values);
+        }
+        buffer.LearnFeatures = {};
+        for (auto testIdx : xrange(buffer.TestFeatures.size())) {
+            for (const auto& [featureId, values] : buffer.TestFeatures[testIdx]) {
+                testVisitors[estimatorIdx][testIdx](featureId, values);
+            }
+            buffer.TestFeatures[testIdx] = {};
+        }
+    }
+}
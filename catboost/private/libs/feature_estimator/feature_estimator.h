@@ -81,4 +81,17 @@ namespace NCB {
 
     using TFeatureEstimatorPtr = TIntrusiveConstPtr<IFeatureEstimator>;
     using TOnlineFeatureEstimatorPtr = TIntrusiveConstPtr<IOnlineFeatureEstimator>;
+
+
+    /*
+     * Runs online estimation of several estimators (usually all calcers of the same text feature) in parallel.
+     * Calculated features are buffered and passed to visitors from the calling thread afterwards,
+     * in estimators order, so visitors don't have to be thread-safe.
+     */
+    void ComputeOnlineFeaturesConcurrently(
+        TConstArrayRef<const IOnlineFeatureEstimator*> estimators,
+        TConstArrayRef<ui32> learnPermutation,
+        TConstArrayRef<TCalculatedFeatureVisitor> learnVisitors, // [estimatorIdx]
+        TConstArrayRef<TVector<TCalculatedFeatureVisitor>> testVisitors, // [estimatorIdx][testIdx]
+        NPar::TLocalExecutor* executor);
 }
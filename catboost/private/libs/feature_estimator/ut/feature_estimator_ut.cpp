@@ -7,7 +7,9 @@
 #include <catboost/private/libs/text_features/naive_bayesian.h>
 
 #include <library/unittest/registar.h>
+#include <util/generic/map.h>
 #include <util/random/fast.h>
+#include <util/random/shuffle.h>
 
 
 using namespace NCB;
@@ -239,4 +241,96 @@ Y_UNIT_TEST_SUITE(TestFeatureEstimators) {
             }
         }
     }
+
+    Y_UNIT_TEST(TestConcurrentOnlineEstimation) {
+        const ui32 numSamples = 200;
+        const ui32 numClasses = 3;
+        const ui32 dictionarySize = 30;
+
+        TVector<ui32> classes(numSamples);
+        for (ui32 i: xrange(numSamples)) {
+            classes[i] = i % numClasses;
+        }
+        TTextClassificationTargetPtr target = MakeIntrusive<TTextClassificationTarget>(
+            std::move(classes),
+            numClasses
+        );
+
+        TFastRng<ui64> rng(0);
+        TVector<TText> texts(numSamples);
+        for (ui32 sampleId: xrange(numSamples)) {
+            for (ui32 tokenId: xrange(dictionarySize)) {
+                double real1 = rng.GenRandReal1();
+                if (real1 > 0.7) {
+                    texts[sampleId].insert({tokenId, static_cast<ui32>(real1 * 10)});
+                }
+            }
+        }
+
+        TTextColumnDictionaryOptions columnDictionaryOptions;
+        TDictionaryPtr dictionary = new TDictionaryProxy(
+            NTextProcessing::NDictionary::TDictionaryBuilder(
+                columnDictionaryOptions.DictionaryBuilderOptions,
+                columnDictionaryOptions.DictionaryOptions
+            ).FinishBuilding()
+        );
+
+        TTextDataSetPtr learnTexts = MakeIntrusive<TTextDataSet>(TTextColumn::CreateOwning(TVector<TText>(texts)), dictionary);
+        TVector<TTextDataSetPtr> testTexts = {
+            MakeIntrusive<TTextDataSet>(TTextColumn::CreateOwning(std::move(texts)), dictionary)
+        };
+
+        TVector<ui32> learnPermutation(numSamples);
+        Iota(learnPermutation.begin(), learnPermutation.end(), 0);
+        Shuffle(learnPermutation.begin(), learnPermutation.end(), rng);
+
+        TEmbeddingPtr embeddingPtr;
+        TVector<TOnlineFeatureEstimatorPtr> estimators = CreateEstimators(
+            {
+                NCatboostOptions::TFeatureCalcerDescription(EFeatureCalcerType::NaiveBayes),
+                NCatboostOptions::TFeatureCalcerDescription(EFeatureCalcerType::BM25)
+            },
+            embeddingPtr,
+            target,
+            learnTexts,
+            testTexts
+        );
+        UNIT_ASSERT_VALUES_EQUAL(estimators.size(), 2);
+
+        using TFeatures = TMap<std::pair<ui32, ui32>, TVector<float>>; // (estimatorIdx, featureId) -> values
+        auto makeVisitor = [] (TFeatures* features, ui32 estimatorIdx) -> TCalculatedFeatureVisitor {
+            return [=] (ui32 featureId, TConstArrayRef<float> values) {
+                (*features)[{estimatorIdx, featureId}] = TVector<float>(values.begin(), values.end());
+            };
+        };
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        TFeatures expectedLearn;
+        TFeatures expectedTest;
+        for (ui32 estimatorIdx : xrange(estimators.size())) {
+            estimators[estimatorIdx]->ComputeOnlineFeatures(
+                learnPermutation,
+                makeVisitor(&expectedLearn, estimatorIdx),
+                {makeVisitor(&expectedTest, estimatorIdx)},
+                &localExecutor
+            );
+        }
+
+        TFeatures learn;
+        TFeatures test;
+        TVector<const IOnlineFeatureEstimator*> estimatorPtrs;
+        TVector<TCalculatedFeatureVisitor> learnVisitors;
+        TVector<TVector<TCalculatedFeatureVisitor>> testVisitors;
+        for (ui32 estimatorIdx : xrange(estimators.size())) {
+            estimatorPtrs.push_back(estimators[estimatorIdx].Get());
+            learnVisitors.push_back(makeVisitor(&learn, estimatorIdx));
+            testVisitors.push_back({makeVisitor(&test, estimatorIdx)});
+        }
+        ComputeOnlineFeaturesConcurrently(estimatorPtrs, learnPermutation, learnVisitors, testVisitors, &localExecutor);
+
+        UNIT_ASSERT_EQUAL(learn, expectedLearn);
+        UNIT_ASSERT_EQUAL(test, expectedTest);
+    }
 }
@@ -26,6 +26,7 @@ namespace NCB {
         TVector<EPredictionType> PredictionTypes = {EPredictionType::RawFormulaVal};
         TVector<TString> OutputColumnsIds = {"SampleId", "RawFormulaVal"};
         EFstrType FstrType = EFstrType::FeatureImportance;
+        bool FstrUseFullDataset = false;
         TVector<TString> ClassNames;
         int ThreadCount = NSystemInfo::CachedNumberOfCpus();
 
@@ -9,28 +9,41 @@ NCatboostOptions::TFeatureEvalOptions::TFeatureEvalOptions()
     , FoldCount("fold_count", 0)
     , FoldSizeUnit("fold_size_unit", ESamplingUnit::Object)
     , FoldSize("fold_size", 0)
+    , SequentialTesting("sequential_testing", false)
+    , SequentialTestSignificance("sequential_test_significance", 0.05)
+    , SequentialTestWinProbability("sequential_test_win_probability", 0.75)
 {
 }
 
 void NCatboostOptions::TFeatureEvalOptions::Load(const NJson::TJsonValue& options) {
     CheckedLoad(
         options, &FeaturesToEvaluate, &FeatureEvalMode, &EvalFeatureFileName,
-        &Offset, &FoldCount, &FoldSizeUnit, &FoldSize);
+        &Offset, &FoldCount, &FoldSizeUnit, &FoldSize,
+        &SequentialTesting, &SequentialTestSignificance, &SequentialTestWinProbability);
+    CB_ENSURE(
+        0 < SequentialTestSignificance.Get() && SequentialTestSignificance.Get() < 0.5,
+        "sequential_test_significance should be in (0, 0.5)");
+    CB_ENSURE(
+        0.5 < SequentialTestWinProbability.Get() && SequentialTestWinProbability.Get() < 1,
+        "sequential_test_win_probability should be in (0.5, 1)");
 }
 
 void NCatboostOptions::TFeatureEvalOptions::Save(NJson::TJsonValue* options) const {
     SaveFields(
         options, FeaturesToEvaluate, FeatureEvalMode, EvalFeatureFileName,
-        Offset, FoldCount, FoldSizeUnit, FoldSize);
+        Offset, FoldCount, FoldSizeUnit, FoldSize,
+        SequentialTesting, SequentialTestSignificance, SequentialTestWinProbability);
 }
 
 bool NCatboostOptions::TFeatureEvalOptions::operator==(const TFeatureEvalOptions& rhs) const {
     const auto& options = std::tie(
         FeaturesToEvaluate, FeatureEvalMode, EvalFeatureFileName,
-        Offset, FoldCount, FoldSizeUnit, FoldSize);
+        Offset, FoldCount, FoldSizeUnit, FoldSize,
+        SequentialTesting, SequentialTestSignificance, SequentialTestWinProbability);
     const auto& rhsOptions = std::tie(
         rhs.FeaturesToEvaluate, rhs.FeatureEvalMode, rhs.EvalFeatureFileName,
-        rhs.Offset, rhs.FoldCount, rhs.FoldSizeUnit, rhs.FoldSize);
+        rhs.Offset, rhs.FoldCount, rhs.FoldSizeUnit, rhs.FoldSize,
+        rhs.SequentialTesting, rhs.SequentialTestSignificance, rhs.SequentialTestWinProbability);
     return options == rhsOptions;
 }
 
@@ -27,5 +27,9 @@ namespace NCatboostOptions {
         TOption<ui32> FoldCount;
         TOption<ESamplingUnit> FoldSizeUnit;
         TOption<ui32> FoldSize;
+        // train baseline and tested folds in pairs and stop once a sequential test settles the verdict
+        TOption<bool> SequentialTesting;
+        TOption<double> SequentialTestSignificance;
+        TOption<double> SequentialTestWinProbability;
     };
 }
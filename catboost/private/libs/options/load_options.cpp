@@ -2,6 +2,9 @@
 
 #include <catboost/private/libs/data_util/exists_checker.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/strbuf.h>
+
 void NCatboostOptions::TColumnarPoolFormatParams::Validate() const {
     if (CdFilePath.Inited()) {
         CB_ENSURE(CheckExists(CdFilePath), "CD-file doesn't exist");
@@ -60,8 +63,13 @@ void NCatboostOptions::ValidatePoolParams(
     const NCB::TPathWithScheme& poolPath,
     const TColumnarPoolFormatParams& poolFormatParams
 ) {
+    // schemes of dsv pools read directly, memory-mapped or compressed
+    const bool isDsvScheme = IsIn(
+        {TStringBuf("dsv"), TStringBuf("mmap"), TStringBuf("gz"), TStringBuf("blockcodecs"), TStringBuf("zstd"), TStringBuf("lz4")},
+        poolPath.Scheme
+    );
     CB_ENSURE(
-        poolPath.Scheme == "dsv" || !poolFormatParams.DsvFormat.HasHeader,
+        isDsvScheme || !poolFormatParams.DsvFormat.HasHeader,
         "HasHeader parameter supported for \"dsv\" pools only."
     );
 }
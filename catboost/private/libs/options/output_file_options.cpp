@@ -72,6 +72,7 @@ NCatboostOptions::TOutputFilesOptions::TOutputFilesOptions()
     , Name("name", "experiment")
     , JsonLogPath("json_log", "catboost_training.json")
     , ProfileLogPath("profile_log", "catboost_profile.log")
+    , ChromeTraceLogPath("chrome_trace_log", "")
     , LearnErrorLogPath("learn_error_log", "learn_error.tsv")
     , ModelFormats("model_format", {EModelType::CatboostBinary})
     , TestErrorLogPath("test_error_log", "test_error.tsv")
@@ -90,6 +91,8 @@ NCatboostOptions::TOutputFilesOptions::TOutputFilesOptions()
     , OutputBordersFileName("output_borders", "")
     , VerbosePeriod("verbose", 1)
     , MetricPeriod("metric_period", 1)
+    , MetricSampleRate("metric_sample_rate", 1.0f)
+    , FullMetricPeriod("full_metric_period", 0)
     , PredictionTypes("prediction_type", {EPredictionType::RawFormulaVal})
     , OutputColumns("output_columns", {"SampleId", "RawFormulaVal", "Label"})
     , RocOutputPath("roc_file", "") {
@@ -114,6 +117,14 @@ TString NCatboostOptions::TOutputFilesOptions::CreateOutputBordersFullPath() con
 bool NCatboostOptions::TOutputFilesOptions::NeedSaveBorders() const {
     return OutputBordersFileName.IsSet();
 }
+
+TString NCatboostOptions::TOutputFilesOptions::CreateChromeTraceLogFullPath() const {
+    return GetFullPath(ChromeTraceLogPath.Get());
+}
+
+bool NCatboostOptions::TOutputFilesOptions::NeedChromeTraceLog() const {
+    return !ChromeTraceLogPath.Get().empty();
+}
 //local
 const TString& NCatboostOptions::TOutputFilesOptions::GetLearnErrorFilename() const {
     return LearnErrorLogPath.Get();
@@ -226,6 +237,14 @@ int NCatboostOptions::TOutputFilesOptions::GetMetricPeriod() const {
     return MetricPeriod.Get();
 }
 
+float NCatboostOptions::TOutputFilesOptions::GetMetricSampleRate() const {
+    return MetricSampleRate.Get();
+}
+
+int NCatboostOptions::TOutputFilesOptions::GetFullMetricPeriod() const {
+    return FullMetricPeriod.Get();
+}
+
 TString NCatboostOptions::TOutputFilesOptions::CreateFstrRegularFullPath() const {
     return GetFullPath(FstrRegularFileName.Get());
 }
@@ -252,13 +271,13 @@ TString NCatboostOptions::TOutputFilesOptions::GetRocOutputPath() const {
 
 bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions& rhs) const {
     return std::tie(
-            TrainDir, Name, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
+            TrainDir, Name, JsonLogPath, ProfileLogPath, ChromeTraceLogPath, LearnErrorLogPath, TestErrorLogPath,
             TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
             AllowWriteFilesFlag, FinalCtrComputationMode, FinalFeatureCalcerComputationMode, UseBestModel, BestModelMinTrees,
             SnapshotSaveIntervalSeconds, EvalFileName, FstrRegularFileName, FstrInternalFileName, FstrType,
             TrainingOptionsFileName, OutputBordersFileName, RocOutputPath
             ) == std::tie(
-                rhs.TrainDir, rhs.Name, rhs.JsonLogPath, rhs.ProfileLogPath,
+                rhs.TrainDir, rhs.Name, rhs.JsonLogPath, rhs.ProfileLogPath, rhs.ChromeTraceLogPath,
                 rhs.LearnErrorLogPath, rhs.TestErrorLogPath, rhs.TimeLeftLog, rhs.ResultModelPath,
                 rhs.SnapshotPath, rhs.ModelFormats, rhs.SaveSnapshotFlag, rhs.AllowWriteFilesFlag,
                 rhs.FinalCtrComputationMode, rhs.FinalFeatureCalcerComputationMode, rhs.UseBestModel, rhs.BestModelMinTrees,
@@ -275,12 +294,12 @@ bool NCatboostOptions::TOutputFilesOptions::operator!=(const TOutputFilesOptions
 void NCatboostOptions::TOutputFilesOptions::Load(const NJson::TJsonValue& options) {
     CheckedLoad(
             options,
-            &TrainDir, &Name, &JsonLogPath, &ProfileLogPath, &LearnErrorLogPath,
+            &TrainDir, &Name, &JsonLogPath, &ProfileLogPath, &ChromeTraceLogPath, &LearnErrorLogPath,
             &TestErrorLogPath, &TimeLeftLog, &ResultModelPath, &SnapshotPath, &ModelFormats,
             &SaveSnapshotFlag, &AllowWriteFilesFlag, &FinalCtrComputationMode, &FinalFeatureCalcerComputationMode,
             &UseBestModel, &BestModelMinTrees, &SnapshotSaveIntervalSeconds, &EvalFileName, &OutputColumns,
             &FstrRegularFileName, &FstrInternalFileName, &FstrType, &TrainingOptionsFileName, &MetricPeriod,
-            &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath
+            &MetricSampleRate, &FullMetricPeriod, &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath
             );
     if (!VerbosePeriod.IsSet() || VerbosePeriod.Get() == 1) {
         VerbosePeriod.Set(MetricPeriod.Get());
@@ -291,12 +310,12 @@ void NCatboostOptions::TOutputFilesOptions::Load(const NJson::TJsonValue& option
 void NCatboostOptions::TOutputFilesOptions::Save(NJson::TJsonValue* options) const {
     SaveFields(
             options,
-            TrainDir, Name, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
+            TrainDir, Name, JsonLogPath, ProfileLogPath, ChromeTraceLogPath, LearnErrorLogPath, TestErrorLogPath,
             TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
             AllowWriteFilesFlag, FinalCtrComputationMode, FinalFeatureCalcerComputationMode, UseBestModel,
             BestModelMinTrees, SnapshotSaveIntervalSeconds, EvalFileName, OutputColumns, FstrRegularFileName,
-            FstrInternalFileName, FstrType, TrainingOptionsFileName, MetricPeriod, VerbosePeriod, PredictionTypes,
-            OutputBordersFileName, RocOutputPath
+            FstrInternalFileName, FstrType, TrainingOptionsFileName, MetricPeriod, MetricSampleRate, FullMetricPeriod, VerbosePeriod,
+            PredictionTypes, OutputBordersFileName, RocOutputPath
             );
 }
 
@@ -319,6 +338,12 @@ void NCatboostOptions::TOutputFilesOptions::Validate() const {
     CB_ENSURE(GetVerbosePeriod() % GetMetricPeriod() == 0,
         "verbose should be a multiple of metric_period, got " <<
         GetVerbosePeriod() << " vs " << GetMetricPeriod());
+    CB_ENSURE(GetMetricSampleRate() > 0.0f && GetMetricSampleRate() <= 1.0f,
+        "metric_sample_rate should be in (0, 1], got " << GetMetricSampleRate());
+    CB_ENSURE(GetFullMetricPeriod() >= 0, "Full metric period should be nonnegative.");
+    CB_ENSURE(GetFullMetricPeriod() % GetMetricPeriod() == 0,
+        "full_metric_period should be a multiple of metric_period, got " <<
+        GetFullMetricPeriod() << " vs " << GetMetricPeriod());
 }
 
 TString NCatboostOptions::TOutputFilesOptions::GetFullPath(const TString& fileName) const {
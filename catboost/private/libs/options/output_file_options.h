@@ -54,6 +54,11 @@ namespace NCatboostOptions {
 
         const TString& GetProfileLogFilename() const;
 
+        // Chrome trace of training stages is written only if chrome_trace_log is specified
+        bool NeedChromeTraceLog() const;
+
+        TString CreateChromeTraceLogFullPath() const;
+
         const TString& GetResultModelFilename() const;
 
         const TString& GetSnapshotFilename() const;
@@ -81,6 +86,12 @@ namespace NCatboostOptions {
 
         int GetMetricPeriod() const;
 
+        // fraction of objects non-tracker metrics are calculated on between full metric evaluations
+        float GetMetricSampleRate() const;
+
+        // period of calculating all metrics on the full datasets if metric_sample_rate < 1, 0 means last iteration only
+        int GetFullMetricPeriod() const;
+
         TString CreateFstrRegularFullPath() const;
 
         TString CreateFstrIternalFullPath() const;
@@ -130,6 +141,7 @@ namespace NCatboostOptions {
         TOption<TString> Name;
         TOption<TString> JsonLogPath;
         TOption<TString> ProfileLogPath;
+        TOption<TString> ChromeTraceLogPath;
         TOption<TString> LearnErrorLogPath;
         TOption<TVector<EModelType>> ModelFormats;
         TOption<TString> TestErrorLogPath;
@@ -149,6 +161,8 @@ namespace NCatboostOptions {
         TOption<TString> OutputBordersFileName;
         TOption<int> VerbosePeriod;
         TOption<int> MetricPeriod;
+        TOption<float> MetricSampleRate;
+        TOption<int> FullMetricPeriod;
 
         TOption<TVector<EPredictionType>> PredictionTypes;
         TOption<TVector<TString>> OutputColumns;
@@ -284,6 +284,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "meta", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "json_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "profile_log", &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "chrome_trace_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "learn_error_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "test_error_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "time_left_log", &outputFilesJson, &seenKeys);
@@ -293,6 +294,8 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "snapshot_interval", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "verbose", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "metric_period", &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "metric_sample_rate", &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "full_metric_period", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "prediction_type", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "output_columns", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "allow_writing_files", &outputFilesJson, &seenKeys);
@@ -516,6 +519,7 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
     DeleteSeenOption(&outputoptionsCopy, "meta");
     DeleteSeenOption(&outputoptionsCopy, "json_log");
     DeleteSeenOption(&outputoptionsCopy, "profile_log");
+    DeleteSeenOption(&outputoptionsCopy, "chrome_trace_log");
     DeleteSeenOption(&outputoptionsCopy, "learn_error_log");
     DeleteSeenOption(&outputoptionsCopy, "test_error_log");
     DeleteSeenOption(&outputoptionsCopy, "time_left_log");
@@ -525,6 +529,8 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
     DeleteSeenOption(&outputoptionsCopy, "snapshot_interval");
     DeleteSeenOption(&outputoptionsCopy, "verbose");
     DeleteSeenOption(&outputoptionsCopy, "metric_period");
+    DeleteSeenOption(&outputoptionsCopy, "metric_sample_rate");
+    DeleteSeenOption(&outputoptionsCopy, "full_metric_period");
     DeleteSeenOption(&outputoptionsCopy, "prediction_type");
     DeleteSeenOption(&outputoptionsCopy, "output_columns");
     DeleteSeenOption(&outputoptionsCopy, "allow_writing_files");
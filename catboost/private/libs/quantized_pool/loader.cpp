@@ -13,12 +13,14 @@
 #include <catboost/libs/logging/logging.h>
 #include <catboost/private/libs/quantization_schema/serialization.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
 #include <util/generic/deque.h>
 #include <util/generic/mapfindptr.h>
 #include <util/generic/scope.h>
 #include <util/generic/vector.h>
 #include <util/generic/ylimits.h>
+#include <util/system/align.h>
 #include <util/system/madvise.h>
 #include <util/system/types.h>
 #include <util/system/unaligned_mem.h>
@@ -37,6 +39,7 @@ using NCB::TMaybeOwningConstArrayHolder;
 using NCB::TPathWithScheme;
 using NCB::TQuantizedPool;
 using NCB::TUnalignedArrayBuf;
+using NCB::TVectorHolder;
 
 NCB::TCBQuantizedDataLoader::TCBQuantizedDataLoader(TDatasetLoaderPullArgs&& args)
     : ObjectCount(0) // inited later
@@ -204,7 +207,7 @@ void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
         flatFeatureIdx,
         GetDatasetOffset(chunk),
         chunk.Chunk->BitsPerDocument(),
-        TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(quants));
+        MakeFeaturePartHolder(chunk, quants));
 }
 
  void NCB::TCBQuantizedDataLoader::AddQuantizedCatFeatureChunk(
@@ -222,7 +225,7 @@ void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
         flatFeatureIdx,
         GetDatasetOffset(chunk),
         chunk.Chunk->BitsPerDocument(),
-        TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(quants));
+        MakeFeaturePartHolder(chunk, quants));
 }
 
 void NCB::TCBQuantizedDataLoader::AddChunk(
@@ -284,6 +287,34 @@ void NCB::TCBQuantizedDataLoader::AddChunk(
     }
 }
 
+TMaybeOwningConstArrayHolder<ui8> NCB::TCBQuantizedDataLoader::MakeFeaturePartHolder(
+    const TQuantizedPool::TChunkDescription& chunk,
+    const TConstArrayRef<ui8> quants) const
+{
+    const auto valueBytes = static_cast<size_t>(chunk.Chunk->BitsPerDocument() / CHAR_BIT);
+    const auto* const quantsBegin = quants.data();
+    const auto* const paddedEnd = quantsBegin + AlignUp(quants.size(), sizeof(ui64));
+
+    // whole aligned column that can be referenced without copying, see AddFloatFeaturePart contract
+    const bool canBeReferenced = BlobsHolder &&
+        (GetDatasetOffset(chunk) == 0) &&
+        (quants.size() == static_cast<size_t>(ObjectCount) * valueBytes) &&
+        (reinterpret_cast<uintptr_t>(quantsBegin) % QUANTIZED_POOL_QUANTS_ALIGNMENT == 0) &&
+        AnyOf(
+            BlobsHolder->Data,
+            [=] (const TBlob& blob) {
+                const auto* const blobBegin = reinterpret_cast<const ui8*>(blob.Data());
+                return (blobBegin <= quantsBegin) && (paddedEnd <= blobBegin + blob.Size());
+            }) &&
+        // pools written before quants alignment was introduced can have arbitrary data after quants
+        AllOf(quants.end(), paddedEnd, [] (ui8 value) { return value == 0; });
+
+    if (canBeReferenced) {
+        return TMaybeOwningConstArrayHolder<ui8>::CreateOwning(quants, BlobsHolder);
+    }
+    return TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(quants);
+}
+
 TConstArrayRef<ui8> NCB::TCBQuantizedDataLoader::ClipByDatasetSubset(const TQuantizedPool::TChunkDescription& chunk) const {
     const auto valueBytes = static_cast<size_t>(chunk.Chunk->BitsPerDocument() / CHAR_BIT);
     CB_ENSURE(valueBytes > 0, "Cannot read quantized pool with less than " << CHAR_BIT << " bits per value");
@@ -335,6 +366,11 @@ void NCB::TCBQuantizedDataLoader::Do(IQuantizedFeaturesDataVisitor* visitor) {
     const auto columnIdxToBaselineIdx = GetColumnIndexToBaselineIndexMap(QuantizedPool);
     const auto chunkRefs = GatherAndSortChunks(QuantizedPool);
 
+    if (QuantizedPool.ChunkStorage.empty()) {
+        // keep blobs alive after QuantizedPool is released for features data referenced without copying
+        BlobsHolder = MakeIntrusive<TVectorHolder<TBlob>>(TVector<TBlob>(QuantizedPool.Blobs));
+    }
+
     TSequentialChunkEvictor evictor(1ULL << 24);
     CATBOOST_DEBUG_LOG << "Number of chunks to process " << chunkRefs.size() << Endl;
     for (const auto chunkRef : chunkRefs) {
@@ -383,6 +419,7 @@ void NCB::TCBQuantizedDataLoader::Do(IQuantizedFeaturesDataVisitor* visitor) {
     evictor.MaybeEvict(true);
 
     QuantizedPool = TQuantizedPool(); // release memory
+    BlobsHolder.Reset();
     SetGroupWeights(GroupWeightsPath, ObjectCount, DatasetSubset, visitor);
     SetPairs(PairsPath, ObjectCount, DatasetSubset, visitor);
     SetBaseline(BaselinePath, ObjectCount, DatasetSubset, DataMetaInfo.ClassNames, visitor);
@@ -4,6 +4,7 @@
 #include "serialization.h"
 
 #include <catboost/libs/data/loader.h>
+#include <catboost/libs/helpers/maybe_owning_array_holder.h>
 #include <catboost/private/libs/index_range/index_range.h>
 
 #include <library/object_factory/object_factory.h>
@@ -35,6 +36,10 @@ namespace NCB {
             const size_t flatFeatureIdx,
             IQuantizedFeaturesDataVisitor* visitor) const;
 
+        TMaybeOwningConstArrayHolder<ui8> MakeFeaturePartHolder(
+            const TQuantizedPool::TChunkDescription& chunk,
+            TConstArrayRef<ui8> quants) const;
+
         TConstArrayRef<ui8> ClipByDatasetSubset(const TQuantizedPool::TChunkDescription& chunk) const;
         ui32 GetDatasetOffset(const TQuantizedPool::TChunkDescription& chunk) const;
 
@@ -52,6 +57,9 @@ namespace NCB {
         TDataMetaInfo DataMetaInfo;
         EObjectsOrder ObjectsOrder;
         TDatasetSubset DatasetSubset;
+
+        // set only while reading chunks from blobs
+        TIntrusivePtr<TVectorHolder<TBlob>> BlobsHolder;
     };
 
     struct IQuantizedPoolLoader {
@@ -117,6 +117,18 @@ namespace {
     };
 }
 
+// Quants are aligned within the chunk flatbuffer and the chunk itself is aligned within the file, so
+// mapped quants can be used directly as column storage. Padding after quants is zero-filled.
+static flatbuffers::Offset<flatbuffers::Vector<ui8>> CreateAlignedQuantsVector(
+    const TConstArrayRef<ui8> quants,
+    flatbuffers::FlatBufferBuilder* const builder) {
+
+    builder->StartVector(quants.size(), sizeof(ui8));
+    builder->PreAlign(quants.size(), NCB::QUANTIZED_POOL_QUANTS_ALIGNMENT);
+    builder->PushBytes(quants.data(), quants.size());
+    return flatbuffers::Offset<flatbuffers::Vector<ui8>>(builder->EndVector(quants.size()));
+}
+
 static void WriteChunk(
     const NCB::TQuantizedPool::TChunkDescription& chunk,
     TCountingOutput* const output,
@@ -125,9 +137,9 @@ static void WriteChunk(
 
     builder->Clear();
 
-    const auto quantsOffset = builder->CreateVector(
-        chunk.Chunk->Quants()->data(),
-        chunk.Chunk->Quants()->size());
+    const auto quantsOffset = CreateAlignedQuantsVector(
+        MakeArrayRef(chunk.Chunk->Quants()->data(), chunk.Chunk->Quants()->size()),
+        builder);
     NCB::NIdl::TQuantizedFeatureChunkBuilder chunkBuilder(*builder);
     chunkBuilder.add_BitsPerDocument(chunk.Chunk->BitsPerDocument());
     chunkBuilder.add_Quants(quantsOffset);
@@ -796,9 +808,12 @@ namespace NCB {
                 NIdl::CreateTQuantizedFeatureChunk(
                     builder,
                     static_cast<NIdl::EBitsPerDocumentFeature>(sizeof(T)*8),
-                    builder.CreateVector(
-                        reinterpret_cast<const ui8*>(dataPart.data()),
-                        sizeof(T)*dataPart.size()
+                    CreateAlignedQuantsVector(
+                        MakeArrayRef(
+                            reinterpret_cast<const ui8*>(dataPart.data()),
+                            sizeof(T)*dataPart.size()
+                        ),
+                        &builder
                     )
                 )
             );
@@ -70,6 +70,9 @@ namespace NCB {
     template<class T>
     TSrcColumn<T> GenerateSrcColumn(TConstArrayRef<T> data, EColumn columnType);
 
+    // Alignment of quants data in chunks written by `SaveQuantizedPool`
+    constexpr size_t QUANTIZED_POOL_QUANTS_ALIGNMENT = 16;
+
     struct TLoadQuantizedPoolParameters {
         bool LockMemory = true;
         bool Precharge = true;
@@ -21,6 +21,7 @@
 #include <util/stream/input.h>
 #include <util/stream/length.h>
 #include <util/stream/output.h>
+#include <util/system/align.h>
 #include <util/system/fstat.h>
 
 using NCB::NIdl::TFeatureQuantizationSchema;
@@ -154,6 +155,31 @@ Y_UNIT_TEST_SUITE(SerializationTests) {
         UNIT_ASSERT_VALUES_EQUAL(loadedPoolAsText, poolAsText);
     }
 
+    Y_UNIT_TEST(TestQuantsAreAligned) {
+        const auto pool = MakeQuantizedPool();
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
+
+        {
+            TFileOutput output(path.GetPath());
+            NCB::SaveQuantizedPool(pool, &output);
+        }
+
+        const auto loadedPool = NCB::LoadQuantizedPool(NCB::TPathWithScheme(path.GetPath(), "quantized"), {false, false, NCB::TDatasetSubset::MakeColumns()});
+
+        for (const auto& chunks : loadedPool.Chunks) {
+            for (const auto& chunk : chunks) {
+                const auto* const quants = chunk.Chunk->Quants();
+                UNIT_ASSERT(reinterpret_cast<uintptr_t>(quants->data()) % NCB::QUANTIZED_POOL_QUANTS_ALIGNMENT == 0);
+
+                // padding up to the alignment boundary is zero-filled
+                const auto* const paddingBegin = quants->data() + quants->size();
+                const auto* const paddingEnd
+                    = quants->data() + AlignUp<size_t>(quants->size(), NCB::QUANTIZED_POOL_QUANTS_ALIGNMENT);
+                UNIT_ASSERT(AllOf(paddingBegin, paddingEnd, [] (ui8 value) { return value == 0; }));
+            }
+        }
+    }
+
     Y_UNIT_TEST(TestLoadQuantizationSchema) {
         const auto pool = MakeQuantizedPool();
         const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
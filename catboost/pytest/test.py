@@ -1,4 +1,5 @@
 import yatest.common
+import yatest.common.network
 from yatest.common import ExecutionTimeoutError, ExecutionError
 import pytest
 import os
@@ -6,6 +7,12 @@ import filecmp
 import numpy as np
 import timeit
 import json
+import time
+
+try:
+    from urllib.request import urlopen
+except ImportError:
+    from urllib2 import urlopen
 
 import catboost
 
@@ -2316,6 +2323,93 @@ def test_loss_change_fstr_on_different_pool_type():
     assert(np.allclose(fstr_dsv, train_fstr, rtol=1e-6))
 
 
+@pytest.mark.parametrize('loss_function', ['RMSE', 'PairLogit', 'YetiRank'])
+def test_loss_change_fstr_full_dataset(loss_function):
+    model_path = yatest.common.test_output_path('model.bin')
+    output_fstr_path = yatest.common.test_output_path('fstr.tsv')
+    output_full_dataset_fstr_path = yatest.common.test_output_path('fstr_full_dataset.tsv')
+
+    pairs_params = ('--learn-pairs', data_file('querywise', 'train.pairs')) if loss_function == 'PairLogit' else ()
+    cmd = (
+        CATBOOST_PATH,
+        'fit',
+        '--use-best-model', 'false',
+        '--loss-function', loss_function,
+        '--learn-set', data_file('querywise', 'train'),
+        '--column-description', data_file('querywise', 'train.cd'),
+        '-i', '10',
+        '-T', '4',
+        '--one-hot-max-size', '10',
+        '--model-file', model_path,
+    ) + pairs_params
+    yatest.common.execute(cmd)
+
+    fstr_cmd = (
+        CATBOOST_PATH,
+        'fstr',
+        '--input-path', data_file('querywise', 'train'),
+        '--column-description', data_file('querywise', 'train.cd'),
+        '--model-file', model_path,
+        '--fstr-type', 'LossFunctionChange',
+        '-T', '4',
+    )
+    if loss_function == 'PairLogit':
+        fstr_cmd += ('--input-pairs', data_file('querywise', 'train.pairs'))
+    yatest.common.execute(fstr_cmd + ('--output-path', output_fstr_path))
+    yatest.common.execute(fstr_cmd + ('--output-path', output_full_dataset_fstr_path, '--fstr-full-dataset'))
+
+    # the pool is smaller than the default subset, so both modes process every document
+    fstr = np.loadtxt(output_fstr_path, dtype='float', delimiter='\t')
+    full_dataset_fstr = np.loadtxt(output_full_dataset_fstr_path, dtype='float', delimiter='\t')
+    assert(np.allclose(fstr, full_dataset_fstr, rtol=1e-6))
+
+
+@pytest.mark.parametrize('loss_function', ['Logloss', 'RMSE'])
+def test_loss_change_fstr_full_dataset_several_parts(loss_function):
+    # the pool is split into several parts of several blocks each in the full dataset mode
+    # and is processed as one subset by default, because the subset size limit depends on the feature count
+    pool_path = yatest.common.test_output_path('pool.tsv')
+    cd_path = yatest.common.test_output_path('cd.txt')
+    model_path = yatest.common.test_output_path('model.bin')
+    output_fstr_path = yatest.common.test_output_path('fstr.tsv')
+    output_full_dataset_fstr_path = yatest.common.test_output_path('fstr_full_dataset.tsv')
+
+    prng = np.random.RandomState(seed=0)
+    features = prng.random_sample([450000, 4])
+    label = (features[:, 0] + 0.5 * features[:, 1] + 0.3 * prng.random_sample(450000) > 0.9).astype(float)
+    np.savetxt(pool_path, np.concatenate([label.reshape(-1, 1), features], axis=1), fmt='%.6g', delimiter='\t')
+    np.savetxt(cd_path, [[0, 'Target']], fmt='%s', delimiter='\t')
+
+    cmd = (
+        CATBOOST_PATH,
+        'fit',
+        '--loss-function', loss_function,
+        '--learn-set', pool_path,
+        '--column-description', cd_path,
+        '-i', '10',
+        '--depth', '4',
+        '-T', '4',
+        '--model-file', model_path,
+    )
+    yatest.common.execute(cmd)
+
+    fstr_cmd = (
+        CATBOOST_PATH,
+        'fstr',
+        '--input-path', pool_path,
+        '--column-description', cd_path,
+        '--model-file', model_path,
+        '--fstr-type', 'LossFunctionChange',
+        '-T', '4',
+    )
+    yatest.common.execute(fstr_cmd + ('--output-path', output_fstr_path))
+    yatest.common.execute(fstr_cmd + ('--output-path', output_full_dataset_fstr_path, '--fstr-full-dataset'))
+
+    fstr = np.loadtxt(output_fstr_path, dtype='float', delimiter='\t')
+    full_dataset_fstr = np.loadtxt(output_full_dataset_fstr_path, dtype='float', delimiter='\t')
+    assert(np.allclose(fstr, full_dataset_fstr, rtol=1e-6, atol=1e-9))
+
+
 @pytest.mark.parametrize('loss_function', LOSS_FUNCTIONS)
 @pytest.mark.parametrize(
     'dev_score_calc_obj_block_size',
@@ -3593,7 +3687,7 @@ def test_weight_sampling_per_tree(boosting_type, dev_score_calc_obj_block_size):
 
 
 @pytest.mark.parametrize('boosting_type', BOOSTING_TYPE)
-@pytest.mark.parametrize('used_ram_limit', ['1Kb', '4Gb'])
+@pytest.mark.parametrize('used_ram_limit', ['4Gb'])
 @pytest.mark.parametrize(
     'dev_score_calc_obj_block_size',
     ['600', '5000000'],
@@ -3629,6 +3723,29 @@ def test_allow_writing_files_and_used_ram_limit(boosting_type, used_ram_limit, d
     return [local_canonical_file(output_eval_path)]
 
 
+@pytest.mark.parametrize('boosting_type', BOOSTING_TYPE)
+def test_used_ram_limit_too_small(boosting_type):
+    cmd = (
+        CATBOOST_PATH,
+        'fit',
+        '--allow-writing-files', 'false',
+        '--used-ram-limit', '1Kb',
+        '--loss-function', 'Logloss',
+        '--max-ctr-complexity', '5',
+        '--depth', '7',
+        '-f', data_file('airlines_5K', 'train'),
+        '-t', data_file('airlines_5K', 'test'),
+        '--column-description', data_file('airlines_5K', 'cd'),
+        '--has-header',
+        '--boosting-type', boosting_type,
+        '-i', '20',
+        '-T', '6',
+        '-m', yatest.common.test_output_path('model.bin'),
+    )
+    with pytest.raises(yatest.common.ExecutionError):
+        yatest.common.execute(cmd)
+
+
 @pytest.mark.parametrize(
     'ignored_features',
     [True, False],
@@ -4562,6 +4679,48 @@ def test_dist_train_yetirank():
         output_file_switch='--test-err-log'))]
 
 
+def test_dist_train_one_hot_cat_features():
+    # all categorical features of the pool are one-hot encoded, so no online ctrs are needed
+    run_dist_train(make_deterministic_train_cmd(
+        loss_function='Logloss',
+        pool='adult',
+        train='train_small',
+        test='test_small',
+        cd='train.cd',
+        other_options=('--one-hot-max-size', '255')))
+
+
+@pytest.mark.parametrize('ctr_type', ['Borders', 'Buckets', 'Counter', 'BinarizedTargetMeanValue'])
+def test_dist_train_online_ctrs(ctr_type):
+    # online ctrs of workers continue counters of the preceding workers' parts, so they match single host ones
+    run_dist_train(make_deterministic_train_cmd(
+        loss_function='Logloss',
+        pool='adult',
+        train='train_small',
+        test='test_small',
+        cd='train.cd',
+        other_options=(
+            '--one-hot-max-size', '2',
+            '--simple-ctr', ctr_type,
+            '--combinations-ctr', ctr_type,
+        )))
+
+
+def test_dist_train_online_ctrs_counter_calc_method_full():
+    run_dist_train(make_deterministic_train_cmd(
+        loss_function='Logloss',
+        pool='adult',
+        train='train_small',
+        test='test_small',
+        cd='train.cd',
+        other_options=(
+            '--one-hot-max-size', '2',
+            '--simple-ctr', 'Counter',
+            '--combinations-ctr', 'Counter',
+            '--counter-calc-method', 'Full',
+        )))
+
+
 def test_no_target():
     train_path = yatest.common.test_output_path('train')
     cd_path = yatest.common.test_output_path('train.cd')
@@ -7305,6 +7464,89 @@ def test_eval_feature():
         local_canonical_file(os.path.join('Testing_set_0_fold_2', test_err_log), diff_tool=diff_tool()),
     ]
 
+
+def test_eval_feature_sequential_testing():
+    output_eval_path = yatest.common.test_output_path('feature.eval')
+    fold_count = 8
+    cmd = (
+        CATBOOST_PATH,
+        'eval-feature',
+        '--loss-function', 'RMSE',
+        '-f', data_file('higgs', 'train_small'),
+        '--cd', data_file('higgs', 'train.cd'),
+        '--features-to-evaluate', '0-6;7-13;14-20;21-27',
+        '--feature-eval-mode', 'OneVsNone',
+        '-i', '30',
+        '-T', '4',
+        '-w', '0.7',
+        '--feature-eval-output-file', output_eval_path,
+        '--fold-count', str(fold_count),
+        '--fold-size-unit', 'Object',
+        '--fold-size', '20',
+        '--sequential-testing',
+        '--sequential-test-significance', '0.1',
+        '--train-dir', '.'
+    )
+
+    yatest.common.execute(cmd)
+
+    with open(output_eval_path) as eval_file:
+        header = eval_file.readline().rstrip('\n').split('\t')
+        verdict_idx = header.index('sequential test verdict')
+        fold_count_idx = header.index('evaluated fold count')
+        for line in eval_file:
+            row = line.rstrip('\n').split('\t')
+            evaluated_fold_count = int(row[fold_count_idx])
+            assert 0 < evaluated_fold_count <= fold_count
+            assert row[verdict_idx] in ('Better', 'Worse', 'Undecided')
+            if row[verdict_idx] == 'Undecided':
+                assert evaluated_fold_count == fold_count
+            assert len(row[1].split(',')) == evaluated_fold_count
+
+
+def test_eval_feature_sequential_testing_matches_full_mode():
+    test_err_log = 'test_error.log'
+    # 101 objects in 4 disjoint folds, so 8 folds are evaluated in two fold ranges
+    fold_count = 8
+
+    def run_eval_feature(train_dir, sequential_testing):
+        cmd = [
+            CATBOOST_PATH,
+            'eval-feature',
+            '--loss-function', 'RMSE',
+            '-f', data_file('higgs', 'train_small'),
+            '--cd', data_file('higgs', 'train.cd'),
+            '--features-to-evaluate', '0-6;7-13;14-20;21-27',
+            '--feature-eval-mode', 'OneVsNone',
+            '-i', '30',
+            '-T', '4',
+            '-w', '0.7',
+            '--feature-eval-output-file', os.path.join(train_dir, 'feature.eval'),
+            '--fold-count', str(fold_count),
+            '--fold-size-unit', 'Object',
+            '--fold-size', '30',
+            '--test-err-log', test_err_log,
+            '--train-dir', train_dir
+        ]
+        if sequential_testing:
+            cmd += ['--sequential-testing', '--sequential-test-significance', '0.1']
+        yatest.common.execute(cmd)
+
+    full_train_dir = yatest.common.test_output_path('full')
+    sequential_train_dir = yatest.common.test_output_path('sequential')
+    run_eval_feature(full_train_dir, sequential_testing=False)
+    run_eval_feature(sequential_train_dir, sequential_testing=True)
+
+    compared_fold_count = 0
+    for fold_dir in os.listdir(sequential_train_dir):
+        sequential_log = os.path.join(sequential_train_dir, fold_dir, test_err_log)
+        if not os.path.isfile(sequential_log):
+            continue
+        with open(sequential_log) as sequential_file, open(os.path.join(full_train_dir, fold_dir, test_err_log)) as full_file:
+            assert sequential_file.read() == full_file.read(), 'fold {} differs from the full mode'.format(fold_dir)
+        compared_fold_count += 1
+    assert compared_fold_count > 0
+
 TEST_METRIC_DESCRIPTION_METRICS_LIST = ['Logloss', 'Precision', 'AUC']
 @pytest.mark.parametrize('dataset_has_weights', [True, False], ids=['dataset_has_weights=True', 'dataset_has_weights=False'])
 @pytest.mark.parametrize('eval_metric_loss', TEST_METRIC_DESCRIPTION_METRICS_LIST,
@@ -7432,3 +7674,73 @@ def test_group_features():
     ]
     yatest.common.execute(calc_cmd)
     return [local_canonical_file(learn_error_path), local_canonical_file(test_predictions_path)]
+
+
+def test_serve():
+    model_path = yatest.common.test_output_path('model.bin')
+    fit_cmd = (
+        CATBOOST_PATH,
+        'fit',
+        '--loss-function', 'Logloss',
+        '-f', data_file('adult', 'train_small'),
+        '--cd', data_file('adult', 'train.cd'),
+        '-i', '20',
+        '-T', '4',
+        '-m', model_path,
+    )
+    yatest.common.execute(fit_cmd)
+
+    # serve expects all features in flat order, that is all columns except the target one
+    with open(data_file('adult', 'train.cd')) as cd:
+        target_column = int([line.split('\t')[0] for line in cd if line.split('\t')[1].strip() == 'Target'][0])
+    with open(data_file('adult', 'test_small')) as test:
+        rows = [line.rstrip('\n').split('\t') for line in test if line.strip()]
+    request_data = ''.join(
+        '\t'.join(value for column, value in enumerate(row) if column != target_column) + '\n' for row in rows
+    )
+
+    py_catboost = catboost.CatBoost()
+    py_catboost.load_model(model_path)
+    expected = py_catboost.predict(
+        catboost.Pool(data_file('adult', 'test_small'), column_description=data_file('adult', 'train.cd')),
+        prediction_type='RawFormulaVal'
+    )
+
+    def get_stats(url):
+        stats = {}
+        for line in urlopen(url + 'stats').read().decode('utf-8').splitlines():
+            fields = line.split('\t')
+            if len(fields) == 2 and fields[0] != 'model':
+                stats[fields[0]] = float(fields[1])
+        return stats
+
+    with yatest.common.network.PortManager() as pm:
+        port = pm.get_port()
+        url = 'http://localhost:{}/'.format(port)
+        server = yatest.common.execute(
+            (CATBOOST_PATH, 'serve', '-m', 'adult=' + model_path, '--port', str(port), '-T', '2'),
+            wait=False
+        )
+        try:
+            while pm.is_port_free(port):
+                time.sleep(0.1)
+            assert urlopen(url + 'ping').read().decode('utf-8') == 'ok\n'
+
+            stats_before = get_stats(url)
+            reply = urlopen(url + 'predict/adult', request_data.encode('utf-8')).read().decode('utf-8')
+            predictions = np.array([float(line) for line in reply.splitlines()])
+            assert len(predictions) == len(rows)
+            assert np.allclose(predictions, expected, rtol=1e-6, atol=1e-9)
+
+            # counters are updated after the replies are sent
+            for _ in range(100):
+                stats_after = get_stats(url)
+                if stats_after['requests'] > stats_before['requests']:
+                    break
+                time.sleep(0.1)
+            assert stats_after['requests'] == stats_before['requests'] + 1
+            assert stats_after['objects'] == stats_before['objects'] + len(rows)
+            assert stats_after['batches'] == stats_before['batches'] + 1
+            assert stats_after['errors'] == stats_before['errors']
+        finally:
+            server.kill()
@@ -66,6 +66,13 @@ ctypedef fused numpy_indices_dtype:
     np.uint64_t
 
 
+ctypedef fused categorical_code_dtype:
+    np.int8_t
+    np.int16_t
+    np.int32_t
+    np.int64_t
+
+
 ctypedef fused numpy_num_dtype:
     np.int8_t
     np.int16_t
@@ -971,6 +978,15 @@ cdef extern from "catboost/libs/train_lib/cross_validation.h":
         TVector[TCVResult]* results
     ) nogil except +ProcessException
 
+cdef extern from "catboost/libs/model/evaluation_interface.h" namespace "NCB::NModelEvaluation":
+    cdef cppclass TSparseFloatFeatures:
+        bool_t ColumnMajor
+        size_t ObjectCount
+        size_t FeatureCount
+        TConstArrayRef[size_t] Offsets
+        TConstArrayRef[ui32] Indices
+        TConstArrayRef[float] Values
+
 cdef extern from "catboost/private/libs/algo/apply.h":
     cdef cppclass TModelCalcerOnPool:
         TModelCalcerOnPool(
@@ -1008,6 +1024,15 @@ cdef extern from "catboost/private/libs/algo/apply.h":
         int threadCount
     ) nogil except +ProcessException
 
+    cdef TVector[TVector[double]] ApplyModelMultiSparse(
+        const TFullModel& model,
+        const TSparseFloatFeatures& features,
+        const EPredictionType predictionType,
+        int begin,
+        int end,
+        int threadCount
+    ) nogil except +ProcessException
+
     cdef TVector[ui32] CalcLeafIndexesMulti(
         const TFullModel& model,
         TIntrusivePtr[TObjectsDataProvider] objectsData,
@@ -2014,19 +2039,37 @@ def _set_features_order_data_ndarray(
     cdef Py_ITypedSequencePtr py_num_factor_data
     cdef ITypedSequencePtr[np.float32_t] num_factor_data
 
-    cdef TVector[TString] cat_factor_data
-    cdef ui32 doc_idx
+    cdef TString factor_string
+    cdef TVector[ui32] categories_as_hashed_cat_values
+    cdef TVector[ui32] hashed_cat_values
+    cdef const numpy_num_dtype [::1] unique_values
+    cdef ui32 category_idx
 
     cdef ui32 flat_feature_idx
 
-    cat_factor_data.reserve(doc_count)
-
     for flat_feature_idx in range(feature_count):
         if is_cat_feature_mask[flat_feature_idx]:
-            cat_factor_data.clear()
-            for doc_idx in range(doc_count):
-                cat_factor_data.push_back(ToString(feature_values[doc_idx, flat_feature_idx]))
-            builder_visitor[0].AddCatFeature(flat_feature_idx, <TConstArrayRef[TString]>cat_factor_data)
+            # hash each distinct value once, then map objects to hashes by codes
+            unique_values, codes = _get_unique_values_and_codes(np.asarray(feature_values[:,flat_feature_idx]))
+            categories_as_hashed_cat_values.resize(unique_values.shape[0])
+            for category_idx in range(unique_values.shape[0]):
+                factor_string = ToString(unique_values[category_idx])
+                categories_as_hashed_cat_values[category_idx] = builder_visitor[0].GetCatFeatureValue(
+                    flat_feature_idx,
+                    factor_string
+                )
+
+            hashed_cat_values.resize(doc_count)
+            _get_hashed_cat_values_from_codes(
+                flat_feature_idx,
+                codes,
+                <TConstArrayRef[ui32]>categories_as_hashed_cat_values,
+                <TArrayRef[ui32]>hashed_cat_values
+            )
+            builder_visitor[0].AddCatFeature(
+                flat_feature_idx,
+                TMaybeOwningConstArrayHolder[ui32].CreateOwningMovedFrom(hashed_cat_values)
+            )
         else:
             py_num_factor_data = make_non_owning_type_cast_array_holder(feature_values[:,flat_feature_idx])
             py_num_factor_data.get_result(&num_factor_data)
@@ -2221,8 +2264,138 @@ cdef object _set_features_order_data_pd_data_frame_sparse_column(
     return new_data_holders
 
 
+# returns index of the first object with negative (missing) category code or -1
+cdef i64 _map_codes_to_hashed_cat_values(
+    const categorical_code_dtype [::1] codes,
+    TConstArrayRef[ui32] categories_as_hashed_cat_values,
+    TArrayRef[ui32] hashed_cat_values
+) nogil:
+    cdef i64 doc_idx
+    cdef i64 category_code
+    for doc_idx in range(codes.shape[0]):
+        category_code = codes[doc_idx]
+        if category_code < 0:
+            return doc_idx
+        hashed_cat_values[doc_idx] = categories_as_hashed_cat_values[category_code]
+    return -1
+
+
+cdef _get_hashed_cat_values_from_codes(
+    ui32 flat_feature_idx,
+    np.ndarray codes,
+    TConstArrayRef[ui32] categories_as_hashed_cat_values,
+    TArrayRef[ui32] hashed_cat_values # size must be equal to codes size
+):
+    cdef const np.int8_t [::1] codes_i8
+    cdef const np.int16_t [::1] codes_i16
+    cdef const np.int32_t [::1] codes_i32
+    cdef const np.int64_t [::1] codes_i64
+    cdef i64 missing_value_doc_idx
+
+    codes = np.ascontiguousarray(codes)
+    if codes.dtype == np.int8:
+        codes_i8 = codes
+        with nogil:
+            missing_value_doc_idx = _map_codes_to_hashed_cat_values(
+                codes_i8,
+                categories_as_hashed_cat_values,
+                hashed_cat_values
+            )
+    elif codes.dtype == np.int16:
+        codes_i16 = codes
+        with nogil:
+            missing_value_doc_idx = _map_codes_to_hashed_cat_values(
+                codes_i16,
+                categories_as_hashed_cat_values,
+                hashed_cat_values
+            )
+    elif codes.dtype == np.int32:
+        codes_i32 = codes
+        with nogil:
+            missing_value_doc_idx = _map_codes_to_hashed_cat_values(
+                codes_i32,
+                categories_as_hashed_cat_values,
+                hashed_cat_values
+            )
+    else:
+        codes_i64 = codes.astype(np.int64, copy=False)
+        with nogil:
+            missing_value_doc_idx = _map_codes_to_hashed_cat_values(
+                codes_i64,
+                categories_as_hashed_cat_values,
+                hashed_cat_values
+            )
+
+    if missing_value_doc_idx != -1:
+        raise CatBoostError(
+            'Invalid type for cat_feature[object_idx={},feature_idx={}]=NaN :'
+            ' cat_features must be integer or string, real number values and NaN values'
+            ' should be converted to string.'.format(missing_value_doc_idx, flat_feature_idx)
+        )
+
+
+cdef _get_unique_values_and_codes(np.ndarray column_values):
+    """
+        returns (unique_values, codes) such that column_values == unique_values[codes].
+        Floating point values are compared by bit representation so that values with different string
+        representations (like 0.0 and -0.0) are not merged.
+    """
+    if column_values.dtype.kind == 'f':
+        column_values = np.ascontiguousarray(column_values)
+        bits_dtype = np.dtype('u{}'.format(column_values.dtype.itemsize))
+        unique_bits, codes = np.unique(column_values.view(bits_dtype), return_inverse=True)
+        return unique_bits.view(column_values.dtype), codes
+    return np.unique(column_values, return_inverse=True)
+
+
 # returns new data holders array
-cdef void _set_features_order_data_pd_data_frame_categorical_column(
+cdef object _set_features_order_data_pd_data_frame_integer_cat_column(
+    ui32 flat_feature_idx,
+    np.ndarray column_values, # integer dtype
+    TString* factor_string,
+
+    # array of [dst_value_for_cateory0, dst_value_for_category1 ...]
+    TVector[ui32]* categories_as_hashed_cat_values,
+
+    IRawFeaturesOrderDataVisitor* builder_visitor
+):
+    cdef ui32 doc_count = column_values.shape[0]
+    cdef ui32 category_idx
+    cdef bool_t is_uint64 = column_values.dtype == np.uint64
+    cdef np.ndarray hashed_cat_values = np.empty(doc_count, dtype=np.uint32)
+
+    unique_values, codes = _get_unique_values_and_codes(column_values)
+
+    # string representation is the same as in get_id_object_bytes_string_representation
+    categories_as_hashed_cat_values[0].resize(unique_values.shape[0])
+    for category_idx in range(unique_values.shape[0]):
+        if is_uint64:
+            factor_string[0] = ToString[ui64](<ui64>unique_values[category_idx])
+        else:
+            factor_string[0] = ToString[i64](<i64>unique_values[category_idx])
+        categories_as_hashed_cat_values[0][category_idx] = builder_visitor[0].GetCatFeatureValue(
+            flat_feature_idx,
+            factor_string[0]
+        )
+
+    _get_hashed_cat_values_from_codes(
+        flat_feature_idx,
+        codes,
+        <TConstArrayRef[ui32]>categories_as_hashed_cat_values[0],
+        TArrayRef[ui32](<ui32*>np.PyArray_DATA(hashed_cat_values), doc_count)
+    )
+
+    builder_visitor[0].AddCatFeature(
+        flat_feature_idx,
+        TMaybeOwningConstArrayHolder[ui32].CreateNonOwning(
+            TConstArrayRef[ui32](<const ui32*>np.PyArray_DATA(hashed_cat_values), doc_count)
+        )
+    )
+    return [hashed_cat_values]
+
+
+# returns new data holders array
+cdef object _set_features_order_data_pd_data_frame_categorical_column(
     ui32 flat_feature_idx,
     object column_values, # pd.Categorical, but Cython requires cimport to provide type here
     TString* factor_string,
@@ -2240,11 +2413,9 @@ cdef void _set_features_order_data_pd_data_frame_categorical_column(
 
     # access through TArrayRef is faster
     cdef TArrayRef[ui32] categories_as_hashed_cat_values_ref
-    cdef TVector[ui32] hashed_cat_values
+    cdef np.ndarray hashed_cat_values = np.empty(doc_count, dtype=np.uint32)
 
     cdef ui32 category_idx
-    cdef ui32 doc_idx
-    cdef i32 category_code
 
 
     # TODO(akhropov): make yresize accessible in Cython
@@ -2265,23 +2436,20 @@ cdef void _set_features_order_data_pd_data_frame_categorical_column(
             factor_string[0]
         )
 
-    # TODO(akhropov): make yresize accessible in Cython
-    hashed_cat_values.resize(doc_count)
-    for doc_idx in range(doc_count):
-        category_code = categories_codes[doc_idx]
-        if category_code == -1:
-            raise CatBoostError(
-                'Invalid type for cat_feature[object_idx={},feature_idx={}]=NaN :'
-                ' cat_features must be integer or string, real number values and NaN values'
-                ' should be converted to string.'.format(doc_idx, flat_feature_idx)
-            )
-
-        hashed_cat_values[doc_idx] = categories_as_hashed_cat_values_ref[category_code]
+    _get_hashed_cat_values_from_codes(
+        flat_feature_idx,
+        categories_codes,
+        <TConstArrayRef[ui32]>categories_as_hashed_cat_values[0],
+        TArrayRef[ui32](<ui32*>np.PyArray_DATA(hashed_cat_values), doc_count)
+    )
 
     builder_visitor[0].AddCatFeature(
         flat_feature_idx,
-        TMaybeOwningConstArrayHolder[ui32].CreateOwningMovedFrom(hashed_cat_values)
+        TMaybeOwningConstArrayHolder[ui32].CreateNonOwning(
+            TConstArrayRef[ui32](<const ui32*>np.PyArray_DATA(hashed_cat_values), doc_count)
+        )
     )
+    return [hashed_cat_values]
 
 
 # returns new data holders array
@@ -2330,7 +2498,7 @@ cdef object _set_features_order_data_pd_data_frame(
                     + " cat_features list") % column_name
                 )
 
-            _set_features_order_data_pd_data_frame_categorical_column(
+            new_data_holders += _set_features_order_data_pd_data_frame_categorical_column(
                 flat_feature_idx,
                 column_data.values,
                 &factor_string,
@@ -2339,7 +2507,15 @@ cdef object _set_features_order_data_pd_data_frame(
             )
         else:
             column_values = column_data.values
-            if is_cat_feature_mask[flat_feature_idx]:
+            if is_cat_feature_mask[flat_feature_idx] and (column_values.dtype.kind in 'iu'):
+                new_data_holders += _set_features_order_data_pd_data_frame_integer_cat_column(
+                    flat_feature_idx,
+                    column_values,
+                    &factor_string,
+                    &categories_as_hashed_cat_values,
+                    builder_visitor
+                )
+            elif is_cat_feature_mask[flat_feature_idx]:
                 cat_factor_data.clear()
                 for doc_idx in range(doc_count):
                     get_cat_factor_bytes_representation(
@@ -3788,6 +3964,41 @@ cdef class _CatBoost:
 
         return transform_predictions(pred, predictionType, thread_count, self.__model)
 
+    cpdef _base_predict_sparse(self, data, str prediction_type, int ntree_start, int ntree_end, int thread_count):
+        """
+        Predict on scipy.sparse.csr_matrix or csc_matrix without creating a Pool,
+        model should have no categorical features.
+        """
+        if not data.has_canonical_format:
+            # sums up duplicates and sorts indices within rows or columns
+            data = data.copy()
+            data.sum_duplicates()
+        cdef np.ndarray indptr = np.ascontiguousarray(data.indptr, dtype=np.uintp)
+        cdef np.ndarray indices = np.ascontiguousarray(data.indices, dtype=np.uint32)
+        cdef np.ndarray values = np.ascontiguousarray(data.data, dtype=np.float32)
+        cdef TSparseFloatFeatures features
+        features.ColumnMajor = isinstance(data, scipy.sparse.csc_matrix)
+        features.ObjectCount = data.shape[0]
+        features.FeatureCount = data.shape[1]
+        features.Offsets = TConstArrayRef[size_t](<const size_t*>np.PyArray_DATA(indptr), len(indptr))
+        features.Indices = TConstArrayRef[ui32](<const ui32*>np.PyArray_DATA(indices), len(indices))
+        features.Values = TConstArrayRef[float](<const float*>np.PyArray_DATA(values), len(values))
+
+        cdef TVector[TVector[double]] pred
+        cdef EPredictionType predictionType = string_to_prediction_type(prediction_type)
+        thread_count = UpdateThreadCount(thread_count);
+        with nogil:
+            pred = ApplyModelMultiSparse(
+                dereference(self.__model),
+                features,
+                predictionType,
+                ntree_start,
+                ntree_end,
+                thread_count
+            )
+
+        return transform_predictions(pred, predictionType, thread_count, self.__model)
+
     cpdef _staged_predict_iterator(self, _PoolBase pool, str prediction_type, int ntree_start, int ntree_end, int eval_period, int thread_count, verbose):
         thread_count = UpdateThreadCount(thread_count);
         stagedPredictIterator = _StagedPredictIterator(prediction_type, ntree_start, ntree_end, eval_period, thread_count, verbose)
@@ -1208,6 +1208,9 @@ class _CatBoostBase(object):
     def _base_predict(self, pool, prediction_type, ntree_start, ntree_end, thread_count, verbose):
         return self._object._base_predict(pool, prediction_type, ntree_start, ntree_end, thread_count, verbose)
 
+    def _base_predict_sparse(self, data, prediction_type, ntree_start, ntree_end, thread_count):
+        return self._object._base_predict_sparse(data, prediction_type, ntree_start, ntree_end, thread_count)
+
     def _staged_predict_iterator(self, pool, prediction_type, ntree_start, ntree_end, eval_period, thread_count, verbose):
         return self._object._staged_predict_iterator(pool, prediction_type, ntree_start, ntree_end, eval_period, thread_count, verbose)
 
@@ -1737,6 +1740,17 @@ class CatBoost(_CatBoostBase):
             )
         return data, is_single_object
 
+    def _can_predict_sparse_directly(self, data):
+        """
+        CSR and CSC matrices of numbers are evaluated without a Pool, only non-default values are binarized.
+        """
+        return (
+            isinstance(data, (scipy.sparse.csr_matrix, scipy.sparse.csc_matrix))
+            and np.issubdtype(data.dtype, np.number)
+            and self.is_fitted()
+            and not self._get_cat_feature_indices()
+        )
+
     def _validate_prediction_type(self, prediction_type):
         if not isinstance(prediction_type, STRING_TYPES):
             raise CatBoostError("Invalid prediction_type type={}: must be str().".format(type(prediction_type)))
@@ -1747,6 +1761,9 @@ class CatBoost(_CatBoostBase):
         verbose = verbose or self.get_param('verbose')
         if verbose is None:
             verbose = False
+        if self._can_predict_sparse_directly(data):
+            self._validate_prediction_type(prediction_type)
+            return self._base_predict_sparse(data, prediction_type, ntree_start, ntree_end, thread_count)
         data, data_is_single_object = self._process_predict_input_data(data, parent_method_name)
         self._validate_prediction_type(prediction_type)
 
@@ -3754,7 +3754,7 @@ def test_predict_loss_function_alias(task_type):
 
 
 # check different sizes as well as passing as int as well as str
-@pytest.mark.parametrize('used_ram_limit', ['1024', '2Gb'])
+@pytest.mark.parametrize('used_ram_limit', ['2147483648', '2Gb'])
 def test_allow_writing_files_and_used_ram_limit(used_ram_limit, task_type):
     train_pool = Pool(AIRLINES_5K_TRAIN_FILE, column_description=AIRLINES_5K_CD_FILE, has_header=True)
     test_pool = Pool(AIRLINES_5K_TEST_FILE, column_description=AIRLINES_5K_CD_FILE, has_header=True)
@@ -3777,6 +3777,20 @@ def test_allow_writing_files_and_used_ram_limit(used_ram_limit, task_type):
     return local_canonical_file(preds_path)
 
 
+def test_used_ram_limit_too_small():
+    train_pool = Pool(AIRLINES_5K_TRAIN_FILE, column_description=AIRLINES_5K_CD_FILE, has_header=True)
+    model = CatBoostClassifier(
+        allow_writing_files=False,
+        used_ram_limit=1024,
+        max_ctr_complexity=8,
+        depth=10,
+        iterations=20,
+        thread_count=4,
+    )
+    with pytest.raises(CatBoostError):
+        model.fit(train_pool)
+
+
 def test_permuted_columns_dataset():
     permuted_test, permuted_cd = permute_dataset_columns(AIRLINES_5K_TEST_FILE, AIRLINES_5K_CD_FILE)
     train_pool = Pool(AIRLINES_5K_TRAIN_FILE, column_description=AIRLINES_5K_CD_FILE, has_header=True)
@@ -5457,6 +5471,25 @@ def test_dataframe_with_custom_index():
     model.fit(X, y, cat_features=[0])
 
 
+@pytest.mark.parametrize('cat_dtype', ['int8', 'int64', 'uint64', 'category'])
+def test_dataframe_integer_coded_cat_features(cat_dtype):
+    np.random.seed(0)
+    object_count = 200
+    cat_values = np.random.randint(0, 20, object_count)
+    num_values = np.random.random(object_count)
+    y = (cat_values % 3 == 0).astype(np.float64) + num_values
+
+    str_data = DataFrame({'cat': [str(v) for v in cat_values], 'num': num_values})
+    coded_data = DataFrame({'cat': cat_values.astype(cat_dtype), 'num': num_values})
+
+    predictions = []
+    for data in [str_data, coded_data]:
+        model = CatBoostRegressor(iterations=10, random_seed=0, thread_count=4)
+        model.fit(data, y, cat_features=[0])
+        predictions.append(model.predict(str_data))
+    assert np.allclose(predictions[0], predictions[1])
+
+
 @pytest.mark.parametrize('features_type', [
     'numerical_only',
     'numerical_and_categorical',
@@ -5802,6 +5835,24 @@ def test_fit_on_scipy_sparse_spmatrix(features_dtype, features_density):
     return local_canonical_file(preds_path)
 
 
+@pytest.mark.parametrize('sparse_matrix_type', [scipy.sparse.csr_matrix, scipy.sparse.csc_matrix])
+def test_predict_on_scipy_sparse_matrix_equals_dense(sparse_matrix_type):
+    features, labels = generate_random_labeled_dataset(
+        n_samples=300,
+        n_features=20,
+        labels=[0, 1],
+        features_density=0.1,
+        features_dtype=np.float32,
+        features_range=(-1.0, 1.0),
+    )
+    model = CatBoostClassifier(iterations=20, thread_count=4)
+    model.fit(features, labels)
+    for prediction_type in ['RawFormulaVal', 'Probability', 'Class']:
+        dense_predictions = model.predict(features, prediction_type=prediction_type)
+        sparse_predictions = model.predict(sparse_matrix_type(features), prediction_type=prediction_type)
+        assert np.allclose(dense_predictions, sparse_predictions)
+
+
 # pandas has NaN value indicating missing values by default,
 # NaNs in categorical values are not supported by CatBoost
 def make_catboost_compatible_categorical_missing_values(src_features_dataframe):
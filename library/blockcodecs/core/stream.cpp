@@ -160,11 +160,7 @@ TDecodedInput::TDecodedInput(IInputStream* in, const ICodec* codec)
 
 TDecodedInput::~TDecodedInput() = default;
 
-size_t TDecodedInput::DoUnboundedNext(const void** ptr) {
-    if (!S_) {
-        return 0;
-    }
-
+bool NBlockCodecs::ReadCodedBlock(IInputStream* in, const ICodec** codec, TBuffer* block) {
     TCodecID codecId;
     TBlockLen blockLen;
 
@@ -172,40 +168,58 @@ size_t TDecodedInput::DoUnboundedNext(const void** ptr) {
         const size_t payload = sizeof(TCodecID) + sizeof(TBlockLen);
         char buf[32];
 
-        S_->LoadOrFail(buf, payload);
+        in->LoadOrFail(buf, payload);
 
-        TMemoryInput in(buf, payload);
+        TMemoryInput mi(buf, payload);
 
-        ::Load(&in, codecId);
-        ::Load(&in, blockLen);
+        ::Load(&mi, codecId);
+        ::Load(&mi, blockLen);
     }
 
     if (!blockLen) {
-        S_ = nullptr;
-
-        return 0;
+        return false;
     }
 
     if (Y_UNLIKELY(blockLen > 1024 * 1024 * 1024)) {
         ythrow yexception() << "block size exceeds 1 GiB";
     }
 
-    TBuffer block;
-    block.Resize(blockLen);
+    block->Resize(blockLen);
 
-    S_->LoadOrFail(block.Data(), blockLen);
+    in->LoadOrFail(block->Data(), blockLen);
 
-    auto codec = CodecByID(codecId);
+    *codec = CodecByID(codecId);
 
-    if (C_) {
-        Y_ENSURE(C_->Name() == codec->Name(), AsStringBuf("incorrect stream codec"));
-    }
+    return true;
+}
 
+void NBlockCodecs::DecodeCodedBlock(const ICodec* codec, const TBuffer& block, TBuffer* decoded) {
     if (codec->DecompressedLength(block) > MAX_BUF_LEN) {
         ythrow yexception() << "broken stream";
     }
 
-    codec->Decode(block, D_);
+    codec->Decode(block, *decoded);
+}
+
+size_t TDecodedInput::DoUnboundedNext(const void** ptr) {
+    if (!S_) {
+        return 0;
+    }
+
+    const ICodec* codec = nullptr;
+    TBuffer block;
+
+    if (!ReadCodedBlock(S_, &codec, &block)) {
+        S_ = nullptr;
+
+        return 0;
+    }
+
+    if (C_) {
+        Y_ENSURE(C_->Name() == codec->Name(), AsStringBuf("incorrect stream codec"));
+    }
+
+    DecodeCodedBlock(codec, block, &D_);
     *ptr = D_.Data();
 
     return D_.Size();
@@ -28,6 +28,14 @@ namespace NBlockCodecs {
         IOutputStream* S_;
     };
 
+    /* Reads the next compressed block of a stream written by TCodedOutput without decoding it.
+     * Returns false if the end of stream marker has been read.
+     */
+    bool ReadCodedBlock(IInputStream* in, const ICodec** codec, TBuffer* block);
+
+    // Decodes a block read by ReadCodedBlock
+    void DecodeCodedBlock(const ICodec* codec, const TBuffer& block, TBuffer* decoded);
+
     class TDecodedInput: public IWalkInput {
     public:
         TDecodedInput(IInputStream* in);